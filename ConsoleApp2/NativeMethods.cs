@@ -58,10 +58,19 @@ namespace ConsoleApp2
         public struct RecordParam
         {
             [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 512)]
-            public string fileName;
-            public int recordFormat;    // 0=AVI, 1=MP4
-            public int quality;         // 0-100
-            public int frameRate;
+            public string recordFilePath;  // 保存路径
+
+            [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 512)]
+            public string fileName;        // 文件名
+
+            public int recordFormat;       // 0=TIFF, 1=BMP(暂不支持), 2=SCD, 3=TIFFVideo
+            public int quality;            // 0-100
+            public int frameRate;          // 帧率
+
+            public uint startFrame;        // 起始帧（默认0）
+            public uint count;             // 采集帧数（0=持续录制）
+
+            public ulong startTimeStamp;   // 本库录制格式：从时间戳不小于该值的帧开始（0=不使用，优先于startFrame）
         }
 
         #endregion
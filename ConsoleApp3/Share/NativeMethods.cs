@@ -68,6 +68,8 @@ namespace EyeCam.Shared.Native
 
             public uint startFrame;        // 新增：起始帧（默认0）
             public uint count;             // 新增：采集帧数（0=持续录制）
+
+            public ulong startTimeStamp;   // 本库录制格式：从时间戳不小于该值的帧开始（0=不使用，优先于startFrame）
         }
 
         #endregion
@@ -57,17 +57,177 @@ namespace EyeCam.Shared.Native
         public struct RecordParam
         {
             [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 512)]
-            public string recordFilePath;  // 新增：保存路径
+            public string recordFilePath;  // 新增：保存路径；Raw/RawLZ4可用'|'分隔多个目录（条带录制）
 
             [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 512)]
             public string fileName;        // 文件名
 
-            public int recordFormat;       // 0=TIFF, 1=BMP(暂不支持), 2=SCD, 3=TIFFVideo
+            public int recordFormat;       // 0=TIFF, 1=BMP(暂不支持), 2=SCD, 3=TIFFVideo, 4=Raw, 5=BigTIFF, 6=RawLZ4
             public int quality;            // 0-100
             public int frameRate;          // 帧率
 
             public uint startFrame;        // 新增：起始帧（默认0）
-            public uint count;             // 新增：采集帧数（0=持续录制）
+            public uint count;             // 新增：采集帧数（0=持续录制）；本库录制格式录满后自动关闭文件
+
+            public ulong startTimeStamp;   // 本库录制格式：从时间戳不小于该值的帧开始（0=不使用，优先于startFrame）
+        }
+
+        /// <summary>
+        /// 本库原始流录制的积压处理参数 - 必须和 C++ 的 RecordSpillParam 结构体布局一致
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct RecordSpillParam
+        {
+            public int policy;              // 0=丢弃新帧, 1=内存层, 2=稀疏丢帧
+            public uint thresholdPercent;   // 积压阈值（未写盘字节占缓冲区总容量的百分比，1-100）
+            public ulong memoryBytes;       // 内存层预算（字节），按64MB向下取整后平分给各条带
+            public uint decimation;         // 稀疏丢帧：每几帧丢弃1帧，不小于2
+            public int notify;              // 非0时积压越过阈值/回落时通过导出状态回调上报（status=4/5）
+        }
+
+        /// <summary>
+        /// 本库原始流录制统计（条带录制为各条带之和）
+        /// 写盘耗时直方图第k个桶统计区间[2^k, 2^(k+1))微秒
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct RecordStats
+        {
+            public ulong framesReceived;            // 已接收的帧数
+            public ulong framesWritten;             // 已写盘的帧数
+            public ulong framesDropped;             // 丢弃的帧数（含稀疏丢弃）
+            public ulong framesDecimated;           // 稀疏丢弃的帧数
+            public ulong framesSpilled;             // 进入内存层的帧数
+            public ulong queuedFrames;              // 已接收未写盘的帧数
+            public ulong queuedBytes;               // 已接收未写盘的字节数
+            public ulong peakQueuedBytes;           // 未写盘字节数的峰值
+            public ulong capacityBytes;             // 缓冲区总容量
+            public ulong bytesReceived;             // 已接收的字节数
+            public ulong bytesWritten;              // 已写盘的字节数
+            public ulong pressureEvents;            // 积压越过阈值的次数
+            public double inputMBps;                // 平均接收速率（MB/s）
+            public double outputMBps;               // 平均写盘速率（MB/s）
+            public double diskMBps;                 // 磁盘写入速率（MB/s）
+            public ulong writeLatencyP50;           // 写盘耗时中位数（微秒）
+            public ulong writeLatencyP95;           // 写盘耗时95百分位（微秒）
+            public ulong writeLatencyP99;           // 写盘耗时99百分位（微秒）
+            public ulong writeLatencyMax;           // 写盘耗时最大值（微秒）
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 24)]
+            public ulong[] writeLatencyHistogram;   // 写盘耗时直方图（微秒）
+            public uint queuePercent;               // 积压百分比
+            public uint diskBusyPercent;            // 写盘耗时占录制时长的百分比
+            public uint stripeCount;                // 条带数（0=没有本库原始流录制）
+            public int pressure;                    // 1=积压超过阈值尚未回落
+        }
+
+        /// <summary>
+        /// 数据流统计
+        /// 直方图第k个桶统计区间[2^k, 2^(k+1))
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct StreamStatistics
+        {
+            public ulong framesDelivered;           // 收到的帧数
+            public ulong framesLost;                // 帧ID不连续累计的丢帧数
+            public ulong lastBlockId;               // 最近一帧的帧ID
+            public ulong queueDroppedFrames;        // 采集队列丢弃的帧数
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 24)]
+            public ulong[] intervalHistogram;       // 帧间隔直方图（相机时间戳刻度）
+            [MarshalAs(UnmanagedType.ByValArray, SizeConst = 24)]
+            public ulong[] callbackHistogram;       // 回调耗时直方图（微秒）
+            public ulong callbackMaxMicroseconds;   // 回调最长耗时（微秒）
+            public uint queuedFrames;               // 采集队列中排队的帧数
+            public uint queueCapacity;              // 采集队列容量
+            public uint leasedFrames;               // 租借中的帧数
+            public uint poolHeldFrames;             // 帧池中被持有的帧数
+            public uint poolCapacity;               // 帧池槽数量
+            public uint reserved;
+        }
+
+        /// <summary>
+        /// 显示转换参数（色阶语义与自动色阶一致）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct DisplayParam
+        {
+            public int levelMode;       // 0=关闭(全范围), 1=仅右色阶, 2=仅左色阶, 3=左右色阶
+            public int leftLevel;       // 左色阶，小于此值的像素映射为0
+            public int rightLevel;      // 右色阶，大于此值的像素映射为255
+            public double gamma;        // 输出 = 输入^gamma，1.0为线性
+        }
+
+        /// <summary>
+        /// 帧统计（像素值单位）
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FrameStats
+        {
+            public ulong blockId;           // 统计对应的帧ID
+            public ulong pixelCount;        // 像素数（0表示尚无统计）
+            public ulong saturatedPixels;   // 达到位深最大值的像素数
+            public double mean;             // 均值
+            public double stdDev;           // 标准差
+            public int minValue;            // 最小值
+            public int maxValue;            // 最大值
+            public int lowClip;             // 低百分位点
+            public int highClip;            // 高百分位点
+        }
+
+        /// <summary>
+        /// 本库录像文件（.rvr）信息
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct RecordingInfo
+        {
+            public int width;               // 第一帧的宽度
+            public int height;              // 第一帧的高度
+            public int stride;              // 第一帧的行跨度（字节）
+            public int pixelFormat;         // 第一帧的像素格式
+            public ulong frameCount;        // 帧数
+            public ulong firstBlockId;      // 第一帧的帧ID
+            public ulong lastBlockId;       // 最后一帧的帧ID
+            public ulong firstTimeStamp;    // 第一帧的时间戳
+            public ulong lastTimeStamp;     // 最后一帧的时间戳
+        }
+
+        /// <summary>
+        /// 批量属性读写的一项 - 必须和 C++ 的 FeatureValue 结构体布局一致
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+        public struct FeatureValue
+        {
+            [MarshalAs(UnmanagedType.LPStr)]
+            public string featureName;      // 属性名称（token为0时使用）
+            public uint token;              // 属性令牌，非0时优先于名称
+            public int type;                // 0=Int, 1=Float, 2=Enum, 3=Bool, 4=String, 5=Command
+            public long intValue;           // Integer/Bool的值；Enum的数值
+            public double floatValue;       // Float的值
+            [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 64)]
+            public string symbol;           // Enum的符号（设置时非空则按符号设置）；String的值
+            public int result;              // 输出：本项的错误码
+        }
+
+        /// <summary>
+        /// 枚举属性的一项 - 必须和 C++ 的 EnumEntry 结构体布局一致
+        /// symbol指向本库持有的字符串（Marshal.PtrToStringAnsi读取），句柄销毁前有效
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct EnumEntry
+        {
+            public ulong value;             // 枚举值
+            public IntPtr symbol;           // 符号名称（const char*）
+        }
+
+        /// <summary>
+        /// 属性字典的一项 - 必须和 C++ 的 FeatureInfo 结构体布局一致
+        /// name和entries指向本库持有的内存，句柄销毁前有效
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FeatureInfo
+        {
+            public IntPtr name;             // 属性名称（const char*）
+            public int type;                // FeatureType
+            public IntPtr entries;          // Enum：EnumEntry数组；其他类型为IntPtr.Zero
+            public uint entryCount;         // entries的项数
         }
 
         #endregion
@@ -173,6 +333,11 @@ namespace EyeCam.Shared.Native
         [DllImport(DllName, CallingConvention = Convention)]
         public static extern int Camera_SetBufferCount(IntPtr handle, uint bufferCount);
 
+        /// <summary>设置帧池模式（取帧时复制到本库帧池并立即归还SDK帧）</summary>
+        /// <param name="enable">1=启用, 0=禁用</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetFramePoolEnabled(IntPtr handle, int enable);
+
         /// <summary>获取一帧图像</summary>
         [DllImport(DllName, CallingConvention = Convention)]
         public static extern int Camera_GetFrame(
@@ -184,6 +349,21 @@ namespace EyeCam.Shared.Native
         [DllImport(DllName, CallingConvention = Convention)]
         public static extern int Camera_ReleaseFrame(IntPtr handle, ref ImageData image);
 
+        /// <summary>租借一帧图像（引用计数），回调返回后继续持有</summary>
+        /// <param name="image">输入: 要租借的图像; 输出: 租借后的图像（pData在归还前有效）</param>
+        /// <param name="lease">输出: 租借句柄</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_LeaseFrame(IntPtr handle, ref ImageData image, out IntPtr lease);
+
+        /// <summary>归还租借的帧</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ReturnFrame(IntPtr handle, IntPtr lease);
+
+        /// <summary>设置可同时租借的帧数</summary>
+        /// <param name="maxCount">范围 [0, 64], 默认4</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetMaxLeasedFrames(IntPtr handle, uint maxCount);
+
         /// <summary>获取处理后的图像</summary>
         [DllImport(DllName, CallingConvention = Convention)]
         public static extern int Camera_GetProcessedFrame(
@@ -191,6 +371,42 @@ namespace EyeCam.Shared.Native
             ref ImageData image,
             uint timeout);
 
+        /// <summary>启动采集队列</summary>
+        /// <param name="queueCapacity">队列容量（帧），范围[1, 1024]</param>
+        /// <param name="overflowPolicy">队列满时的策略：0=丢弃最旧, 1=丢弃最新, 2=阻塞</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_StartAcquisition(IntPtr handle, uint queueCapacity, int overflowPolicy);
+
+        /// <summary>停止采集队列</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_StopAcquisition(IntPtr handle);
+
+        /// <summary>从采集队列取出一帧（在下一次取帧前有效，无需释放）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_PopFrame(
+            IntPtr handle,
+            ref ImageData image,
+            uint timeout);
+
+        /// <summary>获取采集队列丢弃的帧数和当前排队的帧数</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetAcquisitionStatus(
+            IntPtr handle,
+            out ulong droppedFrames,
+            out uint queuedFrames);
+
+        /// <summary>获取数据流统计</summary>
+        /// <param name="streamType">0=原始图像, 1=处理后图像</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetStreamStatistics(
+            IntPtr handle,
+            int streamType,
+            out StreamStatistics statistics);
+
+        /// <summary>清零数据流统计</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ResetStreamStatistics(IntPtr handle);
+
         /// <summary>打开录像</summary>
         [DllImport(DllName, CallingConvention = Convention)]
         public static extern int Camera_OpenRecord(IntPtr handle, ref RecordParam recordParam);
@@ -203,6 +419,46 @@ namespace EyeCam.Shared.Native
         [DllImport(DllName, CallingConvention = Convention)]
         public static extern int Camera_SetExportCacheSize(IntPtr handle, ulong cacheSizeInByte);
 
+        /// <summary>设置本库原始流录制的积压处理策略（下一次打开录像生效）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetRecordSpillPolicy(IntPtr handle, ref RecordSpillParam param);
+
+        /// <summary>设置本库原始流录制的索引检查点间隔（帧数/毫秒，0表示不按该条件；默认0/1000）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetRecordCheckpoint(IntPtr handle, uint frameInterval, uint milliseconds);
+
+        /// <summary>获取本库原始流录制的统计（积压、写盘耗时百分位、速率）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetRecordStats(IntPtr handle, out RecordStats stats);
+
+        /// <summary>设置预触发历史缓冲大小（字节，0表示关闭）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetHistoryBufferSize(IntPtr handle, ulong sizeInBytes);
+
+        /// <summary>把历史缓冲中最近seconds秒的帧保存为.rvr文件（采集不中断）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SaveHistory(
+            IntPtr handle,
+            [MarshalAs(UnmanagedType.LPStr)] string path,
+            double seconds);
+
+        /// <summary>在本库的保存线程中保存历史缓冲中最近seconds秒的帧，进度通过导出状态回调上报</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SaveHistoryAsync(
+            IntPtr handle,
+            [MarshalAs(UnmanagedType.LPStr)] string path,
+            double seconds);
+
+        /// <summary>异步保存单帧快照（0=TIFF, 1=PNG, 2=Raw），编码线程写盘后回调</summary>
+        /// <remarks>委托实例必须保持引用直到回调完成</remarks>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SnapshotAsync(
+            IntPtr handle,
+            [MarshalAs(UnmanagedType.LPStr)] string path,
+            int format,
+            SnapshotCallBackDelegate proc,
+            IntPtr pUser);
+
         #endregion
 
         #region 5.6 属性操作
@@ -327,6 +583,16 @@ namespace EyeCam.Shared.Native
             [Out] IntPtr[] pSymbols,  // char**类型，需要特殊处理
             int symbolSize);
 
+        /// <summary>获取枚举属性的可设值表（不复制）</summary>
+        /// <param name="entries">输出：EnumEntry数组的首地址（本库持有，只读）</param>
+        /// <param name="count">输出：项数</param>
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_GetEnumFeatureTable(
+            IntPtr handle,
+            [MarshalAs(UnmanagedType.LPStr)] string featureName,
+            out IntPtr entries,
+            out uint count);
+
         [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
         public static extern int Camera_GetEnumFeatureSymbol(
             IntPtr handle,
@@ -373,6 +639,90 @@ namespace EyeCam.Shared.Native
             IntPtr handle,
             [MarshalAs(UnmanagedType.LPStr)] string featureName);
 
+        // 属性令牌（解析一次，之后按令牌读写；类型不符时返回SC_INVALID_PARAM）
+        /// <summary>解析属性名，返回缓存了类型和访问模式的令牌（0无效，句柄销毁前有效）</summary>
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_ResolveFeature(
+            IntPtr handle,
+            [MarshalAs(UnmanagedType.LPStr)] string featureName,
+            out uint token);
+
+        /// <summary>获取令牌缓存的类型（0=Int...5=Command）和访问模式（1=可读, 2=可写，按位组合）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetFeatureTokenInfo(IntPtr handle, uint token, out int type, out int access);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetIntFeatureByToken(IntPtr handle, uint token, out long value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetIntFeatureByToken(IntPtr handle, uint token, long value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetFloatFeatureByToken(IntPtr handle, uint token, out double value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetFloatFeatureByToken(IntPtr handle, uint token, double value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetEnumFeatureByToken(IntPtr handle, uint token, out ulong value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetEnumFeatureByToken(IntPtr handle, uint token, ulong value);
+
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_GetEnumSymbolByToken(
+            IntPtr handle,
+            uint token,
+            [MarshalAs(UnmanagedType.LPStr)] StringBuilder symbol,
+            int symbolSize);
+
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_SetEnumSymbolByToken(
+            IntPtr handle,
+            uint token,
+            [MarshalAs(UnmanagedType.LPStr)] string symbol);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetBoolFeatureByToken(IntPtr handle, uint token, out int value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetBoolFeatureByToken(IntPtr handle, uint token, int value);
+
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ExecuteCommandByToken(IntPtr handle, uint token);
+
+        /// <summary>批量设置属性（按依赖顺序应用：读出模式/像素格式、宽高、偏移、其他、帧率、命令），每项的result输出错误码</summary>
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_SetFeaturesBatch(
+            IntPtr handle,
+            [In, Out] FeatureValue[] items,
+            uint count);
+
+        /// <summary>批量读取属性，每项的result输出错误码</summary>
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_GetFeaturesBatch(
+            IntPtr handle,
+            [In, Out] FeatureValue[] items,
+            uint count);
+
+        /// <summary>启用/关闭属性值缓存（默认关闭，须在打开相机后调用）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetFeatureCacheEnabled(IntPtr handle, int enable);
+
+        /// <summary>丢弃属性缓存（featureName为null时丢弃全部）</summary>
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_InvalidateFeatureCache(IntPtr handle, string featureName);
+
+        /// <summary>设置属性字典的缓存目录（在Camera_Open之前调用；null或空串表示不使用）</summary>
+        [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
+        public static extern int Camera_SetNodeMapCacheDirectory(IntPtr handle, string directory);
+
+        /// <summary>获取属性字典（按名称排序；缓存目录中没有可用的字典时从设备建立并保存）</summary>
+        /// <param name="features">输出：FeatureInfo数组的首地址（本库持有，只读）</param>
+        /// <param name="count">输出：属性数</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetFeatureDictionary(IntPtr handle, out IntPtr features, out uint count);
+
         #endregion
 
         #region 5.7 回调委托定义
@@ -393,6 +743,10 @@ namespace EyeCam.Shared.Native
         [UnmanagedFunctionPointer(Convention)]
         public delegate void FrameCallBackDelegate(ref ImageData pImage, IntPtr pUser);
 
+        /// <summary>快照完成回调委托</summary>
+        [UnmanagedFunctionPointer(Convention, CharSet = CharSet.Ansi)]
+        public delegate void SnapshotCallBackDelegate(int result, string path, IntPtr pUser);
+
         /// <summary>设备连接状态事件回调注册</summary>
         [DllImport(DllName, CallingConvention = Convention, CharSet = CharSet.Ansi)]
         public static extern int Camera_SubscribeConnectArg(IntPtr handle, ConnectCallBackDelegate proc, IntPtr pUser);
@@ -487,6 +841,133 @@ namespace EyeCam.Shared.Native
             FrameCallBackDelegate proc,
             IntPtr pUser);
 
+        /// <summary>注册原始图像数据回调函数（异步，零拷贝，可与处理后回调同时使用）</summary>
+        /// <param name="proc">回调函数委托（pData仅在回调期间有效）</param>
+        /// <param name="pUser">用户自定义数据</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_AttachRawGrabbing(
+            IntPtr handle,
+            FrameCallBackDelegate proc,
+            IntPtr pUser);
+
+        /// <summary>取消原始图像的回调注册</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_DetachRawGrabbing(IntPtr handle);
+
+        #endregion
+
+        #region 5.9 本库图像处理
+
+        /// <summary>将Mono8/Mono10/Mono12/Mono14/Mono16图像按色阶窗口和gamma转换为8位显示图像</summary>
+        /// <param name="dst">输出缓冲区，至少dstStride*height字节</param>
+        /// <param name="dstStride">输出行跨度（字节）</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ConvertToDisplay8(
+            IntPtr handle,
+            ref ImageData src,
+            ref DisplayParam param,
+            IntPtr dst,
+            int dstStride);
+
+        /// <summary>设置本库显示转换的旋转/翻转（下一帧生效，无需重新开始采集）</summary>
+        /// <param name="rotation">0=0度, 1=90度, 2=180度, 3=270度（顺时针）</param>
+        /// <param name="flip">-1=不翻转, 0=垂直, 1=水平, 2=垂直+水平</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetDisplayOrientation(IntPtr handle, int rotation, int flip);
+
+        /// <summary>旋转/翻转一帧图像到调用方缓冲区</summary>
+        /// <param name="dstSize">输出缓冲区大小（字节）</param>
+        /// <param name="result">输出：变换后的图像（pData指向dst）</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_TransformFrame(
+            IntPtr handle,
+            ref ImageData src,
+            int rotation,
+            int flip,
+            IntPtr dst,
+            int dstSize,
+            out ImageData result);
+
+        /// <summary>设置用户伪彩表（BGRA，0xAARRGGBB），lut为null时清除</summary>
+        /// <param name="entryCount">表项数，256或4096</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetPseudoColorLut(IntPtr handle, uint[] lut, uint entryCount);
+
+        /// <summary>按色阶窗口和伪彩表着色为BGRA32</summary>
+        /// <param name="colorMap">0=HSV, 1=Jet, 2=红, 3=绿, 4=蓝, 100=用户伪彩表</param>
+        /// <param name="dst">输出缓冲区，至少dstStride*height字节</param>
+        /// <param name="dstStride">输出行跨度（字节），不小于width*4</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ColorizeToBgra32(
+            IntPtr handle,
+            ref ImageData src,
+            ref DisplayParam param,
+            int colorMap,
+            IntPtr dst,
+            int dstStride);
+
+        /// <summary>计算直方图</summary>
+        /// <param name="histogram">输出数组，长度不小于binCount</param>
+        /// <param name="binCount">桶数量，2的幂，范围[16, 65536]</param>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ComputeHistogram(
+            IntPtr handle,
+            ref ImageData src,
+            [Out] uint[] histogram,
+            uint binCount);
+
+        /// <summary>计算帧统计（最小/最大/均值/标准差/百分位点）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_ComputeFrameStats(
+            IntPtr handle,
+            ref ImageData src,
+            double lowPercentile,
+            double highPercentile,
+            out FrameStats stats);
+
+        /// <summary>设置采集线程中每隔几帧自动计算一次帧统计（0=关闭）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_SetFrameStatsInterval(
+            IntPtr handle,
+            uint interval,
+            double lowPercentile,
+            double highPercentile);
+
+        /// <summary>获取采集线程最近一次计算的帧统计</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_GetLatestFrameStats(IntPtr handle, out FrameStats stats);
+
+        #endregion
+
+        #region 5.10 本库录像文件读取
+
+        /// <summary>打开本库录制的.rvr文件（映射到内存）；条带录制时path为以'|'分隔的全部条带文件路径</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_RecordingOpen(
+            [MarshalAs(UnmanagedType.LPStr)] string path,
+            out IntPtr recording);
+
+        /// <summary>关闭录像文件，之前读取的帧随之失效</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_RecordingClose(IntPtr recording);
+
+        /// <summary>获取录像信息</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_RecordingGetInfo(IntPtr recording, out RecordingInfo info);
+
+        /// <summary>读取指定帧（pData指向映射内存，关闭前有效）</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_RecordingReadFrame(IntPtr recording, ulong frameIndex, out ImageData image);
+
+        /// <summary>按帧ID查找帧序号</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_RecordingFindFrame(IntPtr recording, ulong blockId, out ulong frameIndex);
+
+        /// <summary>恢复未正常关闭的录像文件；条带录制时path为以'|'分隔的全部条带文件路径</summary>
+        [DllImport(DllName, CallingConvention = Convention)]
+        public static extern int Camera_RecoverRecording(
+            [MarshalAs(UnmanagedType.LPStr)] string path, out ulong frameCount);
+
         #endregion
 
         #region 辅助方法
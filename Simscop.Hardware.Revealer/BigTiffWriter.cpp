@@ -0,0 +1,343 @@
+#include "BigTiffWriter.h"
+#include "ImageKernels.h"
+#include <SCDefines.h>
+#include <windows.h>
+#include <string.h>
+
+/// <summary>
+/// ÿIFDԤIFD
+/// </summary>
+static const unsigned int kIfdsPerBlock = 512;
+
+/// <summary>
+/// ÿҳIFDǩ
+/// </summary>
+static const unsigned int kIfdEntryCount = 11;
+
+/// <summary>
+/// BigTIFFIFDС(8) + (20 * n) + һIFDƫ(8)
+/// </summary>
+static const size_t kIfdSize = 8 + kIfdEntryCount * 20 + 8;
+
+/// <summary>
+/// IFDÿIFDռõֽ뵽8ֽڣIFD8ֽڶ룩
+/// </summary>
+static const size_t kIfdSlotSize = (kIfdSize + 7) & ~static_cast<size_t>(7);
+
+/// <summary>
+/// BigTIFFļͷС
+/// </summary>
+static const size_t kTiffHeaderSize = 16;
+
+/// <summary>
+/// ¼ƶ֡
+/// </summary>
+static const unsigned int kTiffQueueCapacity = 16;
+
+// TIFFֶ
+static const uint16_t kTiffShort = 3;
+static const uint16_t kTiffLong = 4;
+static const uint16_t kTiffLong8 = 16;
+
+static inline void Put16(unsigned char* p, uint16_t v) { memcpy(p, &v, 2); }
+static inline void Put32(unsigned char* p, uint32_t v) { memcpy(p, &v, 4); }
+static inline void Put64(unsigned char* p, uint64_t v) { memcpy(p, &v, 8); }
+
+/// <summary>
+/// дһIFDֵΪֱӴڣ
+/// </summary>
+static unsigned char* PutEntry(unsigned char* p, uint16_t tag, uint16_t type, uint64_t value)
+{
+    memset(p, 0, 20);
+    Put16(p, tag);
+    Put16(p + 2, type);
+    Put64(p + 4, 1);
+    if (type == kTiffShort) Put16(p + 12, static_cast<uint16_t>(value));
+    else if (type == kTiffLong) Put32(p + 12, static_cast<uint32_t>(value));
+    else Put64(p + 12, value);
+    return p + 20;
+}
+
+// =================================================================
+// BigTiffWriter
+// =================================================================
+
+BigTiffWriter::BigTiffWriter()
+    : m_file(INVALID_HANDLE_VALUE), m_end(0), m_blockOffset(0), m_blockUsed(0), m_frameCount(0)
+{
+}
+
+BigTiffWriter::~BigTiffWriter()
+{
+    Close();
+}
+
+ErrorCode BigTiffWriter::Open(const char* path)
+{
+    if (IsOpen()) return SC_BUSY;
+    if (!path || !path[0]) return SC_INVALID_PARAM;
+
+    m_file = CreateFileA(path, GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) return SC_ERROR;
+
+    // ļͷ"II"Сˣ, 43BigTIFF, ƫֽ8, 0, һIFDƫ
+    unsigned char header[kTiffHeaderSize];
+    header[0] = 'I';
+    header[1] = 'I';
+    Put16(header + 2, 43);
+    Put16(header + 4, 8);
+    Put16(header + 6, 0);
+    Put64(header + 8, kTiffHeaderSize);
+
+    if (!WriteAt(0, header, sizeof(header)))
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+        return SC_ERROR;
+    }
+
+    m_path = path;
+    m_end = kTiffHeaderSize;
+    m_frameCount = 0;
+    m_block.assign(kIfdsPerBlock * kIfdSlotSize, 0);
+    ReserveIfdBlock();
+    return SC_OK;
+}
+
+bool BigTiffWriter::IsOpen() const
+{
+    return m_file != INVALID_HANDLE_VALUE;
+}
+
+ErrorCode BigTiffWriter::Close()
+{
+    if (!IsOpen()) return SC_OK;
+
+    // һ飺һIFDһƫΪ0IFD
+    // ûдκ֡ʱļͷָIFDڣЧTIFFɾļ
+    bool empty = m_frameCount == 0;
+    bool ok = !empty && FlushIfdBlock(0);
+
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+    if (empty) DeleteFileA(m_path.c_str());
+    m_path.clear();
+    std::vector<unsigned char>().swap(m_block);
+    std::vector<unsigned char>().swap(m_staging);
+    if (empty) return SC_INVALID_RESOURCE;
+    return ok ? SC_OK : SC_ERROR;
+}
+
+/// <summary>
+/// ļĩβԤһIFD飬֮֡дڿ֮
+/// </summary>
+void BigTiffWriter::ReserveIfdBlock()
+{
+    m_blockOffset = m_end;
+    m_blockUsed = 0;
+    m_end += m_block.size();
+    memset(m_block.data(), 0, m_block.size());
+}
+
+/// <summary>
+/// дصǰIFD飨ֻдĲ֣һIFDָnextIfd
+/// </summary>
+bool BigTiffWriter::FlushIfdBlock(unsigned long long nextIfd)
+{
+    if (m_blockUsed == 0) return true;
+
+    size_t bytes = m_blockUsed * kIfdSlotSize;
+    Put64(m_block.data() + (m_blockUsed - 1) * kIfdSlotSize + kIfdSize - 8, nextIfd);
+    return WriteAt(m_blockOffset, m_block.data(), bytes);
+}
+
+bool BigTiffWriter::WriteAt(unsigned long long offset, const void* p, size_t size)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD written = 0;
+    return WriteFile(m_file, p, static_cast<DWORD>(size), &written, &overlapped) && written == size;
+}
+
+ErrorCode BigTiffWriter::WriteFrame(const ImageData& image)
+{
+    if (!IsOpen()) return SC_INVALID_RESOURCE;
+
+    int bytesPerPixel = GetPixelBytes(image.pixelFormat);
+    if (bytesPerPixel == 0) return SC_NOT_SUPPORT;
+    if (!image.pData || image.width <= 0 || image.height <= 0) return SC_INVALID_PARAM;
+
+    size_t rowBytes = static_cast<size_t>(image.width) * bytesPerPixel;
+    size_t stride = image.stride > 0 ? static_cast<size_t>(image.stride) : rowBytes;
+    if (stride < rowBytes || stride * (image.height - 1) + rowBytes > static_cast<size_t>(image.dataSize))
+        return SC_INVALID_PARAM;
+
+    // һһλڱ֮֡ǰ֡дɹдһ鲢Ԥһ
+    // κһʧʱ״̬䣬CloseһһIFDIFD
+    bool newBlock = m_blockUsed == kIfdsPerBlock;
+    unsigned long long dataOffset = newBlock ? m_end + m_block.size() : m_end;
+
+    // ͼݣÿ֡һд룬пʱȴ
+    size_t dataBytes = rowBytes * image.height;
+    const unsigned char* data = image.pData;
+    if (stride != rowBytes)
+    {
+        if (m_staging.size() < dataBytes) m_staging.resize(dataBytes);
+        for (int y = 0; y < image.height; y++)
+        {
+            memcpy(m_staging.data() + y * rowBytes, image.pData + y * stride, rowBytes);
+        }
+        data = m_staging.data();
+    }
+
+    if (!WriteAt(dataOffset, data, dataBytes)) return SC_ERROR;
+
+    if (newBlock)
+    {
+        if (!FlushIfdBlock(m_end)) return SC_ERROR;
+        ReserveIfdBlock();
+    }
+
+    // һ֡ݺһIFD鰴8ֽڶ루Mono8ʱݳΪ
+    m_end = (dataOffset + dataBytes + 7) & ~7ULL;
+
+    // IFDһIFDָλãдؿʱһ
+    unsigned long long ifdOffset = m_blockOffset + m_blockUsed * kIfdSlotSize;
+    unsigned char* p = m_block.data() + m_blockUsed * kIfdSlotSize;
+    Put64(p, kIfdEntryCount);
+    p += 8;
+    p = PutEntry(p, 256, kTiffLong, image.width);              // ImageWidth
+    p = PutEntry(p, 257, kTiffLong, image.height);             // ImageLength
+    p = PutEntry(p, 258, kTiffShort, bytesPerPixel * 8);       // BitsPerSample
+    p = PutEntry(p, 259, kTiffShort, 1);                       // Compression
+    p = PutEntry(p, 262, kTiffShort, 1);                       // PhotometricInterpretationBlackIsZero
+    p = PutEntry(p, 273, kTiffLong8, dataOffset);              // StripOffsets
+    p = PutEntry(p, 277, kTiffShort, 1);                       // SamplesPerPixel
+    p = PutEntry(p, 278, kTiffLong, image.height);             // RowsPerStrip
+    p = PutEntry(p, 279, kTiffLong8, dataBytes);               // StripByteCounts
+    p = PutEntry(p, 284, kTiffShort, 1);                       // PlanarConfigurationChunky
+    p = PutEntry(p, 339, kTiffShort, 1);                       // SampleFormat޷
+    Put64(p, ifdOffset + kIfdSlotSize);
+
+    m_blockUsed++;
+    m_frameCount++;
+    return SC_OK;
+}
+
+// =================================================================
+// TiffRecorder
+// =================================================================
+
+TiffRecorder::TiffRecorder()
+    : m_notify(nullptr), m_notifyUser(nullptr), m_open(false), m_finishing(false), m_failed(false),
+    m_pushing(0), m_framesReceived(0), m_framesDropped(0)
+{
+}
+
+TiffRecorder::~TiffRecorder()
+{
+    Close();
+}
+
+ErrorCode TiffRecorder::Open(const char* path, RecorderNotify notify, void* pUser)
+{
+    if (m_open.load() || m_thread.joinable()) return SC_BUSY;
+
+    int ret = m_writer.Open(path);
+    if (ret != SC_OK) return ret;
+
+    ret = m_queue.Open(kTiffQueueCapacity, OverflowPolicy_DropNewest);
+    if (ret != SC_OK)
+    {
+        m_writer.Close();
+        return ret;
+    }
+
+    m_notify = notify;
+    m_notifyUser = pUser;
+    m_finishing.store(false);
+    m_failed.store(false);
+    m_framesReceived.store(0);
+    m_framesDropped.store(0);
+
+    m_thread = std::thread(&TiffRecorder::WriterProc, this);
+    m_open.store(true);
+
+    Notify(kExportStart, 0);
+    return SC_OK;
+}
+
+ErrorCode TiffRecorder::Close()
+{
+    if (!m_open.exchange(false)) return SC_OK;
+
+    // ȴڽеPush˳֮д߳дʣ֡
+    while (m_pushing.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+    m_finishing.store(true);
+    m_thread.join();
+    m_queue.Close();
+
+    bool ok = m_writer.Close() == SC_OK && !m_failed.load();
+    int frames = static_cast<int>(m_writer.GetFrameCount());
+
+    if (ok) Notify(kExportFinish, frames);
+    Notify(kExportClose, ok ? frames : kExportFailed);
+    return ok ? SC_OK : SC_ERROR;
+}
+
+void TiffRecorder::Notify(int status, int progress)
+{
+    if (m_notify) m_notify(status, progress, m_notifyUser);
+}
+
+bool TiffRecorder::Push(const ImageData& image)
+{
+    m_pushing.fetch_add(1);
+
+    bool accepted = false;
+    if (m_open.load() && !m_failed.load() && GetPixelBytes(image.pixelFormat) != 0)
+    {
+        accepted = m_queue.Push(image, m_open);
+    }
+
+    if (accepted) m_framesReceived.fetch_add(1);
+    else if (m_open.load()) m_framesDropped.fetch_add(1);
+
+    m_pushing.fetch_sub(1);
+    return accepted;
+}
+
+void TiffRecorder::WriterProc()
+{
+    for (;;)
+    {
+        // β׶βٵȴȡպ˳
+        bool finishing = m_finishing.load();
+
+        ImageData image;
+        int ret = m_queue.Pop(&image, finishing ? 0 : 100);
+        if (ret != SC_OK)
+        {
+            if (finishing || ret != SC_TIMEOUT) return;
+            continue;
+        }
+
+        if (m_failed.load()) continue;
+
+        if (m_writer.WriteFrame(image) != SC_OK)
+        {
+            // ֮֡ȫCloseϱʧ
+            m_failed.store(true);
+            continue;
+        }
+
+        unsigned long long frames = m_writer.GetFrameCount();
+        if (frames % kIfdsPerBlock == 0) Notify(kExportProcessing, static_cast<int>(frames));
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Revealer.h"
+#include "FrameQueue.h"
+#include "Recorder.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+// =================================================================
+// BigTIFFʽд
+// =================================================================
+
+/// <summary>
+/// BigTIFFҳļдMono8/Mono10/Mono12/Mono14/Mono16ѹÿҳһ
+/// 
+/// ļ֣
+/// | ļͷ(16) | IFD0 | ֡0..֡K-1 | IFD1 | ֡K..֡2K-1 | ...
+/// - IFD飨K̶СIFDλڸһ֮֡ǰһ֡дɹԤдһд
+/// - ÿֻ֡һдпʱȴдļС޹
+/// - IFDڿ˳һIFDָһ飻رʱдһ鲢IFD
+/// - ƫƾΪ64λܾTIFF4GB
+/// - IFD֡ݾ8ֽڶ
+/// </summary>
+class BigTiffWriter
+{
+public:
+    BigTiffWriter();
+    ~BigTiffWriter();
+
+    BigTiffWriter(const BigTiffWriter&) = delete;
+    BigTiffWriter& operator=(const BigTiffWriter&) = delete;
+
+    /// <summary>ļдļͷ</summary>
+    ErrorCode Open(const char* path);
+
+    /// <summary>дһIFD鲢رļ</summary>
+    /// <returns>SC_OKʾɹSC_INVALID_RESOURCEʾûдκ֡ļɾSC_ERRORʾдʧ</returns>
+    ErrorCode Close();
+
+    bool IsOpen() const;
+
+    /// <summary>׷һҳ</summary>
+    /// <returns>SC_OKʾɹSC_NOT_SUPPORTʾظʽ֧֣SC_ERRORʾдʧ</returns>
+    ErrorCode WriteFrame(const ImageData& image);
+
+    unsigned long long GetFrameCount() const { return m_frameCount; }
+
+private:
+    bool WriteAt(unsigned long long offset, const void* p, size_t size);
+    bool FlushIfdBlock(unsigned long long nextIfd);
+    void ReserveIfdBlock();
+
+    void* m_file;                       // HANDLE
+    std::string m_path;                 // ûдκ֡ʱرպɾ
+    unsigned long long m_end;           // ļĩβƫƣһ֡ݵλã
+    unsigned long long m_blockOffset;   // ǰIFDļƫ
+    unsigned int m_blockUsed;           // ǰIFDIFD
+    std::vector<unsigned char> m_block; // ǰIFD
+    std::vector<unsigned char> m_staging;   // пʱĴ
+    unsigned long long m_frameCount;
+};
+
+/// <summary>
+/// BigTIFF¼
+/// ;ɼ̰߳֡Ƶкأд߳дBigTiffWriter
+/// 
+/// ˵
+/// - ̸ϣʱ֡ɼ̲߳
+/// - ߳ԼRecorderͬPushֻɲɼ̵߳ãOpen/Closeɿ̵߳
+/// </summary>
+class TiffRecorder
+{
+public:
+    TiffRecorder();
+    ~TiffRecorder();
+
+    TiffRecorder(const TiffRecorder&) = delete;
+    TiffRecorder& operator=(const TiffRecorder&) = delete;
+
+    ErrorCode Open(const char* path, RecorderNotify notify, void* pUser);
+
+    /// <summary>дʣ֡رļ</summary>
+    ErrorCode Close();
+
+    bool IsOpen() const { return m_open.load(); }
+
+    /// <returns>true=ӣfalse=</returns>
+    bool Push(const ImageData& image);
+
+    unsigned long long GetFramesReceived() const { return m_framesReceived.load(); }
+    unsigned long long GetFramesDropped() const { return m_framesDropped.load(); }
+
+private:
+    void WriterProc();
+    void Notify(int status, int progress);
+
+    BigTiffWriter m_writer;
+    FrameQueue m_queue;
+    std::thread m_thread;
+    RecorderNotify m_notify;
+    void* m_notifyUser;
+
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_finishing;      // ֹͣдк˳
+    std::atomic<bool> m_failed;
+    std::atomic<int> m_pushing;
+    std::atomic<unsigned long long> m_framesReceived;
+    std::atomic<unsigned long long> m_framesDropped;
+};
@@ -0,0 +1,226 @@
+#include "FeatureCache.h"
+#include <string.h>
+
+/// <summary>
+/// 
+/// ExposureTime/AcquisitionFrameRateı仯SDKͨ»ص棨ԶعҲ޸ģ
+/// DeviceTemperatureΪʵʱֵ
+/// </summary>
+static const char* const kVolatileFeatures[] =
+{
+    "ExposureTime",
+    "AcquisitionFrameRate",
+    "DeviceTemperature",
+};
+
+FeatureCache::FeatureCache()
+    : m_generation(0), m_enabled(false)
+{
+}
+
+void FeatureCache::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_enabled.store(enabled);
+    ClearLocked();
+}
+
+bool FeatureCache::IsVolatile(const char* name)
+{
+    for (size_t i = 0; i < sizeof(kVolatileFeatures) / sizeof(kVolatileFeatures[0]); i++)
+    {
+        if (strcmp(name, kVolatileFeatures[i]) == 0) return true;
+    }
+    return false;
+}
+
+const FeatureCache::Slot* FeatureCache::Find(const char* name, int kind, int type, int field) const
+{
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) return nullptr;
+
+    const Slot& slot = it->second.slots[field];
+    if (slot.kind != kind || slot.type != type) return nullptr;
+    if (field >= FeatureCacheField_Min && slot.generation != m_generation.load()) return nullptr;
+    return &slot;
+}
+
+FeatureCache::Slot* FeatureCache::Prepare(const char* name, int kind, int type, int field, unsigned long long stamp)
+{
+    if (!m_enabled.load() || stamp != m_generation.load() || IsVolatile(name)) return nullptr;
+
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) it = m_entries.emplace(name, Entry()).first;
+
+    Slot& slot = it->second.slots[field];
+    slot.kind = kind;
+    slot.type = type;
+    slot.generation = stamp;
+    return &slot;
+}
+
+bool FeatureCache::GetInt(const char* name, int type, int field, long long* pValue)
+{
+    if (!m_enabled.load()) return false;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    const Slot* slot = Find(name, SlotKind_Int, type, field);
+    if (!slot) return false;
+    *pValue = slot->intValue;
+    return true;
+}
+
+bool FeatureCache::GetFloat(const char* name, int field, double* pValue)
+{
+    if (!m_enabled.load()) return false;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    const Slot* slot = Find(name, SlotKind_Float, FeatureType_Float, field);
+    if (!slot) return false;
+    *pValue = slot->floatValue;
+    return true;
+}
+
+bool FeatureCache::GetText(const char* name, int type, int field, char* pText, int textSize)
+{
+    if (!m_enabled.load()) return false;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    const Slot* slot = Find(name, SlotKind_Text, type, field);
+    if (!slot) return false;
+    strncpy_s(pText, textSize, slot->text.c_str(), _TRUNCATE);
+    return true;
+}
+
+void FeatureCache::PutInt(const char* name, int type, int field, long long value, unsigned long long stamp)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    Slot* slot = Prepare(name, SlotKind_Int, type, field, stamp);
+    if (slot) slot->intValue = value;
+}
+
+void FeatureCache::PutFloat(const char* name, int field, double value, unsigned long long stamp)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    Slot* slot = Prepare(name, SlotKind_Float, FeatureType_Float, field, stamp);
+    if (slot) slot->floatValue = value;
+}
+
+void FeatureCache::PutText(const char* name, int type, int field, const char* text, unsigned long long stamp)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    Slot* slot = Prepare(name, SlotKind_Text, type, field, stamp);
+    if (slot) slot->text = text;
+}
+
+void FeatureCache::InvalidateLocked(const char* name, bool enumTable)
+{
+    auto it = m_entries.find(name);
+    if (it != m_entries.end()) m_entries.erase(it);
+
+    auto table = enumTable ? m_enumTables.find(name) : m_enumTables.end();
+    if (table != m_enumTables.end()) table->second.current = nullptr;
+
+    m_generation.store(m_generation.load() + 1);
+}
+
+void FeatureCache::ClearLocked()
+{
+    m_entries.clear();
+    for (auto& table : m_enumTables) table.second.current = nullptr;
+    m_generation.store(m_generation.load() + 1);
+}
+
+void FeatureCache::Invalidate(const char* name)
+{
+    if (!m_enabled.load()) return;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    InvalidateLocked(name, true);
+}
+
+void FeatureCache::WriteInt(const char* name, int type, long long value)
+{
+    if (!m_enabled.load()) return;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    InvalidateLocked(name, false);
+    Slot* slot = Prepare(name, SlotKind_Int, type, FeatureCacheField_Value, m_generation.load());
+    if (slot) slot->intValue = value;
+}
+
+void FeatureCache::WriteText(const char* name, int type, int field, const char* text)
+{
+    if (!m_enabled.load()) return;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    InvalidateLocked(name, false);
+    Slot* slot = Prepare(name, SlotKind_Text, type, field, m_generation.load());
+    if (slot) slot->text = text;
+}
+
+void FeatureCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    ClearLocked();
+}
+
+bool FeatureCache::GetEnumTable(const char* name, const EnumEntry** ppEntries, unsigned int* pCount)
+{
+    if (!m_enabled.load()) return false;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_enumTables.find(name);
+    if (it == m_enumTables.end() || !it->second.current) return false;
+
+    const std::vector<EnumEntry>* table = it->second.current;
+    *ppEntries = table->data();
+    *pCount = static_cast<unsigned int>(table->size());
+    return true;
+}
+
+static bool SameEnumTable(const std::vector<EnumEntry>& table, const EnumEntry* entries, unsigned int count)
+{
+    if (table.size() != count) return false;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (table[i].value != entries[i].value || strcmp(table[i].symbol, entries[i].symbol) != 0) return false;
+    }
+    return true;
+}
+
+const EnumEntry* FeatureCache::PutEnumTable(const char* name, const EnumEntry* entries, unsigned int count,
+    unsigned long long stamp)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    auto it = m_enumTables.find(name);
+    if (it == m_enumTables.end()) it = m_enumTables.emplace(name, EnumTables()).first;
+    EnumTables& tables = it->second;
+
+    const std::vector<EnumEntry>* table = nullptr;
+    for (size_t i = 0; i < tables.versions.size() && !table; i++)
+    {
+        if (SameEnumTable(*tables.versions[i], entries, count)) table = tables.versions[i];
+    }
+
+    if (!table)
+    {
+        // ձҲһռλdata()Ϊnullptr
+        m_enumStore.emplace_back();
+        std::vector<EnumEntry>& stored = m_enumStore.back();
+        stored.reserve(count > 0 ? count : 1);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            EnumEntry entry;
+            entry.value = entries[i].value;
+            entry.symbol = m_symbols.insert(entries[i].symbol).first->c_str();
+            stored.push_back(entry);
+        }
+        tables.versions.push_back(&stored);
+        table = &stored;
+    }
+
+    if (m_enabled.load() && stamp == m_generation.load()) tables.current = table;
+    return table->data();
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Revealer.h"
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// =================================================================
+// Ի
+// =================================================================
+
+/// <summary>
+/// ֶ
+/// </summary>
+enum FeatureCacheField
+{
+    FeatureCacheField_Value = 0,    // ǰֵInteger/Float/Enumֵ/Bool/String
+    FeatureCacheField_Symbol,       // Enumǰ
+    FeatureCacheField_Min,          // ΧһԱ仯ʧЧ
+    FeatureCacheField_Max,
+    FeatureCacheField_Inc,
+    kFeatureCacheFields
+};
+
+/// <summary>
+/// ֵӰӻ
+/// ;UIÿѯͬһʱֱӴڴ淵أÿξSDK豸
+///
+/// ƣ
+/// - ȡδʱɵ÷SDKȡPutкһֱЧֱ»صԡ
+///   ˸Ի
+/// - Min/Max/IncȡԣWidthȡOffsetXBinningϵ֪
+///   һʧЧʱȫΧһʧЧm_generation
+/// - ÷ڷSDK֮ǰȡStampPutʱѱ䣨ڼʧЧд룬
+///   ʧЧ֮ǰľֵдػ
+/// - SDK֪ͨ仯ԣIsVolatile
+/// - ÿ¼ͣͶȡʱУSDKʹ
+/// - öٱֵͷţ棬ʧЧͷַֻ
+///   ͬıֻһݣ÷ָڶǰЧݲ
+/// </summary>
+class FeatureCache
+{
+public:
+    FeatureCache();
+
+    FeatureCache(const FeatureCache&) = delete;
+    FeatureCache& operator=(const FeatureCache&) = delete;
+
+    /// <summary>/رգлʱ</summary>
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_enabled.load(); }
+
+    /// <summary>ǰSDK֮ǰȡPutʱ룩</summary>
+    unsigned long long Stamp() const { return m_generation.load(); }
+
+    bool GetInt(const char* name, int type, int field, long long* pValue);
+    bool GetFloat(const char* name, int field, double* pValue);
+    /// <summary>ʱstrncpy_s(_TRUNCATE)ƵpText</summary>
+    bool GetText(const char* name, int type, int field, char* pText, int textSize);
+
+    void PutInt(const char* name, int type, int field, long long value, unsigned long long stamp);
+    void PutFloat(const char* name, int field, double value, unsigned long long stamp);
+    void PutText(const char* name, int type, int field, const char* text, unsigned long long stamp);
+
+    /// <summary>ѱ仯ԵĻֵöٱзΧ</summary>
+    void Invalidate(const char* name);
+
+    /// <summary>óɹдֵֵЧֵͣEnum/Bool/String</summary>
+    void WriteInt(const char* name, int type, long long value);
+    void WriteText(const char* name, int type, int field, const char* text);
+
+    /// <summary>ȫ棨/رROIִȣ</summary>
+    void Clear();
+
+    /// <summary>ȡöٱδʧЧʱУ</summary>
+    bool GetEnumTable(const char* name, const EnumEntry** ppEntries, unsigned int* pCount);
+
+    /// <summary>
+    /// ǼǴSDKöٱſָʱ
+    /// ԵǼǹĳűͬʱűΪ±ҴδʱΪԵĻ
+    /// </summary>
+    /// <returns>ǼǺıǰЧ</returns>
+    const EnumEntry* PutEnumTable(const char* name, const EnumEntry* entries, unsigned int count, unsigned long long stamp);
+
+    /// <summary>ǷΪԣSDK֪ͨ仯ʱ仯</summary>
+    static bool IsVolatile(const char* name);
+
+private:
+    enum SlotKind
+    {
+        SlotKind_Empty = 0,
+        SlotKind_Int,
+        SlotKind_Float,
+        SlotKind_Text,
+    };
+
+    struct Slot
+    {
+        int kind;                           // SlotKind
+        int type;                           // FeatureType
+        unsigned long long generation;      // дʱĴΧֶã
+        long long intValue;
+        double floatValue;
+        std::string text;
+
+        Slot() : kind(SlotKind_Empty), type(0), generation(0), intValue(0), floatValue(0) {}
+    };
+
+    struct Entry
+    {
+        Slot slots[kFeatureCacheFields];
+    };
+
+    struct EnumTables
+    {
+        std::vector<const std::vector<EnumEntry>*> versions;   // Ǽǹıݻͬ
+        const std::vector<EnumEntry>* current;                  // ınullptrʾδʧЧ
+
+        EnumTables() : current(nullptr) {}
+    };
+
+    // ÷m_lockδʱnullptr
+    const Slot* Find(const char* name, int kind, int type, int field) const;
+    // ÷m_lockдʱnullptr
+    Slot* Prepare(const char* name, int kind, int type, int field, unsigned long long stamp);
+    // enumTableǷͬʱöٱֵıֵ
+    void InvalidateLocked(const char* name, bool enumTable);
+    void ClearLocked();
+
+    std::mutex m_lock;
+    std::map<std::string, Entry, std::less<>> m_entries;   // const char*ңstring
+    std::map<std::string, EnumTables, std::less<>> m_enumTables;
+    std::list<std::vector<EnumEntry>> m_enumStore;          // öٱlistڵַ䣩
+    std::set<std::string, std::less<>> m_symbols;           // öٷַsetڵַ䣩
+    std::atomic<unsigned long long> m_generation;           // m_lock޸
+    std::atomic<bool> m_enabled;
+};
@@ -0,0 +1,46 @@
+#include "FeatureTable.h"
+#include <string.h>
+
+FeatureTable::FeatureTable()
+    : m_count(0)
+{
+    for (unsigned int i = 0; i < kMaxFeatureTokens; i++)
+    {
+        m_entries[i].name[0] = '\0';
+        m_entries[i].type.store(0);
+        m_entries[i].access.store(0);
+    }
+}
+
+FeatureToken FeatureTable::Insert(const char* name, int type, int access)
+{
+    size_t length = strlen(name);
+    if (length >= kMaxFeatureNameLength) return 0;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    unsigned int count = m_count.load();
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (strcmp(m_entries[i].name, name) == 0)
+        {
+            m_entries[i].type.store(type);
+            m_entries[i].access.store(access);
+            return i + 1;
+        }
+    }
+    if (count == kMaxFeatureTokens) return 0;
+
+    FeatureEntry& entry = m_entries[count];
+    memcpy(entry.name, name, length + 1);
+    entry.type.store(type);
+    entry.access.store(access);
+    m_count.store(count + 1, std::memory_order_release);
+    return count + 1;
+}
+
+const FeatureEntry* FeatureTable::Find(FeatureToken token) const
+{
+    if (token == 0 || token > m_count.load(std::memory_order_acquire)) return nullptr;
+    return &m_entries[token - 1];
+}
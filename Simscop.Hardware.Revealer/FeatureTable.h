@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Revealer.h"
+#include <atomic>
+#include <mutex>
+
+// =================================================================
+// 
+// =================================================================
+
+/// <summary>
+/// ÿɽ
+/// </summary>
+static const unsigned int kMaxFeatureTokens = 256;
+
+/// <summary>
+/// 󳤶ȣβ0
+/// </summary>
+static const unsigned int kMaxFeatureNameLength = 128;
+
+/// <summary>
+/// ѽ
+/// </summary>
+struct FeatureEntry
+{
+    char name[kMaxFeatureNameLength];   // ǼǺ󲻱䣩
+    std::atomic<int> type;              // FeatureType½ʱ£
+    std::atomic<int> access;            // FeatureAccessλ½ʱ£
+};
+
+/// <summary>
+/// ѽԵı
+/// ;Camera_ResolveFeatureƣѭƶдԣ
+///       ÿδƲѯͺͷģʽ
+///
+/// ƣ
+/// - Ϊе + 10Чֻھʱͷ
+/// - Ǽǣ̣߳ƲҲڼrelease֮ǰдã
+///   ʱacquireȡδд
+/// - ͬظͬһƣˢͺͷģʽģʽɼ״̬仯
+/// </summary>
+class FeatureTable
+{
+public:
+    FeatureTable();
+
+    FeatureTable(const FeatureTable&) = delete;
+    FeatureTable& operator=(const FeatureTable&) = delete;
+
+    /// <summary>ǼԣѵǼʱͺͷģʽ</summary>
+    /// <returns>ƣƹʱ0</returns>
+    FeatureToken Insert(const char* name, int type, int access);
+
+    /// <summary>Ʋң</summary>
+    /// <returns>Чʱnullptr</returns>
+    const FeatureEntry* Find(FeatureToken token) const;
+
+private:
+    FeatureEntry m_entries[kMaxFeatureTokens];
+    std::atomic<unsigned int> m_count;
+    std::mutex m_lock;                  // Ǽ֮以
+};
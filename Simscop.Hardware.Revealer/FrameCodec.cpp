@@ -0,0 +1,452 @@
+#include "FrameCodec.h"
+#include "ImageKernels.h"
+#include <atomic>
+#include <vector>
+#include <string.h>
+
+// =================================================================
+// LZ4ʽ
+// =================================================================
+
+static const size_t kMinMatch = 4;
+static const size_t kLastLiterals = 5;      // 5ֽڱ
+static const size_t kMatchFindLimit = 12;   // һƥĩβ12ֽ
+static const size_t kMaxOffset = 65535;
+static const int kHashLog = 14;
+
+static inline uint32_t Read32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint32_t Hash32(uint32_t v)
+{
+    return (v * 2654435761U) >> (32 - kHashLog);
+}
+
+/// <summary>
+/// д볤ȵչֽڣ255 + 
+/// </summary>
+static inline uint8_t* PutLength(uint8_t* op, size_t length)
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+/// <summary>
+/// дһУ + ѡƥ
+/// </summary>
+/// <returns>дλãռ䲻㷵nullptr</returns>
+static uint8_t* PutSequence(uint8_t* op, uint8_t* oend, const uint8_t* literals, size_t literalLength,
+    size_t offset, size_t matchLength)
+{
+    // token + չ +  + ƫ + ƥ䳤չ
+    size_t worst = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+    if (static_cast<size_t>(oend - op) < worst) return nullptr;
+
+    uint8_t* token = op++;
+    uint8_t literalCode = literalLength >= 15 ? 15 : static_cast<uint8_t>(literalLength);
+    if (literalLength >= 15) op = PutLength(op, literalLength - 15);
+    if (literalLength > 0) memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    uint8_t matchCode = 0;
+    if (matchLength > 0)
+    {
+        op[0] = static_cast<uint8_t>(offset & 0xFF);
+        op[1] = static_cast<uint8_t>(offset >> 8);
+        op += 2;
+
+        size_t code = matchLength - kMinMatch;
+        matchCode = code >= 15 ? 15 : static_cast<uint8_t>(code);
+        if (code >= 15) op = PutLength(op, code - 15);
+    }
+
+    *token = static_cast<uint8_t>((literalCode << 4) | matchCode);
+    return op;
+}
+
+size_t Lz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+{
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstCapacity;
+    size_t anchor = 0;
+
+    if (srcSize > kMatchFindLimit)
+    {
+        static thread_local uint32_t t_hashTable[1 << kHashLog];
+        memset(t_hashTable, 0, sizeof(t_hashTable));
+
+        size_t limit = srcSize - kMatchFindLimit;
+        size_t matchLimit = srcSize - kLastLiterals;
+        size_t ip = 1;
+        t_hashTable[Hash32(Read32(src))] = 0;
+
+        while (ip <= limit)
+        {
+            uint32_t sequence = Read32(src + ip);
+            uint32_t h = Hash32(sequence);
+            size_t ref = t_hashTable[h];
+            t_hashTable[h] = static_cast<uint32_t>(ip);
+
+            if (ref >= ip || ip - ref > kMaxOffset || Read32(src + ref) != sequence)
+            {
+                // ʱûƥʱӴ󲽳ѹݿͨ
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            // ǰչƥ
+            while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+            {
+                ip--;
+                ref--;
+            }
+
+            size_t length = kMinMatch;
+            while (ip + length < matchLimit && src[ref + length] == src[ip + length]) length++;
+
+            op = PutSequence(op, oend, src + anchor, ip - anchor, ip - ref, length);
+            if (!op) return 0;
+
+            ip += length;
+            anchor = ip;
+            if (ip <= limit) t_hashTable[Hash32(Read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+        }
+    }
+
+    op = PutSequence(op, oend, src + anchor, srcSize - anchor, 0, 0);
+    return op ? static_cast<size_t>(op - dst) : 0;
+}
+
+bool Lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstSize;
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend) return false;
+                b = *ip++;
+                literalLength += b;
+            } while (b == 255);
+        }
+        if (static_cast<size_t>(iend - ip) < literalLength || static_cast<size_t>(oend - op) < literalLength)
+            return false;
+        if (literalLength > 0) memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // һֻ
+        if (ip == iend) break;
+
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend) return false;
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += kMinMatch;
+        if (static_cast<size_t>(oend - op) < matchLength) return false;
+
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            // صƣظģʽֽ
+            for (size_t i = 0; i < matchLength; i++) *op++ = *match++;
+        }
+    }
+
+    return op == oend;
+}
+
+// =================================================================
+// Ԥֽڷ
+// =================================================================
+
+/// <summary>
+/// ÿĿԭʼֽ
+/// </summary>
+static const size_t kTileTargetBytes = 256 * 1024;
+
+/// <summary>
+/// Сֶελÿ鰴ԭ棨δѹ
+/// </summary>
+static const uint32_t kTileStored = 0x80000000U;
+
+static inline uint16_t ZigZag16(uint16_t d) { return static_cast<uint16_t>((d << 1) ^ static_cast<uint16_t>(static_cast<int16_t>(d) >> 15)); }
+static inline uint16_t UnZigZag16(uint16_t z) { return static_cast<uint16_t>((z >> 1) ^ static_cast<uint16_t>(-(z & 1))); }
+static inline uint8_t ZigZag8(uint8_t d) { return static_cast<uint8_t>((d << 1) ^ static_cast<uint8_t>(static_cast<int8_t>(d) >> 7)); }
+static inline uint8_t UnZigZag8(uint8_t z) { return static_cast<uint8_t>((z >> 1) ^ static_cast<uint8_t>(-(z & 1))); }
+
+/// <summary>
+/// ˮƽ + zigzag16λʱɵֽ͸ֽ
+/// </summary>
+static void FilterRows(const uint8_t* src, int stride, int width, int rows, int pixelBytes, uint8_t* out)
+{
+    size_t pixels = static_cast<size_t>(width) * rows;
+    if (pixelBytes == 2)
+    {
+        uint8_t* lo = out;
+        uint8_t* hi = out + pixels;
+        for (int y = 0; y < rows; y++)
+        {
+            const uint16_t* p = reinterpret_cast<const uint16_t*>(src + static_cast<size_t>(y) * stride);
+            uint16_t prev = 0;
+            for (int x = 0; x < width; x++)
+            {
+                uint16_t z = ZigZag16(static_cast<uint16_t>(p[x] - prev));
+                prev = p[x];
+                *lo++ = static_cast<uint8_t>(z);
+                *hi++ = static_cast<uint8_t>(z >> 8);
+            }
+        }
+    }
+    else
+    {
+        for (int y = 0; y < rows; y++)
+        {
+            const uint8_t* p = src + static_cast<size_t>(y) * stride;
+            uint8_t prev = 0;
+            for (int x = 0; x < width; x++)
+            {
+                *out++ = ZigZag8(static_cast<uint8_t>(p[x] - prev));
+                prev = p[x];
+            }
+        }
+    }
+}
+
+/// <summary>
+/// FilterRows任
+/// </summary>
+static void UnfilterRows(const uint8_t* in, int width, int rows, int pixelBytes, uint8_t* dst)
+{
+    size_t pixels = static_cast<size_t>(width) * rows;
+    if (pixelBytes == 2)
+    {
+        const uint8_t* lo = in;
+        const uint8_t* hi = in + pixels;
+        uint16_t* p = reinterpret_cast<uint16_t*>(dst);
+        for (int y = 0; y < rows; y++)
+        {
+            uint16_t prev = 0;
+            for (int x = 0; x < width; x++)
+            {
+                prev = static_cast<uint16_t>(prev + UnZigZag16(static_cast<uint16_t>(*lo++ | (*hi++ << 8))));
+                *p++ = prev;
+            }
+        }
+    }
+    else
+    {
+        for (int y = 0; y < rows; y++)
+        {
+            uint8_t prev = 0;
+            for (int x = 0; x < width; x++)
+            {
+                prev = static_cast<uint8_t>(prev + UnZigZag8(*in++));
+                *dst++ = prev;
+            }
+        }
+    }
+}
+
+// =================================================================
+// ֡ѹ
+// ʽ| tileRows(4) | tileCount(4) | tileSize[tileCount](4) | 0 | 1 | ... |
+// =================================================================
+
+static int GetTileRows(int width, int pixelBytes)
+{
+    size_t rowBytes = static_cast<size_t>(width) * pixelBytes;
+    size_t rows = kTileTargetBytes / rowBytes;
+    return rows < 1 ? 1 : static_cast<int>(rows);
+}
+
+size_t GetCompressedFrameBound(int width, int height, int pixelBytes)
+{
+    int tileRows = GetTileRows(width, pixelBytes);
+    size_t tileCount = (height + tileRows - 1) / tileRows;
+    size_t tileBytes = static_cast<size_t>(width) * pixelBytes * tileRows;
+    return 8 + tileCount * 4 + tileCount * Lz4CompressBound(tileBytes);
+}
+
+size_t CompressFrame(const uint8_t* src, int stride, int width, int height, int pixelBytes,
+    uint8_t* dst, size_t dstCapacity)
+{
+    if (width <= 0 || height <= 0 || (pixelBytes != 1 && pixelBytes != 2)) return 0;
+    if (dstCapacity < GetCompressedFrameBound(width, height, pixelBytes)) return 0;
+
+    int tileRows = GetTileRows(width, pixelBytes);
+    int tileCount = (height + tileRows - 1) / tileRows;
+    size_t rowBytes = static_cast<size_t>(width) * pixelBytes;
+    size_t tileBound = Lz4CompressBound(rowBytes * tileRows);
+
+    uint32_t* sizes = reinterpret_cast<uint32_t*>(dst + 8);
+    uint8_t* area = dst + 8 + static_cast<size_t>(tileCount) * 4;
+    memcpy(dst, &tileRows, 4);
+    memcpy(dst + 4, &tileCount, 4);
+
+    // ѹ̶֮ٽ
+    ParallelForStripes(tileCount, 1, [&](int, int t0, int t1)
+    {
+        static thread_local std::vector<uint8_t> t_filtered;
+        if (t_filtered.size() < rowBytes * tileRows) t_filtered.resize(rowBytes * tileRows);
+
+        for (int t = t0; t < t1; t++)
+        {
+            int y0 = t * tileRows;
+            int rows = (y0 + tileRows <= height) ? tileRows : height - y0;
+            size_t rawBytes = rowBytes * rows;
+
+            FilterRows(src + static_cast<size_t>(y0) * stride, stride, width, rows, pixelBytes, t_filtered.data());
+
+            uint8_t* out = area + static_cast<size_t>(t) * tileBound;
+            size_t n = Lz4Compress(t_filtered.data(), rawBytes, out, tileBound);
+            if (n == 0 || n >= rawBytes)
+            {
+                memcpy(out, t_filtered.data(), rawBytes);
+                sizes[t] = static_cast<uint32_t>(rawBytes) | kTileStored;
+            }
+            else
+            {
+                sizes[t] = static_cast<uint32_t>(n);
+            }
+        }
+    });
+
+    size_t used = 0;
+    for (int t = 0; t < tileCount; t++)
+    {
+        size_t n = sizes[t] & ~kTileStored;
+        if (used != static_cast<size_t>(t) * tileBound) memmove(area + used, area + static_cast<size_t>(t) * tileBound, n);
+        used += n;
+    }
+
+    return 8 + static_cast<size_t>(tileCount) * 4 + used;
+}
+
+bool DecompressFrame(const uint8_t* src, size_t srcSize, int width, int height, int pixelBytes, uint8_t* dst)
+{
+    if (width <= 0 || height <= 0 || (pixelBytes != 1 && pixelBytes != 2) || srcSize < 8) return false;
+
+    int tileRows;
+    int tileCount;
+    memcpy(&tileRows, src, 4);
+    memcpy(&tileCount, src + 4, 4);
+    // tileRowsļСͼ߶ʱֻһ飬ͼ߶ȴheight + tileRows - 1뻺
+    if (tileRows <= 0) return false;
+    if (tileRows >= height) tileRows = height;
+    if (tileCount != (height + tileRows - 1) / tileRows) return false;
+    if (srcSize < 8 + static_cast<size_t>(tileCount) * 4) return false;
+
+    // ʼλ
+    size_t rowBytes = static_cast<size_t>(width) * pixelBytes;
+    std::vector<size_t> offsets(tileCount + 1);
+    offsets[0] = 8 + static_cast<size_t>(tileCount) * 4;
+    for (int t = 0; t < tileCount; t++)
+    {
+        uint32_t size;
+        memcpy(&size, src + 8 + static_cast<size_t>(t) * 4, 4);
+        size_t tileBytes = size & ~kTileStored;
+        if (tileBytes > srcSize - offsets[t]) return false;
+        offsets[t + 1] = offsets[t] + tileBytes;
+    }
+
+    std::atomic<bool> ok(true);
+    ParallelForStripes(tileCount, 1, [&](int, int t0, int t1)
+    {
+        static thread_local std::vector<uint8_t> t_filtered;
+        if (t_filtered.size() < rowBytes * tileRows) t_filtered.resize(rowBytes * tileRows);
+
+        for (int t = t0; t < t1; t++)
+        {
+            int y0 = t * tileRows;
+            int rows = (y0 + tileRows <= height) ? tileRows : height - y0;
+            size_t rawBytes = rowBytes * rows;
+
+            uint32_t size;
+            memcpy(&size, src + 8 + static_cast<size_t>(t) * 4, 4);
+            const uint8_t* tile = src + offsets[t];
+            size_t tileBytes = offsets[t + 1] - offsets[t];
+
+            if (size & kTileStored)
+            {
+                if (tileBytes != rawBytes)
+                {
+                    ok.store(false);
+                    continue;
+                }
+                memcpy(t_filtered.data(), tile, rawBytes);
+            }
+            else if (!Lz4Decompress(tile, tileBytes, t_filtered.data(), rawBytes))
+            {
+                ok.store(false);
+                continue;
+            }
+
+            UnfilterRows(t_filtered.data(), width, rows, pixelBytes, dst + static_cast<size_t>(y0) * rowBytes);
+        }
+    });
+
+    return ok.load();
+}
+
+// =================================================================
+// У
+// =================================================================
+
+uint32_t UpdateCrc32(uint32_t crc, const uint8_t* p, size_t size)
+{
+    struct Table
+    {
+        uint32_t v[256];
+        Table()
+        {
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                v[n] = c;
+            }
+        }
+    };
+    static const Table table;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) crc = table.v[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
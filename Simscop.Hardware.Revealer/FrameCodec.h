@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =================================================================
+// ֡ѹ
+// ;¼Ƶѹ׶ΣRecordFormat_RawLZ4ͻطʱĽѹ
+// - зֿ飨ÿԼ256KB̳֮߳ϲѹ/ѹ
+// - ÿˮƽԤ⣨zigzag룩16λͼֽٰڷ棨ֽ桢ֽ棩
+//   źӫͼĲֵСֽ漸ȫΪ0LZ4ԸЧѹ
+// - ѹСԭʼСĿ鰴ԭ
+// =================================================================
+
+/// <summary>
+/// ѹֽ֡ڷ
+/// </summary>
+size_t GetCompressedFrameBound(int width, int height, int pixelBytes);
+
+/// <summary>
+/// ѹһ֡
+/// </summary>
+/// <param name="src">Դͼ񣨰strideʣ</param>
+/// <param name="pixelBytes">ÿֽ12</param>
+/// <param name="dst">GetCompressedFrameBoundֽ</param>
+/// <returns>ѹֽ0ʾʧ</returns>
+size_t CompressFrame(const uint8_t* src, int stride, int width, int height, int pixelBytes,
+    uint8_t* dst, size_t dstCapacity);
+
+/// <summary>
+/// ѹһ֡ΪУп = width * pixelBytes
+/// </summary>
+/// <returns>trueʾɹfalseʾ</returns>
+bool DecompressFrame(const uint8_t* src, size_t srcSize, int width, int height, int pixelBytes, uint8_t* dst);
+
+/// <summary>
+/// LZ4ʽѹLZ4ٷʽݣ
+/// </summary>
+/// <returns>ѹֽ0ʾռ䲻</returns>
+size_t Lz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+/// <summary>
+/// LZ4ʽѹԽ飩
+/// </summary>
+/// <returns>trueʾɹѹǡdstSizeֽ</returns>
+bool Lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+/// <summary>
+/// LZ4ѹֽ
+/// </summary>
+inline size_t Lz4CompressBound(size_t srcSize)
+{
+    return srcSize + srcSize / 255 + 16;
+}
+
+/// <summary>
+/// CRC-32PNG/zlibͬĶʽPNG¼ƼУ
+/// </summary>
+/// <param name="crc">֮ǰݵCRC״Ϊ0</param>
+uint32_t UpdateCrc32(uint32_t crc, const uint8_t* p, size_t size);
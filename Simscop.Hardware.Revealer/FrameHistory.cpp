@@ -0,0 +1,202 @@
+#include "FrameHistory.h"
+#include "FrameMemory.h"
+#include "Recorder.h"
+#include <SCDefines.h>
+#include <chrono>
+#include <thread>
+#include <string.h>
+
+/// <summary>
+/// m_cursor"δס"ֵ
+/// </summary>
+static const uint64_t kNoPin = ~0ULL;
+
+/// <summary>
+/// ۶ֽ
+/// </summary>
+static const size_t kSlotAlignment = 64;
+
+static inline size_t AlignSlot(size_t bytes)
+{
+    return (bytes + kSlotAlignment - 1) & ~(kSlotAlignment - 1);
+}
+
+static inline uint64_t NowNanoseconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+FrameHistory::FrameHistory()
+    : m_memory(nullptr), m_memoryBytes(0), m_slotBytes(0), m_frameBytes(0), m_slotCount(0),
+    m_next(0), m_validFrom(0), m_enabled(false), m_pushing(0), m_writing(false), m_cursor(kNoPin), m_dropped(0)
+{
+}
+
+FrameHistory::~FrameHistory()
+{
+    SetBudget(0);
+}
+
+ErrorCode FrameHistory::SetBudget(unsigned long long bytes)
+{
+    std::lock_guard<std::mutex> lock(m_controlLock);
+
+    // ֹͣд벢ȴеPush˳ͷڴ
+    m_enabled.store(false);
+    while (m_pushing.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+    FreeMemory();
+
+    m_next.store(0);
+    m_validFrom = 0;
+    m_dropped.store(0);
+
+    if (bytes == 0) return SC_OK;
+    if (bytes > static_cast<size_t>(-1)) return SC_NO_MEMORY;
+
+    // ڴ̣߳䣬һ֡ʱ֡С
+    m_memoryBytes = static_cast<size_t>(bytes) & ~(kSlotAlignment - 1);
+    m_memory = static_cast<unsigned char*>(AllocateFrameMemory(m_memoryBytes, nullptr));
+    if (!m_memory)
+    {
+        m_memoryBytes = 0;
+        return SC_NO_MEMORY;
+    }
+
+    m_enabled.store(true);
+    return SC_OK;
+}
+
+void FrameHistory::FreeMemory()
+{
+    FreeFrameMemory(m_memory);
+    m_memory = nullptr;
+    m_memoryBytes = 0;
+    m_slotBytes = 0;
+    m_frameBytes = 0;
+    m_slotCount = 0;
+}
+
+FrameHistory::Slot* FrameHistory::SlotAt(uint64_t seq) const
+{
+    return reinterpret_cast<Slot*>(m_memory + static_cast<size_t>(seq % m_slotCount) * m_slotBytes);
+}
+
+/// <summary>
+/// ֡Сѷڴ»ֲۣɼ̣߳δסʱãڴ棩
+/// </summary>
+bool FrameHistory::Layout(size_t frameBytes)
+{
+    // Ԥ㲻һ֡ʱ֡СͬС֡ٳԻ
+    m_frameBytes = frameBytes;
+
+    size_t slotBytes = AlignSlot(sizeof(Slot)) + AlignSlot(frameBytes);
+    m_slotBytes = slotBytes;
+    m_slotCount = m_memoryBytes / slotBytes;
+    return m_slotCount > 0;
+}
+
+void FrameHistory::Push(const ImageData& image)
+{
+    m_pushing.fetch_add(1);
+
+    if (m_enabled.load() && image.pData && image.dataSize > 0)
+    {
+        // дټαꣻSaveαټд־඼˳һµԭӲ
+        m_writing.store(true);
+        uint64_t cursor = m_cursor.load();
+
+        uint64_t seq = m_next.load(std::memory_order_relaxed);
+        size_t frameBytes = static_cast<size_t>(image.dataSize);
+        bool relayout = frameBytes != m_frameBytes;
+
+        bool pinned = cursor != kNoPin &&
+            (relayout || (seq >= m_slotCount && seq - m_slotCount >= cursor));
+
+        if (pinned)
+        {
+            // Ҫǵ֡δ棨Ҫ»֣дʷ
+            m_dropped.fetch_add(1);
+        }
+        else if (relayout ? Layout(frameBytes) : m_slotCount > 0)
+        {
+            if (relayout) m_validFrom = seq;
+
+            Slot* slot = SlotAt(seq);
+            unsigned char* dst = reinterpret_cast<unsigned char*>(slot) + AlignSlot(sizeof(Slot));
+            memcpy(dst, image.pData, frameBytes);
+            slot->image = image;
+            slot->image.pData = dst;
+            slot->arrivalTime = NowNanoseconds();
+
+            m_next.store(seq + 1, std::memory_order_relaxed);
+        }
+
+        m_writing.store(false, std::memory_order_release);
+    }
+
+    m_pushing.fetch_sub(1);
+}
+
+ErrorCode FrameHistory::Save(const char* path, double seconds, unsigned int* pSavedFrames,
+    RecorderNotify notify, void* pUser)
+{
+    if (pSavedFrames) *pSavedFrames = 0;
+
+    std::lock_guard<std::mutex> lock(m_controlLock);
+
+    // ȴļд̶̻סʱ
+    int ret = SC_INVALID_RESOURCE;
+    Recorder recorder;
+    if (m_enabled.load())
+    {
+        ret = path && path[0] ? recorder.Open(path, notify, pUser) : SC_INVALID_PARAM;
+    }
+    if (ret != SC_OK)
+    {
+        if (notify) notify(kExportClose, kExportFailed, pUser);
+        return ret;
+    }
+
+    // סȫۣȴедɣ֮ɼ̲߳ٸǻ»
+    m_cursor.store(0);
+    while (m_writing.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+
+    uint64_t end = m_next.load(std::memory_order_relaxed);
+    uint64_t begin = end > m_slotCount ? end - m_slotCount : 0;
+    if (begin < m_validFrom) begin = m_validFrom;
+
+    // ʱѡseconds
+    if (seconds > 0.0)
+    {
+        uint64_t span = static_cast<uint64_t>(seconds * 1e9);
+        uint64_t now = NowNanoseconds();
+        uint64_t threshold = now > span ? now - span : 0;
+        while (begin < end && SlotAt(begin)->arrivalTime < threshold) begin++;
+    }
+
+    // ֮ǰĲͷŸɼ߳
+    m_cursor.store(begin);
+
+    unsigned int saved = 0;
+    for (uint64_t seq = begin; seq < end; seq++)
+    {
+        // ѹʱPush(wait)ֻдʧܺŻ᷵false
+        if (!recorder.Push(SlotAt(seq)->image, true)) break;
+        saved++;
+
+        // д¼ƻĲͷŸɼ߳
+        m_cursor.store(seq + 1);
+    }
+    m_cursor.store(kNoPin);
+
+    ret = recorder.Close();
+    if (pSavedFrames) *pSavedFrames = saved;
+    return ret;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Revealer.h"
+#include "Recorder.h"
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+
+// =================================================================
+// Ԥʷ
+// =================================================================
+
+/// <summary>
+/// ֡Ļʷ
+/// ;ɼ̳߳֡ƽλ¼SaveN֡д¼ļ
+/// 
+/// ƣ
+/// - SetBudgetڵֽ̰߳Ԥһڴ棻һ֡ʱ֡СΪ̶ۣ
+///   ֮ÿֻ֡һmemcpyɼ߳ϲڴ
+///   ֡С仯ʱͬһڴ»֣֮ǰʷϣ
+/// - ÿɲͷ֡Ϣʱ䣩֡ɣڴ
+/// - ֡д seq % slotCountд֡ɵ֡
+/// - Saveڼm_cursorסδ֡ɼ߳סĲʱдʷ
+///   ɼ̣߳ÿһ֡αǰһ񣬿ճĲԸ
+/// - סд֮Dekkerʽ˳һ֣m_writing / m_cursor֡·ϲ
+/// 
+/// ߳Լ
+/// - Pushֻɲɼ̵߳
+/// - SetBudget/Saveɿ̵߳ãڲл
+/// </summary>
+class FrameHistory
+{
+public:
+    FrameHistory();
+    ~FrameHistory();
+
+    FrameHistory(const FrameHistory&) = delete;
+    FrameHistory& operator=(const FrameHistory&) = delete;
+
+    /// <summary>ڴԤ㲢ڴ棬0ʾرղͷڴ</summary>
+    /// <returns>SC_OKʾɹSC_NO_MEMORYʾʧܣʷرգ</returns>
+    ErrorCode SetBudget(unsigned long long bytes);
+
+    bool IsEnabled() const { return m_enabled.load(); }
+
+    /// <summary>һ֡ʷɼ̣߳</summary>
+    void Push(const ImageData& image);
+
+    /// <summary>
+    /// seconds루ʱ䣩֡д.rvrļɼ
+    /// </summary>
+    /// <param name="seconds">ʱСڵ0ʾȫʷ</param>
+    /// <param name="pSavedFrames">֡Ϊnullptr</param>
+    /// <param name="notify">д״̬֪ͨ¼ͬļδܴʱֻϱkExportClose/kExportFailedΪnullptr</param>
+    ErrorCode Save(const char* path, double seconds, unsigned int* pSavedFrames,
+        RecorderNotify notify = nullptr, void* pUser = nullptr);
+
+    unsigned long long GetDroppedCount() const { return m_dropped.load(); }
+
+private:
+    struct Slot
+    {
+        ImageData image;                // pDataָڵ֡
+        uint64_t arrivalTime;           // ʱ䣨steady_clock룩
+    };
+
+    bool Layout(size_t frameBytes);
+    void FreeMemory();
+    Slot* SlotAt(uint64_t seq) const;
+
+    std::mutex m_controlLock;           // лSetBudget/Save
+
+    unsigned char* m_memory;
+    size_t m_memoryBytes;
+    size_t m_slotBytes;                 // ÿֽͷ + ֡ݣ64ֽڶ룩
+    size_t m_frameBytes;                // ǰֶӦ֡С
+    uint64_t m_slotCount;
+
+    std::atomic<uint64_t> m_next;       // һ֡ţɼ߳д
+    uint64_t m_validFrom;               // ǰµһ֡
+
+    std::atomic<bool> m_enabled;
+    std::atomic<int> m_pushing;
+    std::atomic<bool> m_writing;        // ɼ߳д
+    std::atomic<uint64_t> m_cursor;     // һסţkNoPin=δס
+    std::atomic<unsigned long long> m_dropped;
+};
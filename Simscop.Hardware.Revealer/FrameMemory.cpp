@@ -0,0 +1,77 @@
+#include "FrameMemory.h"
+#include <windows.h>
+#include <mutex>
+
+/// <summary>
+/// Ϊǰ"ڴҳ"ȨޣSeLockMemoryPrivilege
+/// ҳҪȨޣ˻δʱfalse
+/// </summary>
+static bool EnableLockMemoryPrivilege()
+{
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        return false;
+
+    TOKEN_PRIVILEGES tp = {};
+    tp.PrivilegeCount = 1;
+    tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+    bool ok = false;
+    if (LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &tp.Privileges[0].Luid) &&
+        AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr))
+    {
+        // AdjustTokenPrivilegesδȨʱҲTRUELastError
+        ok = (GetLastError() == ERROR_SUCCESS);
+    }
+
+    CloseHandle(token);
+    return ok;
+}
+
+/// <summary>
+/// ȡõĴҳСʱ0
+/// ֻڵһεʱȨ
+/// </summary>
+static size_t GetUsableLargePageSize()
+{
+    static std::once_flag once;
+    static size_t largePageSize = 0;
+
+    std::call_once(once, []()
+    {
+        if (EnableLockMemoryPrivilege())
+        {
+            largePageSize = GetLargePageMinimum();
+        }
+    });
+
+    return largePageSize;
+}
+
+void* AllocateFrameMemory(size_t size, bool* pLargePage)
+{
+    if (pLargePage) *pLargePage = false;
+    if (size == 0) return nullptr;
+
+    // һҳʱԴҳ
+    size_t largePageSize = GetUsableLargePageSize();
+    if (largePageSize > 0 && size >= largePageSize)
+    {
+        size_t rounded = (size + largePageSize - 1) & ~(largePageSize - 1);
+        void* p = VirtualAlloc(nullptr, rounded,
+            MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (p)
+        {
+            if (pLargePage) *pLargePage = true;
+            return p;
+        }
+    }
+
+    // ˻ͨҳҳ룬64ֽڶ룩
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void FreeFrameMemory(void* p)
+{
+    if (p) VirtualFree(p, 0, MEM_RELEASE);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+
+// =================================================================
+// ֡ڴ
+// =================================================================
+
+/// <summary>
+/// ֡ڴֽ
+/// AVX2/AVX-512ʺͻж
+/// </summary>
+static const size_t kFrameMemoryAlignment = 64;
+
+/// <summary>
+/// С϶뵽kFrameMemoryAlignment
+/// </summary>
+inline size_t AlignFrameSize(size_t size)
+{
+    return (size + kFrameMemoryAlignment - 1) & ~(kFrameMemoryAlignment - 1);
+}
+
+/// <summary>
+/// ֡ڴ
+/// </summary>
+/// <param name="size">ֽ</param>
+/// <param name="pLargePage">Ƿʹ˴ҳΪnullptr</param>
+/// <returns>ڴ׵ַʧܷnullptr</returns>
+/// <remarks>
+/// - һҳʱʹôҳҪ"ڴҳ"ȨޣTLBȱʧ
+/// - Ȩ޻ҳʱ˻ͨҳ
+/// - صַҳ루64ֽڶ룩ֱ޻ļI/O
+/// - ڴύ
+/// </remarks>
+void* AllocateFrameMemory(size_t size, bool* pLargePage);
+
+/// <summary>
+/// ͷAllocateFrameMemoryڴ
+/// </summary>
+void FreeFrameMemory(void* p);
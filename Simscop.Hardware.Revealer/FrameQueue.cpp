@@ -0,0 +1,241 @@
+#include "FrameQueue.h"
+#include "FrameMemory.h"
+#include <SCDefines.h>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <string.h>
+
+FrameQueue::FrameQueue()
+    : m_slots(nullptr), m_capacity(0), m_mask(0), m_policy(OverflowPolicy_DropOldest),
+    m_memory(nullptr), m_bufferSize(0), m_consumerBuffer(nullptr),
+    m_head(0), m_tail(0), m_open(false), m_dropped(0), m_waiters(0), m_consumers(0)
+{
+}
+
+FrameQueue::~FrameQueue()
+{
+    Close();
+}
+
+ErrorCode FrameQueue::Open(unsigned int capacity, int policy)
+{
+    if (m_open.load()) return SC_BUSY;
+    if (capacity == 0 || capacity > 1024) return SC_INVALID_PARAM;
+    if (policy < OverflowPolicy_DropOldest || policy > OverflowPolicy_Block) return SC_INVALID_PARAM;
+
+    // ȡ2ݣλõ۵ӳֻ谴λ
+    unsigned int rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+
+    m_slots = new (std::nothrow) FrameQueueSlot[rounded];
+    if (!m_slots) return SC_NO_MEMORY;
+
+    for (unsigned int i = 0; i < rounded; i++)
+    {
+        m_slots[i].sequence.store(i);
+    }
+
+    m_capacity = rounded;
+    m_mask = rounded - 1;
+    m_policy = policy;
+    m_head.store(0);
+    m_tail.store(0);
+    m_dropped.store(0);
+    m_open.store(true);
+    return SC_OK;
+}
+
+void FrameQueue::Close()
+{
+    if (!m_open.exchange(false)) return;
+
+    // ѵȴеߣȴ˳
+    {
+        std::lock_guard<std::mutex> lock(m_waitLock);
+        m_waitCond.notify_all();
+    }
+    while (m_consumers.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    FreeBuffers();
+    delete[] m_slots;
+    m_slots = nullptr;
+    m_capacity = 0;
+}
+
+void FrameQueue::FreeBuffers()
+{
+    FreeFrameMemory(m_memory);
+    m_memory = nullptr;
+    m_bufferSize = 0;
+    m_consumerBuffer = nullptr;
+}
+
+/// <summary>
+/// ֡ڵһ֡ʱã
+/// κ֮֡ǰɣͨŵacquireָ
+/// </summary>
+bool FrameQueue::EnsureBuffers(size_t size)
+{
+    if (m_memory) return size <= m_bufferSize;
+
+    size_t bufferSize = AlignFrameSize(size);
+    m_memory = static_cast<unsigned char*>(
+        AllocateFrameMemory(bufferSize * (m_capacity + 1), nullptr));
+    if (!m_memory) return false;
+
+    m_bufferSize = bufferSize;
+    for (unsigned int i = 0; i < m_capacity; i++)
+    {
+        m_slots[i].buffer = m_memory + i * bufferSize;
+    }
+    m_consumerBuffer = m_memory + m_capacity * bufferSize;
+    return true;
+}
+
+bool FrameQueue::TryEnqueue(const ImageData& image)
+{
+    uint64_t pos = m_head.load(std::memory_order_relaxed);
+    FrameQueueSlot& slot = m_slots[pos & m_mask];
+
+    uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (seq != pos) return false;   // ڶȡòۣ
+
+    memcpy(slot.buffer, image.pData, static_cast<size_t>(image.dataSize));
+    slot.image = image;
+    slot.image.pData = slot.buffer;
+
+    slot.sequence.store(pos + 1, std::memory_order_release);
+    m_head.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+bool FrameQueue::TryDequeue(ImageData* pImage, bool discard)
+{
+    uint64_t pos = m_tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        FrameQueueSlot& slot = m_slots[pos & m_mask];
+        uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(seq - (pos + 1));
+
+        if (diff < 0) return false;     // Ϊ
+
+        if (diff > 0)
+        {
+            // λѱһȡߣ¶ȡ
+            pos = m_tail.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+            if (!discard)
+            {
+                // ӵ֡ߣ֮ǰĻ黹
+                unsigned char* buffer = slot.buffer;
+                slot.buffer = m_consumerBuffer;
+                m_consumerBuffer = buffer;
+
+                *pImage = slot.image;
+                pImage->pData = buffer;
+            }
+
+            slot.sequence.store(pos + m_capacity, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+bool FrameQueue::Push(const ImageData& image, const std::atomic<bool>& running)
+{
+    if (!m_open.load() || !image.pData || image.dataSize <= 0) return false;
+
+    if (!EnsureBuffers(static_cast<size_t>(image.dataSize)))
+    {
+        // ֡ȷʱ󣨲ɼ޸ROI/ظʽҪ
+        m_dropped.fetch_add(1);
+        return false;
+    }
+
+    while (!TryEnqueue(image))
+    {
+        switch (m_policy)
+        {
+        case OverflowPolicy_DropNewest:
+            m_dropped.fetch_add(1);
+            return false;
+
+        case OverflowPolicy_DropOldest:
+            if (TryDequeue(nullptr, true))
+                m_dropped.fetch_add(1);
+            else
+                std::this_thread::yield();
+            break;
+
+        default:    // OverflowPolicy_Block
+            if (!running.load())
+            {
+                m_dropped.fetch_add(1);
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            break;
+        }
+    }
+
+    // ߵȴʱ֪ͨ
+    if (m_waiters.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_waitLock);
+        m_waitCond.notify_one();
+    }
+    return true;
+}
+
+ErrorCode FrameQueue::Pop(ImageData* pImage, unsigned int timeout)
+{
+    m_consumers.fetch_add(1);
+
+    ErrorCode ret = SC_TIMEOUT;
+    if (!m_open.load())
+    {
+        ret = SC_INVALID_RESOURCE;
+    }
+    else if (TryDequeue(pImage, false))
+    {
+        ret = SC_OK;
+    }
+    else if (timeout > 0)
+    {
+        m_waiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(m_waitLock);
+            auto ready = [this]() { return !m_open.load() || GetCount() > 0; };
+
+            if (timeout == 0xFFFFFFFF)
+                m_waitCond.wait(lock, ready);
+            else
+                m_waitCond.wait_for(lock, std::chrono::milliseconds(timeout), ready);
+        }
+        m_waiters.fetch_sub(1);
+
+        if (!m_open.load())
+            ret = SC_INVALID_RESOURCE;
+        else if (TryDequeue(pImage, false))
+            ret = SC_OK;
+    }
+
+    m_consumers.fetch_sub(1);
+    return ret;
+}
+
+unsigned int FrameQueue::GetCount() const
+{
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    uint64_t tail = m_tail.load(std::memory_order_acquire);
+    return (head > tail) ? static_cast<unsigned int>(head - tail) : 0;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Revealer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+
+// =================================================================
+// ֡Уɼ߳  ߣ
+// =================================================================
+
+/// <summary>
+/// ֡в
+/// sequenceVyukovнеŹ
+/// - sequence == pos       ۿУдλpos
+/// - sequence == pos + 1   дλpos֡ɶȡ
+/// </summary>
+struct FrameQueueSlot
+{
+    std::atomic<uint64_t> sequence;
+    ImageData image;
+    unsigned char* buffer;
+
+    FrameQueueSlot() : sequence(0), image(), buffer(nullptr) {}
+};
+
+/// <summary>
+/// н֡
+/// ;ɼ̣߳ߣ֡ƵУͨCamera_PopFrameȡ
+/// 
+/// ƣ
+/// - /ߣӺͳӶ
+/// - ÿӵж֡һ黺߳
+///   ʱָݣӵ֡һγǰЧ
+/// - ֡ʱݳһ֡Ų۱֤߲ͻ
+/// - ڵһ֡ʱ֡СһԷ䣨64ֽڶ룩֮ٷ
+/// 
+/// ߳Լ
+/// - Pushֻһ̵߳
+/// - Popֻһ̵߳
+/// - Open/Closeɿ̵߳ãCloseǰֹ߱ͣ
+/// </summary>
+class FrameQueue
+{
+public:
+    FrameQueue();
+    ~FrameQueue();
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    /// <summary>򿪶</summary>
+    /// <param name="capacity">ȡΪ2</param>
+    /// <param name="policy">ʱĲԣOverflowPolicy</param>
+    ErrorCode Open(unsigned int capacity, int policy);
+
+    /// <summary>رնУѲȴڵȴ˳ͷڴ</summary>
+    void Close();
+
+    bool IsOpen() const { return m_open.load(); }
+
+    /// <summary>
+    /// ӣߣ
+    /// </summary>
+    /// <param name="image">ҪƵ֡</param>
+    /// <param name="running">б־BlockԵȴڼΪfalseʱ</param>
+    /// <returns>true=ӣfalse=</returns>
+    bool Push(const ImageData& image, const std::atomic<bool>& running);
+
+    /// <summary>
+    /// ӣߣ
+    /// </summary>
+    /// <param name="pImage">֡ݣpDataһPopCloseǰЧ</param>
+    /// <param name="timeout">ȴʱ䣨룩0xFFFFFFFFʾ޵ȴ</param>
+    /// <returns>SC_OKʾɹSC_TIMEOUTʾʱSC_INVALID_RESOURCEʾѹر</returns>
+    ErrorCode Pop(ImageData* pImage, unsigned int timeout);
+
+    /// <summary>ۼƶ֡</summary>
+    unsigned long long GetDroppedCount() const { return m_dropped.load(); }
+
+    /// <summary>ǰŶӵ֡</summary>
+    unsigned int GetCount() const;
+
+    /// <summary></summary>
+    unsigned int GetCapacity() const { return m_capacity; }
+
+private:
+    bool EnsureBuffers(size_t size);
+    bool TryEnqueue(const ImageData& image);
+    bool TryDequeue(ImageData* pImage, bool discard);
+    void FreeBuffers();
+
+    FrameQueueSlot* m_slots;
+    unsigned int m_capacity;
+    uint64_t m_mask;
+    int m_policy;
+
+    unsigned char* m_memory;            // ֡capacity + 1飩
+    size_t m_bufferSize;                // ÿ黺С
+    unsigned char* m_consumerBuffer;    // ߵǰеĻ
+
+    alignas(64) std::atomic<uint64_t> m_head;   // λ
+    alignas(64) std::atomic<uint64_t> m_tail;   // λ
+
+    std::atomic<bool> m_open;
+    std::atomic<unsigned long long> m_dropped;
+
+    // ߵȴֻڶΪʱʹã߽еȴʱ֪ͨ
+    std::mutex m_waitLock;
+    std::condition_variable m_waitCond;
+    std::atomic<int> m_waiters;
+    std::atomic<int> m_consumers;
+};
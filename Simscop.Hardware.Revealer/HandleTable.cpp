@@ -0,0 +1,136 @@
+#include "HandleTable.h"
+#include <chrono>
+#include <thread>
+
+/// <summary>
+/// ״̬֣򿪱־ڸ32λ
+/// </summary>
+static const unsigned long long kOpenFlag = 1ULL << 31;
+static const unsigned long long kPinMask = kOpenFlag - 1;
+
+/// <summary>
+/// λ򣺲+18λǣ4λ20λ
+/// ʼС2^3232λ64λͬŴ1ʼΪnullptr
+/// </summary>
+static const unsigned int kIndexBits = 8;
+static const unsigned int kTagBits = 4;
+static const unsigned int kGenerationMask = (1u << (32 - kIndexBits - kTagBits)) - 1;
+
+static inline unsigned int StateGeneration(unsigned long long state)
+{
+    return static_cast<unsigned int>(state >> 32);
+}
+
+HandleTable::HandleTable(unsigned int tag)
+    : m_tag(tag & ((1u << kTagBits) - 1))
+{
+}
+
+bool HandleTable::Decode(void* handle, unsigned int* pIndex, unsigned int* pGeneration) const
+{
+    uintptr_t value = reinterpret_cast<uintptr_t>(handle);
+    uintptr_t index = value & ((1u << kIndexBits) - 1);
+    uintptr_t tag = (value >> kIndexBits) & ((1u << kTagBits) - 1);
+    uintptr_t generation = value >> (kIndexBits + kTagBits);
+    if (index == 0 || index > kHandleTableSlots || tag != m_tag || generation > kGenerationMask) return false;
+
+    *pIndex = static_cast<unsigned int>(index - 1);
+    *pGeneration = static_cast<unsigned int>(generation);
+    return true;
+}
+
+void* HandleTable::Encode(unsigned int index, unsigned int generation) const
+{
+    uintptr_t value = (static_cast<uintptr_t>(generation) << (kIndexBits + kTagBits)) |
+        (static_cast<uintptr_t>(m_tag) << kIndexBits) | (index + 1);
+    return reinterpret_cast<void*>(value);
+}
+
+void* HandleTable::Add(void* object)
+{
+    std::lock_guard<std::mutex> lock(m_addLock);
+
+    for (unsigned int i = 0; i < kHandleTableSlots; i++)
+    {
+        Slot& slot = m_slots[i];
+        unsigned long long state = slot.state.load();
+
+        // رպٷٵUnpinĲ۲
+        if ((state & (kOpenFlag | kPinMask)) != 0 || slot.object.load() != nullptr) continue;
+
+        unsigned int generation = (StateGeneration(state) + 1) & kGenerationMask;
+        slot.object.store(object);
+        slot.state.store((static_cast<unsigned long long>(generation) << 32) | kOpenFlag);
+        return Encode(i, generation);
+    }
+
+    return nullptr;
+}
+
+void* HandleTable::Pin(void* handle)
+{
+    unsigned int index, generation;
+    if (!Decode(handle, &index, &generation)) return nullptr;
+
+    Slot& slot = m_slots[index];
+    unsigned long long state = slot.state.load();
+    do
+    {
+        if (StateGeneration(state) != generation || (state & kOpenFlag) == 0) return nullptr;
+    } while (!slot.state.compare_exchange_weak(state, state + 1));
+
+    return slot.object.load();
+}
+
+void HandleTable::Unpin(void* handle)
+{
+    unsigned int index, generation;
+    if (Decode(handle, &index, &generation)) m_slots[index].state.fetch_sub(1);
+}
+
+void* HandleTable::Close(void* handle)
+{
+    unsigned int index, generation;
+    if (!Decode(handle, &index, &generation)) return nullptr;
+
+    Slot& slot = m_slots[index];
+    unsigned long long state = slot.state.load();
+    do
+    {
+        if (StateGeneration(state) != generation || (state & kOpenFlag) == 0) return nullptr;
+    } while (!slot.state.compare_exchange_weak(state, state & ~kOpenFlag));
+
+    return slot.object.load();
+}
+
+void HandleTable::Reopen(void* handle)
+{
+    unsigned int index, generation;
+    if (Decode(handle, &index, &generation)) m_slots[index].state.fetch_or(kOpenFlag);
+}
+
+void HandleTable::WaitUnpinned(void* handle, int selfPins)
+{
+    unsigned int index, generation;
+    if (!Decode(handle, &index, &generation)) return;
+
+    // ߿ڵȴ֡ʱɴ룩߶ǿת
+    while ((m_slots[index].state.load() & kPinMask) > static_cast<unsigned long long>(selfPins))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void HandleTable::Remove(void* handle)
+{
+    unsigned int index, generation;
+    if (Decode(handle, &index, &generation)) m_slots[index].object.store(nullptr);
+}
+
+void* HandleTable::HandleAt(unsigned int index) const
+{
+    if (index >= kHandleTableSlots) return nullptr;
+
+    unsigned long long state = m_slots[index].state.load();
+    return (state & kOpenFlag) != 0 ? Encode(index, StateGeneration(state)) : nullptr;
+}
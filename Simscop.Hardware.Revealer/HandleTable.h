@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+
+// =================================================================
+// 
+// =================================================================
+
+/// <summary>
+/// Ĳͬʱڵľޣ
+/// </summary>
+static const unsigned int kHandleTableSlots = 128;
+
+/// <summary>
+/// ڲӳ
+/// ;ⲿľȡö󣬲δָ֪룬ҲҼ
+///
+/// ƣ
+/// - ɲšǺʹɣǶָ룻ʱɾ֮ʧЧ
+/// - ÿһԭ״̬֣򿪱־
+/// - Pin״̬һCASҴʱһڼ󲻻ᱻ
+/// - ٷClose֮PinʧܣWaitUnpinnedȴȻٶRemove
+/// - ҶƳĲ۲ŻᱻAddãٵUnpin䵽¶
+///
+/// ߳Լ
+/// - Pin/Unpin/HandleAt̵߳ã
+/// - AddڲлͬһClose/Reopen/WaitUnpinned/RemoveɳɹCloseһ
+/// </summary>
+class HandleTable
+{
+public:
+    /// <param name="tag">ǣ0~15ͬľͬ</param>
+    explicit HandleTable(unsigned int tag);
+
+    HandleTable(const HandleTable&) = delete;
+    HandleTable& operator=(const HandleTable&) = delete;
+
+    /// <summary>ǼǶ</summary>
+    /// <returns>¾ʱnullptr</returns>
+    void* Add(void* object);
+
+    /// <summary>ɹUnpin</summary>
+    /// <returns>ӦĶЧѹرջƳľnullptr</returns>
+    void* Pin(void* handle);
+
+    /// <summary>Pinɹ</summary>
+    void Unpin(void* handle);
+
+    /// <summary>رվ֮Pinʧ</summary>
+    /// <returns>ɱεùرʱؾӦĶ󣻾Чѱرʱnullptr</returns>
+    void* Close(void* handle);
+
+    /// <summary>´CloseرյľʧܡЧʱ</summary>
+    void Reopen(void* handle);
+
+    /// <summary>ȴselfPins÷е</summary>
+    void WaitUnpinned(void* handle, int selfPins);
+
+    /// <summary>Ƴѹرյľɵ÷٣ʣۿ</summary>
+    void Remove(void* handle);
+
+    /// <summary>index۵ǰ򿪵ľãδʱnullptr</summary>
+    void* HandleAt(unsigned int index) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<void*> object;                  // ǼǵĶnullptrʾƳ
+        std::atomic<unsigned long long> state;      // 32λ| 򿪱־ | 
+
+        Slot() : object(nullptr), state(0) {}
+    };
+
+    bool Decode(void* handle, unsigned int* pIndex, unsigned int* pGeneration) const;
+    void* Encode(unsigned int index, unsigned int generation) const;
+
+    Slot m_slots[kHandleTableSlots];
+    unsigned int m_tag;
+    std::mutex m_addLock;
+};
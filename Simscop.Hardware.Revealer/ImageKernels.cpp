@@ -0,0 +1,1153 @@
+#include "ImageKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <math.h>
+#include <string.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define KERNEL_TARGET_SSE41
+#define KERNEL_TARGET_AVX2
+#else
+#define KERNEL_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// =================================================================
+// CPU
+// =================================================================
+
+static SimdLevel DetectSimdLevel()
+{
+#if defined(_MSC_VER)
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool sse41 = __builtin_cpu_supports("sse4.1") != 0;
+    bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+    if (avx2) return SimdLevel_AVX2;
+    if (sse41) return SimdLevel_SSE41;
+    return SimdLevel_Scalar;
+}
+
+SimdLevel GetSimdLevel()
+{
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+// =================================================================
+// ظʽ
+// =================================================================
+
+// GigE VisionظʽSC_EPixelType
+static const int kPixelMono8 = 0x01080001;
+static const int kPixelMono10 = 0x01100003;
+static const int kPixelMono12 = 0x01100005;
+static const int kPixelMono14 = 0x01100025;
+static const int kPixelMono16 = 0x01100007;
+
+int GetPixelBitDepth(int pixelFormat)
+{
+    switch (pixelFormat)
+    {
+    case kPixelMono8: return 8;
+    case kPixelMono10: return 10;
+    case kPixelMono12: return 12;
+    case kPixelMono14: return 14;
+    case kPixelMono16: return 16;
+    default: return 0;
+    }
+}
+
+int GetPixelBytes(int pixelFormat)
+{
+    int depth = GetPixelBitDepth(pixelFormat);
+    if (depth == 0) return 0;
+    return depth > 8 ? 2 : 1;
+}
+
+// =================================================================
+// ɫ״ӳ
+// =================================================================
+
+/// <summary>
+/// ӳ㣩
+/// out = min(((clamp(v - left, 0, range) * scale) + 0x8000) >> 16, outMax)
+/// range * scale  outMax << 16outMax  4095ʱ˻32λ
+/// </summary>
+struct WindowParams
+{
+    uint16_t left;
+    uint16_t range;
+    uint32_t scale;
+    uint16_t outMax;
+};
+
+static WindowParams MakeWindowParams(unsigned int left, unsigned int right, unsigned int outMax)
+{
+    if (left > 65535) left = 65535;
+    if (right > 65535) right = 65535;
+
+    WindowParams p;
+    p.left = static_cast<uint16_t>(left);
+    p.range = static_cast<uint16_t>(right > left ? right - left : 1);
+    p.scale = static_cast<uint32_t>(((static_cast<uint64_t>(outMax) << 16) + p.range / 2) / p.range);
+    p.outMax = static_cast<uint16_t>(outMax);
+    return p;
+}
+
+static inline uint32_t WindowPixel(uint32_t v, const WindowParams& p)
+{
+    uint32_t d = v > p.left ? v - p.left : 0;
+    if (d > p.range) d = p.range;
+    uint32_t r = (d * p.scale + 0x8000) >> 16;
+    return r > p.outMax ? p.outMax : r;
+}
+
+// -----  -----
+
+static void WindowRow16To8_Scalar(const uint16_t* src, uint8_t* dst, int width, const WindowParams& p)
+{
+    for (int x = 0; x < width; x++)
+    {
+        dst[x] = static_cast<uint8_t>(WindowPixel(src[x], p));
+    }
+}
+
+static void WindowRow16To16_Scalar(const uint16_t* src, uint16_t* dst, int width, const WindowParams& p)
+{
+    for (int x = 0; x < width; x++)
+    {
+        dst[x] = static_cast<uint16_t>(WindowPixel(src[x], p));
+    }
+}
+
+// ----- SSE4.1 -----
+
+KERNEL_TARGET_SSE41
+static inline __m128i Window8_SSE41(__m128i v, __m128i left, __m128i range, __m128i scale,
+    __m128i round, __m128i outMax)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i d = _mm_min_epu16(_mm_subs_epu16(v, left), range);
+
+    __m128i lo = _mm_mullo_epi32(_mm_unpacklo_epi16(d, zero), scale);
+    __m128i hi = _mm_mullo_epi32(_mm_unpackhi_epi16(d, zero), scale);
+    lo = _mm_srli_epi32(_mm_add_epi32(lo, round), 16);
+    hi = _mm_srli_epi32(_mm_add_epi32(hi, round), 16);
+
+    return _mm_min_epu16(_mm_packus_epi32(lo, hi), outMax);
+}
+
+KERNEL_TARGET_SSE41
+static void WindowRow16To8_SSE41(const uint16_t* src, uint8_t* dst, int width, const WindowParams& p)
+{
+    __m128i left = _mm_set1_epi16(static_cast<short>(p.left));
+    __m128i range = _mm_set1_epi16(static_cast<short>(p.range));
+    __m128i scale = _mm_set1_epi32(static_cast<int>(p.scale));
+    __m128i round = _mm_set1_epi32(0x8000);
+    __m128i outMax = _mm_set1_epi16(static_cast<short>(p.outMax));
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i a = Window8_SSE41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x)),
+            left, range, scale, round, outMax);
+        __m128i b = Window8_SSE41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x + 8)),
+            left, range, scale, round, outMax);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(a, b));
+    }
+    WindowRow16To8_Scalar(src + x, dst + x, width - x, p);
+}
+
+KERNEL_TARGET_SSE41
+static void WindowRow16To16_SSE41(const uint16_t* src, uint16_t* dst, int width, const WindowParams& p)
+{
+    __m128i left = _mm_set1_epi16(static_cast<short>(p.left));
+    __m128i range = _mm_set1_epi16(static_cast<short>(p.range));
+    __m128i scale = _mm_set1_epi32(static_cast<int>(p.scale));
+    __m128i round = _mm_set1_epi32(0x8000);
+    __m128i outMax = _mm_set1_epi16(static_cast<short>(p.outMax));
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i a = Window8_SSE41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x)),
+            left, range, scale, round, outMax);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), a);
+    }
+    WindowRow16To16_Scalar(src + x, dst + x, width - x, p);
+}
+
+// ----- AVX2 -----
+
+KERNEL_TARGET_AVX2
+static inline __m256i Window16_AVX2(__m256i v, __m256i left, __m256i range, __m256i scale,
+    __m256i round, __m256i outMax)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i d = _mm256_min_epu16(_mm256_subs_epu16(v, left), range);
+
+    // unpack/pack128λͨڽУ˳ǰһ
+    __m256i lo = _mm256_mullo_epi32(_mm256_unpacklo_epi16(d, zero), scale);
+    __m256i hi = _mm256_mullo_epi32(_mm256_unpackhi_epi16(d, zero), scale);
+    lo = _mm256_srli_epi32(_mm256_add_epi32(lo, round), 16);
+    hi = _mm256_srli_epi32(_mm256_add_epi32(hi, round), 16);
+
+    return _mm256_min_epu16(_mm256_packus_epi32(lo, hi), outMax);
+}
+
+KERNEL_TARGET_AVX2
+static void WindowRow16To8_AVX2(const uint16_t* src, uint8_t* dst, int width, const WindowParams& p)
+{
+    __m256i left = _mm256_set1_epi16(static_cast<short>(p.left));
+    __m256i range = _mm256_set1_epi16(static_cast<short>(p.range));
+    __m256i scale = _mm256_set1_epi32(static_cast<int>(p.scale));
+    __m256i round = _mm256_set1_epi32(0x8000);
+    __m256i outMax = _mm256_set1_epi16(static_cast<short>(p.outMax));
+
+    int x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        __m256i a = Window16_AVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x)),
+            left, range, scale, round, outMax);
+        __m256i b = Window16_AVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x + 16)),
+            left, range, scale, round, outMax);
+
+        // packus_epi16ͨpermuteָ˳
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), packed);
+    }
+    WindowRow16To8_Scalar(src + x, dst + x, width - x, p);
+}
+
+KERNEL_TARGET_AVX2
+static void WindowRow16To16_AVX2(const uint16_t* src, uint16_t* dst, int width, const WindowParams& p)
+{
+    __m256i left = _mm256_set1_epi16(static_cast<short>(p.left));
+    __m256i range = _mm256_set1_epi16(static_cast<short>(p.range));
+    __m256i scale = _mm256_set1_epi32(static_cast<int>(p.scale));
+    __m256i round = _mm256_set1_epi32(0x8000);
+    __m256i outMax = _mm256_set1_epi16(static_cast<short>(p.outMax));
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i a = Window16_AVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x)),
+            left, range, scale, round, outMax);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), a);
+    }
+    WindowRow16To16_Scalar(src + x, dst + x, width - x, p);
+}
+
+// -----  -----
+
+typedef void (*WindowRow16To8Func)(const uint16_t*, uint8_t*, int, const WindowParams&);
+typedef void (*WindowRow16To16Func)(const uint16_t*, uint16_t*, int, const WindowParams&);
+
+static WindowRow16To8Func SelectWindowRow16To8()
+{
+    switch (GetSimdLevel())
+    {
+    case SimdLevel_AVX2: return WindowRow16To8_AVX2;
+    case SimdLevel_SSE41: return WindowRow16To8_SSE41;
+    default: return WindowRow16To8_Scalar;
+    }
+}
+
+static WindowRow16To16Func SelectWindowRow16To16()
+{
+    switch (GetSimdLevel())
+    {
+    case SimdLevel_AVX2: return WindowRow16To16_AVX2;
+    case SimdLevel_SSE41: return WindowRow16To16_SSE41;
+    default: return WindowRow16To16_Scalar;
+    }
+}
+
+// =================================================================
+// Gamma
+// =================================================================
+
+/// <summary>
+/// 12λgammaλ
+/// ӳ䵽12λٲ8λֶϲ
+/// </summary>
+static const unsigned int kGammaIndexBits = 12;
+static const unsigned int kGammaIndexMax = (1u << kGammaIndexBits) - 1;
+
+/// <summary>
+/// ÿ̻߳ʹõgammagammaʱؽ
+/// </summary>
+struct GammaTable
+{
+    double gamma;
+    uint8_t lut[kGammaIndexMax + 1];
+};
+
+static thread_local GammaTable t_gammaTable = { 0.0, { 0 } };
+
+static const uint8_t* GetGammaTable(double gamma)
+{
+    if (t_gammaTable.gamma != gamma)
+    {
+        for (unsigned int i = 0; i <= kGammaIndexMax; i++)
+        {
+            double v = pow(static_cast<double>(i) / kGammaIndexMax, gamma) * 255.0 + 0.5;
+            t_gammaTable.lut[i] = static_cast<uint8_t>(v > 255.0 ? 255.0 : v);
+        }
+        t_gammaTable.gamma = gamma;
+    }
+    return t_gammaTable.lut;
+}
+
+static bool IsLinearGamma(double gamma)
+{
+    return fabs(gamma - 1.0) < 1e-6;
+}
+
+// =================================================================
+// ʾת
+// =================================================================
+
+void ConvertMono16ToDisplay8(const uint16_t* src, size_t srcStride, int width, int height,
+    unsigned int left, unsigned int right, double gamma, uint8_t* dst, size_t dstStride)
+{
+    const uint8_t* srcRow = reinterpret_cast<const uint8_t*>(src);
+
+    if (IsLinearGamma(gamma))
+    {
+        WindowParams p = MakeWindowParams(left, right, 255);
+        WindowRow16To8Func row = SelectWindowRow16To8();
+
+        for (int y = 0; y < height; y++)
+        {
+            row(reinterpret_cast<const uint16_t*>(srcRow + y * srcStride), dst + y * dstStride, width, p);
+        }
+        return;
+    }
+
+    // gammaֿӳ䵽12λջϻ壬פL1ٲ
+    WindowParams p = MakeWindowParams(left, right, kGammaIndexMax);
+    WindowRow16To16Func row = SelectWindowRow16To16();
+    const uint8_t* lut = GetGammaTable(gamma);
+
+    const int kChunk = 1024;
+    uint16_t index[kChunk];
+
+    for (int y = 0; y < height; y++)
+    {
+        const uint16_t* s = reinterpret_cast<const uint16_t*>(srcRow + y * srcStride);
+        uint8_t* d = dst + y * dstStride;
+
+        for (int x = 0; x < width; x += kChunk)
+        {
+            int n = (width - x < kChunk) ? width - x : kChunk;
+            row(s + x, index, n, p);
+            for (int i = 0; i < n; i++)
+            {
+                d[x + i] = lut[index[i]];
+            }
+        }
+    }
+}
+
+void ConvertMono8ToDisplay8(const uint8_t* src, size_t srcStride, int width, int height,
+    unsigned int left, unsigned int right, double gamma, uint8_t* dst, size_t dstStride)
+{
+    // 8λֻ256ȡֵӳϳһű
+    WindowParams p = MakeWindowParams(left, right, kGammaIndexMax);
+    const uint8_t* gammaLut = GetGammaTable(IsLinearGamma(gamma) ? 1.0 : gamma);
+
+    uint8_t lut[256];
+    for (unsigned int v = 0; v < 256; v++)
+    {
+        lut[v] = gammaLut[WindowPixel(v, p)];
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t* s = src + y * srcStride;
+        uint8_t* d = dst + y * dstStride;
+        for (int x = 0; x < width; x++)
+        {
+            d[x] = lut[s[x]];
+        }
+    }
+}
+
+// =================================================================
+// α
+// =================================================================
+
+// PseudoColorMapModeһ
+static const int kColorMapHsv = 0;
+static const int kColorMapJet = 1;
+static const int kColorMapRed = 2;
+static const int kColorMapGreen = 3;
+static const int kColorMapBlue = 4;
+static const int kColorMapCount = 5;
+
+static inline uint32_t MakeBgra(double r, double g, double b)
+{
+    auto channel = [](double v) -> uint32_t
+    {
+        v = v * 255.0 + 0.5;
+        if (v < 0.0) v = 0.0;
+        if (v > 255.0) v = 255.0;
+        return static_cast<uint32_t>(v);
+    };
+    return 0xFF000000u | (channel(r) << 16) | (channel(g) << 8) | channel(b);
+}
+
+static double Clamp01(double v)
+{
+    return v < 0.0 ? 0.0 : (v > 1.0 ? 1.0 : v);
+}
+
+static uint32_t ColorMapEntry(int map, double t)
+{
+    switch (map)
+    {
+    case kColorMapHsv:
+    {
+        // ɫ0360㣬ͶȺΪ1
+        double h = t * 6.0;
+        double x = h - static_cast<int>(h);
+        switch (static_cast<int>(h) % 6)
+        {
+        case 0: return MakeBgra(1.0, x, 0.0);
+        case 1: return MakeBgra(1.0 - x, 1.0, 0.0);
+        case 2: return MakeBgra(0.0, 1.0, x);
+        case 3: return MakeBgra(0.0, 1.0 - x, 1.0);
+        case 4: return MakeBgra(x, 0.0, 1.0);
+        default: return MakeBgra(1.0, 0.0, 1.0 - x);
+        }
+    }
+    case kColorMapJet:
+        // ơ죨Matlab jetͬ
+        return MakeBgra(Clamp01(1.5 - fabs(4.0 * t - 3.0)),
+            Clamp01(1.5 - fabs(4.0 * t - 2.0)),
+            Clamp01(1.5 - fabs(4.0 * t - 1.0)));
+    case kColorMapRed:
+        return MakeBgra(t, 0.0, 0.0);
+    case kColorMapGreen:
+        return MakeBgra(0.0, t, 0.0);
+    default:
+        return MakeBgra(0.0, 0.0, t);
+    }
+}
+
+const uint32_t* GetBuiltinColorMap(int map)
+{
+    if (map < 0 || map >= kColorMapCount) return nullptr;
+
+    // ״ʹʱһñ
+    static uint32_t s_maps[kColorMapCount][kColorTableSize];
+    static std::once_flag s_once;
+    std::call_once(s_once, []()
+    {
+        for (int m = 0; m < kColorMapCount; m++)
+        {
+            for (unsigned int i = 0; i < kColorTableSize; i++)
+            {
+                s_maps[m][i] = ColorMapEntry(m, static_cast<double>(i) / (kColorTableSize - 1));
+            }
+        }
+    });
+    return s_maps[map];
+}
+
+/// <summary>
+/// 12λ  12λgammaߣÿ̻߳ʹõһ
+/// </summary>
+struct GammaCurve
+{
+    double gamma;
+    uint16_t curve[kColorTableSize];
+};
+
+static thread_local GammaCurve t_gammaCurve = { 0.0, { 0 } };
+
+void BuildColorTable(const uint32_t* lut, unsigned int lutSize, double gamma, uint32_t* table)
+{
+    const unsigned int indexMax = kColorTableSize - 1;
+
+    if (IsLinearGamma(gamma))
+    {
+        for (unsigned int i = 0; i <= indexMax; i++)
+        {
+            table[i] = lut[(i * (lutSize - 1) + indexMax / 2) / indexMax];
+        }
+        return;
+    }
+
+    if (t_gammaCurve.gamma != gamma)
+    {
+        for (unsigned int i = 0; i <= indexMax; i++)
+        {
+            double v = pow(static_cast<double>(i) / indexMax, gamma) * indexMax + 0.5;
+            t_gammaCurve.curve[i] = static_cast<uint16_t>(v > indexMax ? indexMax : v);
+        }
+        t_gammaCurve.gamma = gamma;
+    }
+
+    for (unsigned int i = 0; i <= indexMax; i++)
+    {
+        table[i] = lut[(t_gammaCurve.curve[i] * (lutSize - 1) + indexMax / 2) / indexMax];
+    }
+}
+
+void ColorizeToBgra32(const uint8_t* src, size_t srcStride, int width, int height, int pixelBytes,
+    unsigned int left, unsigned int right, const uint32_t* table, uint8_t* dst, size_t dstStride)
+{
+    WindowParams p = MakeWindowParams(left, right, kColorTableSize - 1);
+
+    if (pixelBytes == 1)
+    {
+        uint32_t table8[256];
+        for (unsigned int v = 0; v < 256; v++)
+        {
+            table8[v] = table[WindowPixel(v, p)];
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            const uint8_t* s = src + y * srcStride;
+            uint32_t* d = reinterpret_cast<uint32_t*>(dst + y * dstStride);
+            for (int x = 0; x < width; x++)
+            {
+                d[x] = table8[s[x]];
+            }
+        }
+        return;
+    }
+
+    // 16λSIMDزפL1AVX2 gather죩
+    WindowRow16To16Func row = SelectWindowRow16To16();
+
+    const int kChunk = 1024;
+    uint16_t index[kChunk];
+
+    for (int y = 0; y < height; y++)
+    {
+        const uint16_t* s = reinterpret_cast<const uint16_t*>(src + y * srcStride);
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst + y * dstStride);
+
+        for (int x = 0; x < width; x += kChunk)
+        {
+            int n = (width - x < kChunk) ? width - x : kChunk;
+            row(s + x, index, n, p);
+            for (int i = 0; i < n; i++)
+            {
+                d[x + i] = table[index[i]];
+            }
+        }
+    }
+}
+
+// =================================================================
+// 
+// =================================================================
+
+/// <summary>
+/// פ̳߳
+/// ̨̣߳Ĳɼ̣߳ͬʱύύ˳Ŷӣ
+/// ߳ȡδȡÿԼɼ÷ֻȴԼ
+/// ע⣺ⲻ٣DLLжʱڼjoin̻߳˳ʱϵͳ
+/// </summary>
+class StripeWorkers
+{
+public:
+    StripeWorkers()
+    {
+        unsigned int cores = std::thread::hardware_concurrency();
+        unsigned int workers = cores > 1 ? cores - 1 : 0;
+        if (workers > kMaxWorkers) workers = kMaxWorkers;
+
+        for (unsigned int i = 0; i < workers; i++)
+        {
+            std::thread(&StripeWorkers::WorkerProc, this).detach();
+        }
+        m_workerCount = static_cast<int>(workers);
+    }
+
+    int GetWorkerCount() const { return m_workerCount; }
+
+    void Run(int count, const std::function<void(int)>& task)
+    {
+        Job job(task, count);
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_jobs.push_back(&job);
+        }
+        m_wakeCond.notify_all();
+
+        // ߳ͬʱ
+        Execute(job);
+
+        // ȴɣҲĹ̶߳뿪ܴ֮ӶƳ
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_doneCond.wait(lock, [&job]() { return job.finished.load() == job.count && job.active == 0; });
+        m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+    }
+
+private:
+    static const unsigned int kMaxWorkers = 7;
+
+    /// <summary>
+    /// һRunύλڵ̵߳ջϣ
+    /// </summary>
+    struct Job
+    {
+        const std::function<void(int)>& task;
+        const int count;
+        std::atomic<int> next;          // һδȡ
+        std::atomic<int> finished;      // ɵ
+        int active;                     // ִбĹ߳m_lock
+
+        Job(const std::function<void(int)>& t, int n) : task(t), count(n), next(0), finished(0), active(0) {}
+    };
+
+    void Execute(Job& job)
+    {
+        for (;;)
+        {
+            int index = job.next.fetch_add(1);
+            if (index >= job.count) return;
+
+            job.task(index);
+
+            if (job.finished.fetch_add(1) + 1 == job.count)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_doneCond.notify_all();
+            }
+        }
+    }
+
+    // ÷m_lockûдȡʱnullptr
+    Job* FindPendingJob() const
+    {
+        for (Job* job : m_jobs)
+        {
+            if (job->next.load() < job->count) return job;
+        }
+        return nullptr;
+    }
+
+    void WorkerProc()
+    {
+        for (;;)
+        {
+            Job* job;
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_wakeCond.wait(lock, [&]() { return (job = FindPendingJob()) != nullptr; });
+                job->active++;
+            }
+
+            Execute(*job);
+
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (--job->active == 0) m_doneCond.notify_all();
+            }
+        }
+    }
+
+    std::mutex m_lock;
+    std::condition_variable m_wakeCond;
+    std::condition_variable m_doneCond;
+    std::vector<Job*> m_jobs;       // δɵ񣬰ύ˳m_lock
+    int m_workerCount;
+};
+
+static StripeWorkers& GetStripeWorkers()
+{
+    static StripeWorkers* workers = new StripeWorkers();
+    return *workers;
+}
+
+int GetMaxStripeCount()
+{
+    return GetStripeWorkers().GetWorkerCount() + 1;
+}
+
+int ParallelForStripes(int height, int minRows, const std::function<void(int, int, int)>& task)
+{
+    if (height <= 0) return 1;
+    if (minRows < 1) minRows = 1;
+
+    int stripes = height / minRows;
+    int maxStripes = GetMaxStripeCount();
+    if (stripes > maxStripes) stripes = maxStripes;
+    if (stripes < 1) stripes = 1;
+
+    if (stripes == 1)
+    {
+        task(0, 0, height);
+        return 1;
+    }
+
+    std::function<void(int)> stripeTask = [&](int stripe)
+    {
+        int y0 = static_cast<int>(static_cast<long long>(height) * stripe / stripes);
+        int y1 = static_cast<int>(static_cast<long long>(height) * (stripe + 1) / stripes);
+        task(stripe, y0, y1);
+    };
+    GetStripeWorkers().Run(stripes, stripeTask);
+    return stripes;
+}
+
+// =================================================================
+// ֱͼͳ
+// =================================================================
+
+/// <summary>
+/// ÿСʱ̵߳ȿ棩
+/// </summary>
+static const int kHistogramMinRows = 64;
+
+/// <summary>
+/// ڽֱͼ
+/// ͰʱͬһͰĸʸߣֱͼࣻ
+/// ȫֱʣ65536ͰʱΪ2ֱͼL2
+/// </summary>
+static unsigned int SubHistogramCount(unsigned int indexRange)
+{
+    return indexRange <= 16384 ? 4 : 2;
+}
+
+template <typename T>
+static void HistogramRows(const uint8_t* src, size_t srcStride, int width, int y0, int y1,
+    unsigned int shift, uint32_t* sub, unsigned int indexRange, unsigned int subCount)
+{
+    uint32_t* h0 = sub;
+    uint32_t* h1 = sub + indexRange;
+    uint32_t* h2 = sub + indexRange * (subCount > 2 ? 2 : 0);
+    uint32_t* h3 = sub + indexRange * (subCount > 2 ? 3 : 1);
+
+    for (int y = y0; y < y1; y++)
+    {
+        const T* s = reinterpret_cast<const T*>(src + y * srcStride);
+        int x = 0;
+        for (; x + 4 <= width; x += 4)
+        {
+            h0[s[x] >> shift]++;
+            h1[s[x + 1] >> shift]++;
+            h2[s[x + 2] >> shift]++;
+            h3[s[x + 3] >> shift]++;
+        }
+        for (; x < width; x++)
+        {
+            h0[s[x] >> shift]++;
+        }
+    }
+}
+
+void ComputeHistogram(const uint8_t* src, size_t srcStride, int width, int height, int pixelBytes,
+    unsigned int shift, uint32_t* hist, unsigned int binCount)
+{
+    memset(hist, 0, binCount * sizeof(uint32_t));
+    if (width <= 0 || height <= 0 || binCount == 0) return;
+
+    // ֱͼпܵͰţڲѭԽж
+    unsigned int maxValue = pixelBytes == 2 ? 0xFFFF : 0xFF;
+    unsigned int indexRange = (maxValue >> shift) + 1;
+    unsigned int subCount = SubHistogramCount(indexRange);
+    size_t stripeSize = static_cast<size_t>(indexRange) * subCount;
+
+    // ̳߳вֱͼڴ棬ε֮临
+    static thread_local std::vector<uint32_t> t_partial;
+    size_t required = stripeSize * GetMaxStripeCount();
+    if (t_partial.size() < required) t_partial.resize(required);
+    uint32_t* partial = t_partial.data();
+
+    int stripes = ParallelForStripes(height, kHistogramMinRows, [&](int stripe, int y0, int y1)
+    {
+        uint32_t* sub = partial + stripe * stripeSize;
+        memset(sub, 0, stripeSize * sizeof(uint32_t));
+
+        if (pixelBytes == 2)
+            HistogramRows<uint16_t>(src, srcStride, width, y0, y1, shift, sub, indexRange, subCount);
+        else
+            HistogramRows<uint8_t>(src, srcStride, width, y0, y1, shift, sub, indexRange, subCount);
+    });
+
+    // ϲӷɱΧͰ۵һͰ
+    unsigned int direct = indexRange < binCount ? indexRange : binCount;
+    for (size_t part = 0; part < static_cast<size_t>(stripes) * subCount; part++)
+    {
+        const uint32_t* h = partial + part * indexRange;
+        for (unsigned int b = 0; b < direct; b++)
+        {
+            hist[b] += h[b];
+        }
+        for (unsigned int b = direct; b < indexRange; b++)
+        {
+            hist[binCount - 1] += h[b];
+        }
+    }
+}
+
+void ComputeHistogramStats(const uint32_t* hist, unsigned int binCount, double lowPercentile,
+    double highPercentile, unsigned int saturatedValue, HistogramStats* pStats)
+{
+    memset(pStats, 0, sizeof(HistogramStats));
+
+    unsigned long long count = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    bool found = false;
+
+    for (unsigned int v = 0; v < binCount; v++)
+    {
+        uint32_t c = hist[v];
+        if (c == 0) continue;
+
+        if (!found)
+        {
+            pStats->minValue = v;
+            found = true;
+        }
+        pStats->maxValue = v;
+
+        count += c;
+        sum += static_cast<double>(c) * v;
+        sumSquares += static_cast<double>(c) * v * v;
+    }
+
+    pStats->pixelCount = count;
+    if (count == 0) return;
+
+    pStats->mean = sum / count;
+    double variance = sumSquares / count - pStats->mean * pStats->mean;
+    pStats->stdDev = variance > 0.0 ? sqrt(variance) : 0.0;
+
+    if (saturatedValue < binCount) pStats->saturatedPixels = hist[saturatedValue];
+
+    // ٷλ㣺ۼƼ״δﵽĿֵֵ
+    if (lowPercentile < 0.0) lowPercentile = 0.0;
+    if (highPercentile > 100.0) highPercentile = 100.0;
+    unsigned long long lowTarget = static_cast<unsigned long long>(count * lowPercentile / 100.0);
+    unsigned long long highTarget = static_cast<unsigned long long>(count * highPercentile / 100.0);
+    if (lowTarget < 1) lowTarget = 1;
+    if (highTarget < 1) highTarget = 1;
+
+    unsigned long long cumulative = 0;
+    bool lowFound = false;
+    pStats->highClip = pStats->maxValue;
+    for (unsigned int v = pStats->minValue; v <= pStats->maxValue; v++)
+    {
+        cumulative += hist[v];
+        if (!lowFound && cumulative >= lowTarget)
+        {
+            pStats->lowClip = v;
+            lowFound = true;
+        }
+        if (cumulative >= highTarget)
+        {
+            pStats->highClip = v;
+            break;
+        }
+    }
+}
+
+// =================================================================
+// ת/ת
+// =================================================================
+
+/// <summary>
+/// 굽Դӳ䣺sx = x0 + sxPerX*ox + sxPerY*oysy = y0 + syPerX*ox + syPerY*oy
+/// ת/תϺÿϵΪ-101
+/// </summary>
+struct TransformMap
+{
+    int x0, sxPerX, sxPerY;
+    int y0, syPerX, syPerY;
+};
+
+static void MapOutputToSource(int ox, int oy, int width, int height, int rotation, int flip,
+    int* pSx, int* pSy)
+{
+    int outW = 0;
+    int outH = 0;
+    GetTransformedSize(width, height, rotation, &outW, &outH);
+
+    // תתͼ
+    if (flip == 0 || flip == 2) oy = outH - 1 - oy;     // Flip_Xֱת
+    if (flip == 1 || flip == 2) ox = outW - 1 - ox;     // Flip_Yˮƽת
+
+    switch (rotation)
+    {
+    case 1:     // ˳ʱ90
+        *pSx = oy;
+        *pSy = height - 1 - ox;
+        break;
+    case 2:     // 180
+        *pSx = width - 1 - ox;
+        *pSy = height - 1 - oy;
+        break;
+    case 3:     // ˳ʱ270
+        *pSx = width - 1 - oy;
+        *pSy = ox;
+        break;
+    default:
+        *pSx = ox;
+        *pSy = oy;
+        break;
+    }
+}
+
+static TransformMap MakeTransformMap(int width, int height, int rotation, int flip)
+{
+    int x00, y00, x10, y10, x01, y01;
+    MapOutputToSource(0, 0, width, height, rotation, flip, &x00, &y00);
+    MapOutputToSource(1, 0, width, height, rotation, flip, &x10, &y10);
+    MapOutputToSource(0, 1, width, height, rotation, flip, &x01, &y01);
+
+    TransformMap m;
+    m.x0 = x00;
+    m.sxPerX = x10 - x00;
+    m.sxPerY = x01 - x00;
+    m.y0 = y00;
+    m.syPerX = y10 - y00;
+    m.syPerY = y01 - y00;
+    return m;
+}
+
+void GetTransformedSize(int width, int height, int rotation, int* pWidth, int* pHeight)
+{
+    bool transpose = (rotation == 1 || rotation == 3);
+    *pWidth = transpose ? height : width;
+    *pHeight = transpose ? width : height;
+}
+
+/// <summary>
+/// תãoyԴy0 + syPerY*oyΪsxPerX
+/// </summary>
+template <typename T>
+static void TransformRows(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+    int outW, int y0, int y1, const TransformMap& m)
+{
+    for (int oy = y0; oy < y1; oy++)
+    {
+        const T* s = reinterpret_cast<const T*>(src + (m.y0 + m.syPerY * oy) * srcStride) + m.x0;
+        T* d = reinterpret_cast<T*>(dst + oy * dstStride);
+
+        if (m.sxPerX > 0)
+        {
+            memcpy(d, s, outW * sizeof(T));
+        }
+        else
+        {
+            for (int ox = 0; ox < outW; ox++)
+            {
+                d[ox] = s[-ox];
+            }
+        }
+    }
+}
+
+/// <summary>
+/// 8x8תÿ飨8λ/32λ
+/// rows[i]iԴ8أoutRows[j]j8
+/// </summary>
+template <typename T>
+static inline void Transpose8x8(const T* const* rows, T* const* outRows)
+{
+    for (int j = 0; j < 8; j++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            outRows[j][i] = rows[i][j];
+        }
+    }
+}
+
+/// <summary>
+/// 8x8תÿ飨16λSSE2
+/// </summary>
+template <>
+inline void Transpose8x8<uint16_t>(const uint16_t* const* rows, uint16_t* const* outRows)
+{
+    __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[0]));
+    __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[1]));
+    __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[2]));
+    __m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[3]));
+    __m128i a4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[4]));
+    __m128i a5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[5]));
+    __m128i a6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[6]));
+    __m128i a7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[7]));
+
+    __m128i t0 = _mm_unpacklo_epi16(a0, a1);
+    __m128i t1 = _mm_unpackhi_epi16(a0, a1);
+    __m128i t2 = _mm_unpacklo_epi16(a2, a3);
+    __m128i t3 = _mm_unpackhi_epi16(a2, a3);
+    __m128i t4 = _mm_unpacklo_epi16(a4, a5);
+    __m128i t5 = _mm_unpackhi_epi16(a4, a5);
+    __m128i t6 = _mm_unpacklo_epi16(a6, a7);
+    __m128i t7 = _mm_unpackhi_epi16(a6, a7);
+
+    __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+    __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+    __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+    __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+    __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+    __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+    __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+    __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[0]), _mm_unpacklo_epi64(u0, u4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[1]), _mm_unpackhi_epi64(u0, u4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[2]), _mm_unpacklo_epi64(u1, u5));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[3]), _mm_unpackhi_epi64(u1, u5));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[4]), _mm_unpacklo_epi64(u2, u6));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[5]), _mm_unpackhi_epi64(u2, u6));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[6]), _mm_unpacklo_epi64(u3, u7));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outRows[7]), _mm_unpackhi_epi64(u3, u7));
+}
+
+/// <summary>
+/// ֿ߳أ16λʱԴĿ8KBͬʱL1
+/// </summary>
+static const int kTransformTile = 64;
+
+/// <summary>
+/// תãsx = x0 + sxPerY*oysy = y0 + syPerX*ox
+/// 8x8ӦԴе8x8飺ԴoxԴ8oy
+/// </summary>
+template <typename T>
+static void TransformTransposed(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+    int outW, int y0, int y1, const TransformMap& m)
+{
+    auto sourcePixel = [&](int ox, int oy) -> const T*
+    {
+        int sx = m.x0 + m.sxPerY * oy;
+        int sy = m.y0 + m.syPerX * ox;
+        return reinterpret_cast<const T*>(src + sy * srcStride) + sx;
+    };
+
+    int blockEndY = y0 + ((y1 - y0) & ~7);
+    int blockEndX = outW & ~7;
+
+    for (int ty = y0; ty < blockEndY; ty += kTransformTile)
+    {
+        int tyEnd = (ty + kTransformTile < blockEndY) ? ty + kTransformTile : blockEndY;
+
+        for (int tx = 0; tx < blockEndX; tx += kTransformTile)
+        {
+            int txEnd = (tx + kTransformTile < blockEndX) ? tx + kTransformTile : blockEndX;
+
+            for (int by = ty; by < tyEnd; by += 8)
+            {
+                for (int bx = tx; bx < txEnd; bx += 8)
+                {
+                    // ԴڴСsxʼȡ8
+                    int firstOy = m.sxPerY > 0 ? by : by + 7;
+
+                    const T* rows[8];
+                    for (int i = 0; i < 8; i++)
+                    {
+                        rows[i] = sourcePixel(bx + i, firstOy);
+                    }
+
+                    // תúĵjжӦsxϵĵj
+                    T* outRows[8];
+                    for (int j = 0; j < 8; j++)
+                    {
+                        int oy = m.sxPerY > 0 ? by + j : by + 7 - j;
+                        outRows[j] = reinterpret_cast<T*>(dst + oy * dstStride) + bx;
+                    }
+
+                    Transpose8x8<T>(rows, outRows);
+                }
+            }
+        }
+
+        // Ҳ಻8еĲ
+        for (int oy = ty; oy < tyEnd; oy++)
+        {
+            T* d = reinterpret_cast<T*>(dst + oy * dstStride);
+            for (int ox = blockEndX; ox < outW; ox++)
+            {
+                d[ox] = *sourcePixel(ox, oy);
+            }
+        }
+    }
+
+    // ײ8еĲ
+    for (int oy = blockEndY; oy < y1; oy++)
+    {
+        T* d = reinterpret_cast<T*>(dst + oy * dstStride);
+        for (int ox = 0; ox < outW; ox++)
+        {
+            d[ox] = *sourcePixel(ox, oy);
+        }
+    }
+}
+
+template <typename T>
+static void TransformStripe(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+    int outW, int y0, int y1, const TransformMap& m)
+{
+    if (m.sxPerY == 0)
+        TransformRows<T>(src, srcStride, dst, dstStride, outW, y0, y1, m);
+    else
+        TransformTransposed<T>(src, srcStride, dst, dstStride, outW, y0, y1, m);
+}
+
+/// <summary>
+/// ÿ֤һķֿУ
+/// </summary>
+static const int kTransformMinRows = kTransformTile;
+
+void TransformImage(const uint8_t* src, size_t srcStride, int width, int height, int pixelBytes,
+    int rotation, int flip, uint8_t* dst, size_t dstStride)
+{
+    if (width <= 0 || height <= 0) return;
+
+    int outW = 0;
+    int outH = 0;
+    GetTransformedSize(width, height, rotation, &outW, &outH);
+    TransformMap m = MakeTransformMap(width, height, rotation, flip);
+
+    ParallelForStripes(outH, kTransformMinRows, [&](int, int y0, int y1)
+    {
+        // ߽뵽8Уһⲻɢ
+        int alignedY0 = (y0 + 7) & ~7;
+        int alignedY1 = (y1 == outH) ? y1 : ((y1 + 7) & ~7);
+        if (alignedY1 > outH) alignedY1 = outH;
+        if (alignedY0 >= alignedY1) return;
+
+        switch (pixelBytes)
+        {
+        case 1: TransformStripe<uint8_t>(src, srcStride, dst, dstStride, outW, alignedY0, alignedY1, m); break;
+        case 2: TransformStripe<uint16_t>(src, srcStride, dst, dstStride, outW, alignedY0, alignedY1, m); break;
+        default: TransformStripe<uint32_t>(src, srcStride, dst, dstStride, outW, alignedY0, alignedY1, m); break;
+        }
+    });
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+// =================================================================
+// ͼں
+// ;ڲشʾתȣSDKĴ
+// - ÿںṩAVX2/SSE4.1/ʵ֣ʱCPUѡ
+// - пȣֽڣʣַ֧ǽ
+// =================================================================
+
+/// <summary>
+/// SIMDָ
+/// </summary>
+enum SimdLevel
+{
+    SimdLevel_Scalar = 0,
+    SimdLevel_SSE41 = 1,
+    SimdLevel_AVX2 = 2
+};
+
+/// <summary>
+/// ȡǰCPUֵ֧SIMD״εʱ⣩
+/// </summary>
+SimdLevel GetSimdLevel();
+
+/// <summary>
+/// ظʽЧλMono8=8, Mono10=10, Mono12=12, Mono14=14, Mono16=16
+/// </summary>
+/// <returns>0ʾֵ֧ĸʽʽMono12p</returns>
+int GetPixelBitDepth(int pixelFormat);
+
+/// <summary>
+/// ظʽÿصֽ12ֵ֧ĸʽ0
+/// </summary>
+int GetPixelBytes(int pixelFormat);
+
+/// <summary>
+/// Mono16  8λʾת
+/// ӳ䣺[left, right]ӳ䵽[0, 255]پgammaУ = ^gamma
+/// - leftΪ0rightΪ255
+/// - gamma == 1.0ʱȫSIMD
+/// - gammaSIMDӳ䵽12λٲ4096ıפL1
+/// </summary>
+void ConvertMono16ToDisplay8(const uint16_t* src, size_t srcStride, int width, int height,
+    unsigned int left, unsigned int right, double gamma, uint8_t* dst, size_t dstStride);
+
+/// <summary>
+/// Mono8  8λʾתӳͬϣͨ256ıɣ
+/// </summary>
+void ConvertMono8ToDisplay8(const uint8_t* src, size_t srcStride, int width, int height,
+    unsigned int left, unsigned int right, double gamma, uint8_t* dst, size_t dstStride);
+
+// =================================================================
+// α
+// =================================================================
+
+/// <summary>
+/// ϳɺαʱ12λ
+/// </summary>
+static const unsigned int kColorTableSize = 4096;
+
+/// <summary>
+/// ȡαʱ4096BGRA0xAARRGGBB
+/// </summary>
+/// <param name="map">PseudoColorMapModeHSV/Jet/Red/Green/Blue</param>
+/// <returns>nullptrʾֵ֧ģʽ</returns>
+const uint32_t* GetBuiltinColorMap(int map);
+
+/// <summary>
+/// αʱ2564096gammaϳΪ4096ɫ
+/// table[i] = lut[round((i / 4095)^gamma * (lutSize - 1))]
+/// </summary>
+void BuildColorTable(const uint32_t* lut, unsigned int lutSize, double gamma, uint32_t* table);
+
+/// <summary>
+/// ɫ״ɫΪBGRA32
+/// - 16λ룺SIMDӳ䵽12λɫ16KBפL1
+/// - 8λ룺ϳ256ıֱӲ
+/// </summary>
+/// <param name="table">BuildColorTableϳɵ4096ɫ</param>
+void ColorizeToBgra32(const uint8_t* src, size_t srcStride, int width, int height, int pixelBytes,
+    unsigned int left, unsigned int right, const uint32_t* table, uint8_t* dst, size_t dstStride);
+
+// =================================================================
+// 
+// =================================================================
+
+/// <summary>
+/// [0, height)зֳִ
+/// - ʹñⳣפḶ́߳״εʱΪCPU-17߳ͬʱ
+/// - ɲãõụ̀߳ύ˳ȡ÷ֻȴԼ
+/// - task(stripe, y0, y1)stripeΪţ[y0, y1)ΪзΧ
+/// - taskڲٴε
+/// </summary>
+/// <param name="minRows">ÿͼСʱ</param>
+/// <returns>ʵʹõ1</returns>
+int ParallelForStripes(int height, int minRows, const std::function<void(int, int, int)>& task);
+
+/// <summary>
+/// ʱ
+/// </summary>
+int GetMaxStripeCount();
+
+// =================================================================
+// ֱͼͳ
+// =================================================================
+
+/// <summary>
+/// ֱͼ
+/// Ͱ = ֵ >> shiftbinCount-1ֵһͰ
+/// - ̣߳ÿдĲֱͼϲ
+/// - ʹöֱͼֵͬµĶд
+/// </summary>
+/// <param name="pixelBytes">18λ216λ</param>
+/// <param name="hist">binCount</param>
+void ComputeHistogram(const uint8_t* src, size_t srcStride, int width, int height, int pixelBytes,
+    unsigned int shift, uint32_t* hist, unsigned int binCount);
+
+/// <summary>
+/// ֱͼͳƽֵλ
+/// </summary>
+struct HistogramStats
+{
+    unsigned long long pixelCount;
+    unsigned int minValue;
+    unsigned int maxValue;
+    double mean;
+    double stdDev;
+    unsigned int lowClip;               // Ͱٷλ
+    unsigned int highClip;              // ߰ٷλ
+    unsigned long long saturatedPixels; // saturatedValue
+};
+
+/// <summary>
+/// ȫֱֱͼÿֵһͰͳ
+/// </summary>
+/// <param name="lowPercentile">ͰٷλΧ[0, 100]0.1</param>
+/// <param name="highPercentile">߰ٷλΧ[0, 100]99.9</param>
+void ComputeHistogramStats(const uint32_t* hist, unsigned int binCount, double lowPercentile,
+    double highPercentile, unsigned int saturatedValue, HistogramStats* pStats);
+
+// =================================================================
+// ת/ת
+// =================================================================
+
+/// <summary>
+/// ת/תͼߴ磨ת90/270ʱ߻
+/// </summary>
+void GetTransformedSize(int width, int height, int rotation, int* pWidth, int* pHeight);
+
+/// <summary>
+/// ת/ת˳ʱתٶתͼת
+/// - תã0/180ȣиƻ
+/// - תã90/270ȣ64x64ֿ飬8x8תã16λʹSSE2ԴĿ궼L1
+/// - ߳
+/// </summary>
+/// <param name="pixelBytes">124</param>
+/// <param name="rotation">RotationMode0=0, 1=90, 2=180, 3=270ȣ</param>
+/// <param name="flip">FlipMode0=ֱ, 1=ˮƽ, 2=ֱ+ˮƽ-1ʾת</param>
+/// <param name="dst">ߴGetTransformedSizesrcص</param>
+void TransformImage(const uint8_t* src, size_t srcStride, int width, int height, int pixelBytes,
+    int rotation, int flip, uint8_t* dst, size_t dstStride);
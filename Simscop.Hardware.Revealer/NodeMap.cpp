@@ -0,0 +1,309 @@
+#include "NodeMap.h"
+#include "FrameCodec.h"
+#include <SCDefines.h>
+#include <windows.h>
+#include <algorithm>
+#include <set>
+#include <string.h>
+
+NodeMap::NodeMap()
+    : m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr), m_base(nullptr)
+{
+}
+
+NodeMap::~NodeMap()
+{
+    Close();
+}
+
+void NodeMap::Close()
+{
+    m_features.clear();
+    m_entries.clear();
+    m_image.clear();
+    if (m_base) UnmapViewOfFile(m_base);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+    m_base = nullptr;
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+}
+
+/// <summary>
+/// Ƚ϶ֶеֶַΰstrncpy_sضд룩
+/// </summary>
+static bool SameKey(const char (&field)[256], const char* value)
+{
+    return memchr(field, '\0', sizeof(field)) != nullptr && strncmp(field, value, sizeof(field) - 1) == 0;
+}
+
+ErrorCode NodeMap::Parse(const unsigned char* base, size_t size, const char* modelName, const char* deviceVersion)
+{
+    if (size < sizeof(NodeMapFileHeader)) return SC_INVALID_RESOURCE;
+
+    const NodeMapFileHeader* header = reinterpret_cast<const NodeMapFileHeader*>(base);
+    unsigned long long bodyBytes = static_cast<unsigned long long>(header->featureCount) * sizeof(NodeMapFileFeature) +
+        static_cast<unsigned long long>(header->entryCount) * sizeof(NodeMapFileEntry) + header->stringBytes;
+    bool valid = memcmp(header->magic, kNodeMapFileMagic, sizeof(kNodeMapFileMagic)) == 0 &&
+        header->version == kNodeMapFileVersion &&
+        header->headerSize == sizeof(NodeMapFileHeader) &&
+        header->featureCount > 0 && header->stringBytes > 0 &&
+        bodyBytes == size - sizeof(NodeMapFileHeader) &&
+        SameKey(header->modelName, modelName) && SameKey(header->deviceVersion, deviceVersion);
+    if (!valid) return SC_INVALID_RESOURCE;
+
+    const unsigned char* body = base + sizeof(NodeMapFileHeader);
+    if (UpdateCrc32(0, body, static_cast<size_t>(bodyBytes)) != header->checksum) return SC_INVALID_RESOURCE;
+
+    const NodeMapFileFeature* features = reinterpret_cast<const NodeMapFileFeature*>(body);
+    const NodeMapFileEntry* entries = reinterpret_cast<const NodeMapFileEntry*>(features + header->featureCount);
+    const char* strings = reinterpret_cast<const char*>(entries + header->entryCount);
+    if (strings[header->stringBytes - 1] != '\0') return SC_INVALID_RESOURCE;
+
+    m_entries.resize(header->entryCount);
+    for (uint32_t i = 0; i < header->entryCount; i++)
+    {
+        if (entries[i].symbolOffset >= header->stringBytes) return SC_INVALID_RESOURCE;
+        m_entries[i].value = entries[i].value;
+        m_entries[i].symbol = strings + entries[i].symbolOffset;
+    }
+
+    m_features.resize(header->featureCount);
+    for (uint32_t i = 0; i < header->featureCount; i++)
+    {
+        const NodeMapFileFeature& feature = features[i];
+        if (feature.nameOffset >= header->stringBytes || feature.firstEntry > header->entryCount ||
+            feature.entryCount > header->entryCount - feature.firstEntry)
+        {
+            return SC_INVALID_RESOURCE;
+        }
+        m_features[i].name = strings + feature.nameOffset;
+        m_features[i].type = feature.type;
+        m_features[i].entries = feature.entryCount > 0 ? &m_entries[feature.firstEntry] : nullptr;
+        m_features[i].entryCount = feature.entryCount;
+        if (i > 0 && strcmp(m_features[i - 1].name, m_features[i].name) >= 0) return SC_INVALID_RESOURCE;
+    }
+    return SC_OK;
+}
+
+ErrorCode NodeMap::Load(const char* path, const char* modelName, const char* deviceVersion)
+{
+    Close();
+
+    m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) return SC_ERROR;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart < static_cast<long long>(sizeof(NodeMapFileHeader)) ||
+        static_cast<unsigned long long>(size.QuadPart) > static_cast<unsigned long long>(SIZE_MAX))
+    {
+        Close();
+        return SC_INVALID_RESOURCE;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping)
+    {
+        m_base = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!m_base)
+    {
+        Close();
+        return SC_NO_MEMORY;
+    }
+
+    ErrorCode ret = Parse(m_base, static_cast<size_t>(size.QuadPart), modelName, deviceVersion);
+    if (ret != SC_OK) Close();
+    return ret;
+}
+
+/// <summary>
+/// ֵӳдpathдpath.tmpд滻̲ӳ䵽дһļ
+/// </summary>
+static bool SaveNodeMapImage(const char* path, const std::vector<unsigned char>& image)
+{
+    std::string tempPath = std::string(path) + ".tmp";
+    HANDLE file = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    DWORD written = 0;
+    bool ok = WriteFile(file, image.data(), static_cast<DWORD>(image.size()), &written, nullptr) &&
+        written == image.size();
+    CloseHandle(file);
+
+    if (ok) ok = MoveFileExA(tempPath.c_str(), path, MOVEFILE_REPLACE_EXISTING) != FALSE;
+    if (!ok) DeleteFileA(tempPath.c_str());
+    return ok;
+}
+
+ErrorCode NodeMap::Create(const char* path, const char* modelName, const char* deviceVersion,
+    unsigned long long xmlBytes, std::vector<NodeMapFeature>& features)
+{
+    Close();
+    if (features.empty()) return SC_INVALID_PARAM;
+
+    std::sort(features.begin(), features.end(),
+        [](const NodeMapFeature& a, const NodeMapFeature& b) { return a.name < b.name; });
+
+    // ַƺͷУͬķֻһΣ
+    std::string strings;
+    std::vector<NodeMapFileFeature> fileFeatures(features.size());
+    std::vector<NodeMapFileEntry> fileEntries;
+    std::vector<std::pair<std::string, uint32_t>> symbols;
+    for (size_t i = 0; i < features.size(); i++)
+    {
+        fileFeatures[i].nameOffset = static_cast<uint32_t>(strings.size());
+        fileFeatures[i].type = features[i].type;
+        fileFeatures[i].firstEntry = static_cast<uint32_t>(fileEntries.size());
+        fileFeatures[i].entryCount = static_cast<uint32_t>(features[i].entries.size());
+        strings.append(features[i].name.c_str(), features[i].name.size() + 1);
+
+        for (size_t j = 0; j < features[i].entries.size(); j++)
+        {
+            const std::string& symbol = features[i].entries[j].second;
+            auto it = std::find_if(symbols.begin(), symbols.end(),
+                [&](const std::pair<std::string, uint32_t>& s) { return s.first == symbol; });
+            if (it == symbols.end())
+            {
+                symbols.push_back(std::make_pair(symbol, static_cast<uint32_t>(strings.size())));
+                strings.append(symbol.c_str(), symbol.size() + 1);
+                it = symbols.end() - 1;
+            }
+
+            NodeMapFileEntry entry = {};
+            entry.value = features[i].entries[j].first;
+            entry.symbolOffset = it->second;
+            fileEntries.push_back(entry);
+        }
+    }
+
+    size_t featureBytes = fileFeatures.size() * sizeof(NodeMapFileFeature);
+    size_t entryBytes = fileEntries.size() * sizeof(NodeMapFileEntry);
+    std::vector<unsigned char> image(sizeof(NodeMapFileHeader) + featureBytes + entryBytes + strings.size());
+    unsigned char* body = image.data() + sizeof(NodeMapFileHeader);
+    memcpy(body, fileFeatures.data(), featureBytes);
+    if (entryBytes > 0) memcpy(body + featureBytes, fileEntries.data(), entryBytes);
+    memcpy(body + featureBytes + entryBytes, strings.data(), strings.size());
+
+    NodeMapFileHeader header = {};
+    memcpy(header.magic, kNodeMapFileMagic, sizeof(kNodeMapFileMagic));
+    header.version = kNodeMapFileVersion;
+    header.headerSize = sizeof(NodeMapFileHeader);
+    strncpy_s(header.modelName, sizeof(header.modelName), modelName, _TRUNCATE);
+    strncpy_s(header.deviceVersion, sizeof(header.deviceVersion), deviceVersion, _TRUNCATE);
+    header.featureCount = static_cast<uint32_t>(fileFeatures.size());
+    header.entryCount = static_cast<uint32_t>(fileEntries.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+    header.checksum = UpdateCrc32(0, body, image.size() - sizeof(NodeMapFileHeader));
+    header.xmlBytes = xmlBytes;
+    memcpy(image.data(), &header, sizeof(header));
+
+    // ʧܣĿ¼ֻȣʱ´½ճʹڴеֵ
+    if (path) SaveNodeMapImage(path, image);
+
+    m_image.swap(image);
+    ErrorCode ret = Parse(m_image.data(), m_image.size(), modelName, deviceVersion);
+    if (ret != SC_OK) Close();
+    return ret;
+}
+
+const FeatureInfo* NodeMap::Find(const char* name) const
+{
+    auto it = std::lower_bound(m_features.begin(), m_features.end(), name,
+        [](const FeatureInfo& feature, const char* key) { return strcmp(feature.name, key) < 0; });
+    return (it != m_features.end() && strcmp(it->name, name) == 0) ? &*it : nullptr;
+}
+
+// =================================================================
+// GenICam XML
+// =================================================================
+
+/// <summary>
+/// ԽڵԪSwissKnifeRegisterPortڲڵCategoryԣȡ
+/// </summary>
+static const char* const kFeatureElements[] =
+{
+    "Integer", "IntReg", "MaskedIntReg", "IntConverter",
+    "Float", "FloatReg", "Converter",
+    "Enumeration", "Boolean", "Command", "String", "StringReg",
+};
+
+static void ScanGenICamXml(const char* xml, size_t size, std::vector<std::string>* names)
+{
+    std::set<std::string> found;
+    const char* end = xml + size;
+    const char* p = xml;
+    while ((p = static_cast<const char*>(memchr(p, '<', end - p))) != nullptr)
+    {
+        p++;
+
+        // עпʾԪأ
+        if (end - p >= 3 && memcmp(p, "!--", 3) == 0)
+        {
+            const char* close = p + 3;
+            while (close + 3 <= end && memcmp(close, "-->", 3) != 0) close++;
+            p = close;
+            continue;
+        }
+
+        const char* tag = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '>' && *p != '/') p++;
+        size_t tagLength = p - tag;
+
+        bool feature = false;
+        for (size_t i = 0; i < sizeof(kFeatureElements) / sizeof(kFeatureElements[0]) && !feature; i++)
+        {
+            feature = strlen(kFeatureElements[i]) == tagLength && memcmp(kFeatureElements[i], tag, tagLength) == 0;
+        }
+        if (!feature) continue;
+
+        // ڱԪصĿʼǩName="..."
+        const char* tagEnd = static_cast<const char*>(memchr(p, '>', end - p));
+        if (!tagEnd) break;
+        for (const char* a = p; a + 6 < tagEnd; a++)
+        {
+            if ((a[-1] == ' ' || a[-1] == '\t' || a[-1] == '\r' || a[-1] == '\n') && memcmp(a, "Name=\"", 6) == 0)
+            {
+                const char* value = a + 6;
+                const char* quote = static_cast<const char*>(memchr(value, '"', tagEnd - value));
+                if (quote && quote > value) found.insert(std::string(value, quote - value));
+                break;
+            }
+        }
+        p = tagEnd;
+    }
+    names->assign(found.begin(), found.end());
+}
+
+ErrorCode ScanGenICamXml(const char* path, std::vector<std::string>* names, unsigned long long* pBytes)
+{
+    names->clear();
+    *pBytes = 0;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return SC_ERROR;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    const char* base = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 &&
+        static_cast<unsigned long long>(size.QuadPart) <= static_cast<unsigned long long>(SIZE_MAX))
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+
+    if (base)
+    {
+        *pBytes = static_cast<unsigned long long>(size.QuadPart);
+        ScanGenICamXml(base, static_cast<size_t>(size.QuadPart), names);
+        UnmapViewOfFile(base);
+    }
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+
+    return names->empty() ? SC_NOT_SUPPORT : SC_OK;
+}
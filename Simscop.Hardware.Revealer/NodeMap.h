@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Revealer.h"
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+// =================================================================
+// ֵ仺
+// =================================================================
+
+/// <summary>
+/// ֵļչͬĿ¼±صGenICam XMLչ.xml
+/// </summary>
+static const char kNodeMapFileSuffix[] = ".rvn";
+static const char kNodeMapXmlSuffix[] = ".xml";
+
+/// <summary>
+/// ֵļ.rvnļͷ
+///
+/// ļ֣
+/// | ļͷ(576) | (featureCount * NodeMapFileFeature) | ö(entryCount * NodeMapFileEntry) | ַ(stringBytes) |
+/// - ԰strcmpغֲ
+/// - ƺͷΪַ0βַ¼ƫ
+/// - ͺź͹̼汾Ϊͬһͺšͬһ̼һֵ
+/// </summary>
+struct NodeMapFileHeader
+{
+    char magic[8];              // "RVLNMAP\0"
+    uint32_t version;           // ʽ汾
+    uint32_t headerSize;        // ļͷֽ576
+    char modelName[256];        // DeviceInfo.modelName
+    char deviceVersion[256];    // DeviceInfo.deviceVersion
+    uint32_t featureCount;      // 
+    uint32_t entryCount;        // ö
+    uint32_t stringBytes;       // ַֽ
+    uint32_t checksum;          // ļͷ֮ȫݵCRC-32
+    uint64_t xmlBytes;          // ֵʱصXMLֽ
+    uint8_t reserved[24];
+};
+
+struct NodeMapFileFeature
+{
+    uint32_t nameOffset;        // ַƫ
+    int32_t type;               // FeatureType
+    uint32_t firstEntry;        // Enumһö
+    uint32_t entryCount;        // Enumö
+};
+
+struct NodeMapFileEntry
+{
+    uint64_t value;             // öֵ
+    uint32_t symbolOffset;      // ַƫ
+    uint32_t reserved;
+};
+
+static_assert(sizeof(NodeMapFileHeader) == 576, "NodeMapFileHeader must be 576 bytes");
+static_assert(sizeof(NodeMapFileFeature) == 16, "NodeMapFileFeature must be 16 bytes");
+static_assert(sizeof(NodeMapFileEntry) == 16, "NodeMapFileEntry must be 16 bytes");
+
+static const char kNodeMapFileMagic[8] = { 'R', 'V', 'L', 'N', 'M', 'A', 'P', 0 };
+static const uint32_t kNodeMapFileVersion = 1;
+
+/// <summary>
+/// ֵʱһ
+/// </summary>
+struct NodeMapFeature
+{
+    std::string name;
+    int type;                                                       // FeatureType
+    std::vector<std::pair<unsigned long long, std::string>> entries; // Enumöֵţ
+};
+
+/// <summary>
+/// ֵ
+/// ;UIҪȫԵơͺö壻
+///       豸ѯҪٴֵ佨һκ󱣴浽̣ͬͺֱ̼ͬӳʹ
+///
+/// ƣ
+/// - ʱӳļֻƺͷֱָӳڴ棬ֻΪFeatureInfo/EnumEntryһƫƻ
+/// - ʱڴļӳ񣬱ʧܲӰʹ
+/// - ػݲٱ仯صָڶǰЧ
+/// </summary>
+class NodeMap
+{
+public:
+    NodeMap();
+    ~NodeMap();
+
+    NodeMap(const NodeMap&) = delete;
+    NodeMap& operator=(const NodeMap&) = delete;
+
+    /// <summary>ӳֵļУʽУ͡ͺź͹̼汾</summary>
+    /// <returns>SC_OKļʱSC_ERRORЧ豸ʱSC_INVALID_RESOURCE</returns>
+    ErrorCode Load(const char* path, const char* modelName, const char* deviceVersion);
+
+    /// <summary>бֵ䣬дpathдʱļ滻pathΪnullptrʱ棩</summary>
+    /// <param name="features">бʹã</param>
+    /// <returns>SC_OKбΪʱSC_INVALID_PARAMʧʱֵԿãSC_OK</returns>
+    ErrorCode Create(const char* path, const char* modelName, const char* deviceVersion,
+        unsigned long long xmlBytes, std::vector<NodeMapFeature>& features);
+
+    /// <summary>жأغУʧʱʹãѽֵָ䲻Ӧжأ</summary>
+    void Close();
+
+    bool IsLoaded() const { return !m_features.empty(); }
+    const FeatureInfo* Features() const { return m_features.data(); }
+    unsigned int Count() const { return static_cast<unsigned int>(m_features.size()); }
+
+    /// <summary>Ʋңֲң</summary>
+    /// <returns>ֵʱnullptr</returns>
+    const FeatureInfo* Find(const char* name) const;
+
+private:
+    ErrorCode Parse(const unsigned char* base, size_t size, const char* modelName, const char* deviceVersion);
+
+    void* m_file;                       // HANDLE
+    void* m_mapping;                    // HANDLE
+    const unsigned char* m_base;        // ӳʼַ
+    std::vector<unsigned char> m_image; // ֵ䣨δӳļʱʹã
+    std::vector<FeatureInfo> m_features;
+    std::vector<EnumEntry> m_entries;
+};
+
+/// <summary>
+/// GenICam XMLļȡԽڵ㣨Integer/Float/Enumeration/Boolean/String/CommandĴʽ
+/// </summary>
+/// <param name="names">ȥز</param>
+/// <param name="pBytes">ļֽ</param>
+/// <returns>SC_OKļ޷ʱSC_ERRORûԽڵ㣨ѹXMLʱSC_NOT_SUPPORT</returns>
+ErrorCode ScanGenICamXml(const char* path, std::vector<std::string>* names, unsigned long long* pBytes);
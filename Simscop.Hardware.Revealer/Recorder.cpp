@@ -0,0 +1,1435 @@
+#include "Recorder.h"
+#include "FrameMemory.h"
+#include "FrameCodec.h"
+#include "ImageKernels.h"
+#include <SCDefines.h>
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string.h>
+
+/// <summary>
+/// д̻Сÿ飩
+/// </summary>
+static const size_t kChunkSize = 64 * 1024 * 1024;
+
+/// <summary>
+/// ޻I/OĶֽ512e4Kṇ
+/// </summary>
+static const size_t kSectorSize = 4096;
+
+/// <summary>
+/// ļÿԤ
+/// </summary>
+static const unsigned long long kPreallocateStep = 1024ULL * 1024 * 1024;
+
+/// <summary>
+/// ֡۶ֽӳȡʱͼݰж룩
+/// </summary>
+static const size_t kRecordAlignment = 64;
+
+/// <summary>
+/// ѹ֡ѹʱĲ
+/// </summary>
+static const unsigned int kCompressQueueCapacity = 8;
+
+static inline unsigned long long AlignUp(unsigned long long value, unsigned long long alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static long long SteadyMicroseconds()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// <summary>
+/// ԭӵظֵɼ̺߳д߳̿ͬʱ£
+/// </summary>
+static void UpdateMax(std::atomic<unsigned long long>& target, unsigned long long value)
+{
+    unsigned long long current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+static bool WriteAt(HANDLE file, unsigned long long offset, const void* p, DWORD size)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD written = 0;
+    return WriteFile(file, p, size, &written, &overlapped) && written == size;
+}
+
+/// <summary>
+/// д̺ʱϸͰ[2^k, 2^(k+1))Ϊ4ͰͰΪ k*4 + Ͱ0~3΢ֱӶӦͰ0~3
+/// </summary>
+static unsigned int LatencyBin(unsigned long long microseconds)
+{
+    if (microseconds < 4) return static_cast<unsigned int>(microseconds);
+
+    unsigned int k = 0;
+    for (unsigned long long v = microseconds; v > 1; v >>= 1) k++;
+    unsigned int bin = k * 4 + static_cast<unsigned int>((microseconds >> (k - 2)) & 3);
+    return bin < kWriteLatencyBins ? bin : kWriteLatencyBins - 1;
+}
+
+/// <summary>
+/// ϸͰϽ磨΢룩
+/// </summary>
+static unsigned long long LatencyBinUpper(unsigned int bin)
+{
+    if (bin < 4) return bin;
+    unsigned int k = bin / 4;
+    return (static_cast<unsigned long long>(5 + bin % 4) << (k - 2)) - 1;
+}
+
+/// <summary>
+/// ϸͰӦStreamStatisticsֱͼͰ[2^k, 2^(k+1))
+/// </summary>
+static unsigned int LatencyCoarseBin(unsigned int bin)
+{
+    if (bin < 4) return bin < 2 ? 0 : 1;
+    return bin / 4;
+}
+
+/// <summary>
+/// Ϊǰ"ִоά"ȨޣSeManageVolumePrivilege
+/// SetFileValidDataҪȨޣԤ󲻱ļϵͳ
+/// </summary>
+static bool EnableManageVolumePrivilege()
+{
+    static std::once_flag once;
+    static bool enabled = false;
+
+    std::call_once(once, []()
+    {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+            return;
+
+        TOKEN_PRIVILEGES tp = {};
+        tp.PrivilegeCount = 1;
+        tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+        if (LookupPrivilegeValue(nullptr, SE_MANAGE_VOLUME_NAME, &tp.Privileges[0].Luid) &&
+            AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr))
+        {
+            // AdjustTokenPrivilegesδȨʱҲTRUELastError
+            enabled = (GetLastError() == ERROR_SUCCESS);
+        }
+
+        CloseHandle(token);
+    });
+
+    return enabled;
+}
+
+// =================================================================
+// ¼
+// =================================================================
+
+RecordIndex::RecordIndex()
+    : m_blocks(kRecordIndexMaxBlocks, nullptr), m_size(0)
+{
+}
+
+RecordIndex::~RecordIndex()
+{
+    Clear();
+}
+
+bool RecordIndex::Push(const RawIndexEntry& entry)
+{
+    size_t block = m_size / kRecordIndexBlockEntries;
+    if (block >= kRecordIndexMaxBlocks) return false;
+
+    if (!m_blocks[block])
+    {
+        m_blocks[block] = new (std::nothrow) RawIndexEntry[kRecordIndexBlockEntries];
+        if (!m_blocks[block]) return false;
+    }
+
+    m_blocks[block][m_size % kRecordIndexBlockEntries] = entry;
+    m_size++;
+    return true;
+}
+
+void RecordIndex::CopyTo(size_t first, size_t count, RawIndexEntry* dst) const
+{
+    while (count > 0)
+    {
+        size_t n = kRecordIndexBlockEntries - first % kRecordIndexBlockEntries;
+        if (n > count) n = count;
+        memcpy(dst, At(first), n * sizeof(RawIndexEntry));
+        dst += n;
+        first += n;
+        count -= n;
+    }
+}
+
+void RecordIndex::Clear()
+{
+    for (size_t i = 0; i < m_blocks.size() && m_blocks[i]; i++)
+    {
+        delete[] m_blocks[i];
+        m_blocks[i] = nullptr;
+    }
+    m_size = 0;
+}
+
+// =================================================================
+// ԭʼ¼
+// =================================================================
+
+Recorder::Recorder()
+    : m_file(INVALID_HANDLE_VALUE), m_notify(nullptr), m_notifyUser(nullptr),
+    m_chunkCount(kRecordChunkCount), m_spillChunks(0), m_fillIndex(0), m_writeIndex(0), m_fileOffset(0),
+    m_allocated(0), m_dataBytes(0), m_slotSize(0),
+    m_canSetValidData(false), m_header(nullptr), m_codec(RawCodec_None),
+    m_stripeIndex(0), m_stripeCount(0), m_stripeSetId(0), m_sessionTag(0),
+    m_journal(INVALID_HANDLE_VALUE), m_checkpointFrameInterval(0), m_checkpointMilliseconds(0),
+    m_checkpointFrames(0), m_framesEnd(0), m_checkpointTime(0), m_fillingFlushed(0), m_checkpointSector(nullptr),
+    m_compressFinishing(false),
+    m_finishing(false),
+    m_open(false), m_failed(false), m_pushing(0),
+    m_framesReceived(0), m_framesDropped(0), m_framesWritten(0),
+    m_framesSpilled(0), m_bytesReceived(0), m_bytesWritten(0), m_peakQueuedBytes(0), m_capacityBytes(0),
+    m_writeMicroseconds(0), m_writeLatencyMax(0), m_openTime(0), m_closeTime(0)
+{
+    for (unsigned int i = 0; i < kWriteLatencyBins; i++)
+    {
+        m_writeLatency[i].store(0);
+    }
+}
+
+Recorder::~Recorder()
+{
+    Close();
+}
+
+ErrorCode Recorder::Open(const char* path, RecorderNotify notify, void* pUser, int codec)
+{
+    if (m_open.load() || m_writer.joinable()) return SC_BUSY;
+    if (!path || !path[0]) return SC_INVALID_PARAM;
+    if (codec != RawCodec_None && codec != RawCodec_Lz4) return SC_INVALID_PARAM;
+
+    m_header = static_cast<RawFileHeader*>(AllocateFrameMemory(sizeof(RawFileHeader), nullptr));
+    m_checkpointSector = static_cast<unsigned char*>(AllocateFrameMemory(kSectorSize, nullptr));
+    m_chunkCount = static_cast<int>(kRecordChunkCount + m_spillChunks);
+    bool allocated = m_header != nullptr && m_checkpointSector != nullptr;
+    for (int i = 0; i < m_chunkCount; i++)
+    {
+        m_chunks[i].data = static_cast<unsigned char*>(AllocateFrameMemory(kChunkSize, nullptr));
+        m_chunks[i].used = 0;
+        m_chunks[i].framesEnded = 0;
+        m_chunks[i].framesEnd = 0;
+        m_chunks[i].committed.store(0);
+        m_chunks[i].state.store(ChunkState_Free);
+        if (!m_chunks[i].data) allocated = false;
+    }
+    if (!allocated)
+    {
+        ReleaseResources();
+        return SC_NO_MEMORY;
+    }
+
+    m_file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        ReleaseResources();
+        return SC_ERROR;
+    }
+
+    // ļͨI/Oֻ׷ӣ
+    m_journalPath.clear();
+    if (m_checkpointFrameInterval > 0 || m_checkpointMilliseconds > 0)
+    {
+        m_journalPath = std::string(path) + kRecordJournalSuffix;
+        m_journal = CreateFileA(m_journalPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_journal == INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+            ReleaseResources();
+            return SC_ERROR;
+        }
+    }
+
+    if (codec != RawCodec_None)
+    {
+        int ret = m_compressQueue.Open(kCompressQueueCapacity, OverflowPolicy_DropNewest);
+        if (ret != SC_OK)
+        {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+            if (m_journal != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_journal);
+                m_journal = INVALID_HANDLE_VALUE;
+                DeleteFileA(m_journalPath.c_str());
+            }
+            ReleaseResources();
+            return ret;
+        }
+    }
+
+    m_canSetValidData = EnableManageVolumePrivilege();
+    m_notify = notify;
+    m_notifyUser = pUser;
+
+    // ļͷռݵһ黺Ŀͷرʱд
+    memset(m_header, 0, sizeof(RawFileHeader));
+    memcpy(m_header->magic, kRawFileMagic, sizeof(kRawFileMagic));
+    m_header->version = kRawFileVersion;
+    m_header->headerSize = sizeof(RawFileHeader);
+    m_header->codec = static_cast<uint32_t>(codec);
+    m_header->stripeIndex = m_stripeIndex;
+    m_header->stripeCount = m_stripeCount;
+    m_header->stripeSetId = m_stripeSetId;
+
+    // Ǳ¼Ƶָ֡ʱԤеľݵ֡
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    unsigned long long seed = static_cast<unsigned long long>(counter.QuadPart) ^
+        reinterpret_cast<uintptr_t>(this);
+    m_sessionTag = static_cast<uint32_t>(seed ^ (seed >> 32));
+    if (m_sessionTag == 0) m_sessionTag = 1;
+    m_header->sessionTag = m_sessionTag;
+
+    memcpy(m_chunks[0].data, m_header, sizeof(RawFileHeader));
+    m_chunks[0].used = sizeof(RawFileHeader);
+    m_chunks[0].state.store(ChunkState_Filling);
+
+    m_fillIndex = 0;
+    m_writeIndex = 0;
+    m_fileOffset = 0;
+    m_allocated = 0;
+    m_dataBytes = 0;
+    m_slotSize = 0;
+    m_codec = codec;
+    m_compressFinishing.store(false);
+    m_index.Clear();
+    m_checkpointFrames = 0;
+    m_framesEnd = 0;
+    m_checkpointTime = SteadyMicroseconds();
+    m_fillingFlushed = 0;
+    m_finishing = false;
+    m_failed.store(false);
+    m_framesReceived.store(0);
+    m_framesDropped.store(0);
+    m_framesWritten.store(0);
+    m_framesSpilled.store(0);
+    m_bytesReceived.store(sizeof(RawFileHeader));
+    m_bytesWritten.store(0);
+    m_peakQueuedBytes.store(sizeof(RawFileHeader));
+    m_capacityBytes.store(static_cast<unsigned long long>(m_chunkCount) * kChunkSize);
+    m_writeMicroseconds.store(0);
+    m_writeLatencyMax.store(0);
+    for (unsigned int i = 0; i < kWriteLatencyBins; i++)
+    {
+        m_writeLatency[i].store(0);
+    }
+    m_closeTime.store(0);
+    m_openTime.store(SteadyMicroseconds());
+
+    m_writer = std::thread(&Recorder::WriterProc, this);
+    if (m_codec != RawCodec_None) m_compressor = std::thread(&Recorder::CompressorProc, this);
+    m_open.store(true);
+
+    Notify(kExportStart, 0);
+    return SC_OK;
+}
+
+ErrorCode Recorder::Close()
+{
+    if (!m_open.exchange(false)) return SC_OK;
+
+    // ȴڽеPush˳
+    while (m_pushing.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    // ѹ̴߳ʣ֡˳
+    if (m_compressor.joinable())
+    {
+        m_compressFinishing.store(true);
+        m_compressor.join();
+        m_compressQueue.Close();
+    }
+
+    // ׷ӵ֮֡һ飨δһд̣д߳д˳
+    unsigned long long indexBytes = m_index.Size() * sizeof(RawIndexEntry);
+    if (!m_failed.load() && indexBytes > 0)
+    {
+        m_bytesReceived.fetch_add(indexBytes);
+        for (size_t first = 0; first < m_index.Size(); first += kRecordIndexBlockEntries)
+        {
+            size_t count = std::min(m_index.Size() - first, kRecordIndexBlockEntries);
+            Append(m_index.At(first), count * sizeof(RawIndexEntry));
+        }
+    }
+    SubmitChunk(m_fillIndex);
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_finishing = true;
+    }
+    m_cond.notify_all();
+    m_writer.join();
+
+    bool ok = !m_failed.load();
+    if (ok)
+    {
+        // дļͷضϵʵʴСȥԤͶ䣩
+        ok = WriteHeader();
+
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<long long>(sizeof(RawFileHeader) + m_dataBytes + indexBytes);
+        ok = ok && SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN) && SetEndOfFile(m_file);
+    }
+
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+
+    // 㲻ҪʧʱRecoverRecordingʹ
+    if (m_journal != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_journal);
+        m_journal = INVALID_HANDLE_VALUE;
+    }
+    if (ok && !m_journalPath.empty()) DeleteFileA(m_journalPath.c_str());
+
+    ReleaseResources();
+    m_closeTime.store(SteadyMicroseconds());
+
+    if (ok) Notify(kExportFinish, static_cast<int>(m_framesWritten.load()));
+    Notify(kExportClose, ok ? static_cast<int>(m_framesWritten.load()) : kExportFailed);
+    return ok ? SC_OK : SC_ERROR;
+}
+
+void Recorder::ReleaseResources()
+{
+    for (int i = 0; i < m_chunkCount; i++)
+    {
+        FreeFrameMemory(m_chunks[i].data);
+        m_chunks[i].data = nullptr;
+    }
+    FreeFrameMemory(m_header);
+    m_header = nullptr;
+    FreeFrameMemory(m_checkpointSector);
+    m_checkpointSector = nullptr;
+    m_index.Clear();
+    std::vector<unsigned char>().swap(m_compressed);
+    std::vector<unsigned char>().swap(m_checkpointBuffer);
+}
+
+void Recorder::Notify(int status, int progress)
+{
+    if (m_notify) m_notify(status, progress, m_notifyUser);
+}
+
+unsigned long long Recorder::GetQueueDepth() const
+{
+    unsigned long long received = m_framesReceived.load();
+    unsigned long long written = m_framesWritten.load();
+    unsigned long long depth = received > written ? received - written : 0;
+    if (m_codec != RawCodec_None) depth += m_compressQueue.GetCount();
+    return depth;
+}
+
+void Recorder::SetStripe(unsigned int stripeIndex, unsigned int stripeCount, unsigned long long stripeSetId)
+{
+    m_stripeIndex = stripeIndex;
+    m_stripeCount = stripeCount;
+    m_stripeSetId = stripeSetId;
+}
+
+void Recorder::SetCheckpoint(unsigned int frameInterval, unsigned int milliseconds)
+{
+    m_checkpointFrameInterval = frameInterval;
+    m_checkpointMilliseconds = milliseconds;
+}
+
+void Recorder::SetSpillChunks(unsigned int count)
+{
+    m_spillChunks = count < kMaxSpillChunks ? count : kMaxSpillChunks;
+}
+
+unsigned long long Recorder::GetQueuedBytes() const
+{
+    // ȶд̵ֵֽ֤Ϊ
+    unsigned long long written = m_bytesWritten.load();
+    unsigned long long received = m_bytesReceived.load();
+    return received > written ? received - written : 0;
+}
+
+void Recorder::AccumulateStats(RecordStats* pStats, unsigned long long* pLatencyBins, unsigned int* pBusyPercent) const
+{
+    pStats->framesReceived += m_framesReceived.load();
+    pStats->framesWritten += m_framesWritten.load();
+    pStats->framesDropped += m_framesDropped.load();
+    pStats->framesSpilled += m_framesSpilled.load();
+    pStats->queuedFrames += GetQueueDepth();
+    pStats->queuedBytes += GetQueuedBytes();
+    pStats->peakQueuedBytes += m_peakQueuedBytes.load();
+    pStats->capacityBytes += m_capacityBytes.load();
+    pStats->bytesReceived += m_bytesReceived.load();
+
+    unsigned long long bytesWritten = m_bytesWritten.load();
+    unsigned long long busy = m_writeMicroseconds.load();
+    pStats->bytesWritten += bytesWritten;
+    if (busy > 0) pStats->diskMBps += bytesWritten / static_cast<double>(busy);
+
+    unsigned long long latencyMax = m_writeLatencyMax.load();
+    if (latencyMax > pStats->writeLatencyMax) pStats->writeLatencyMax = latencyMax;
+    for (unsigned int i = 0; i < kWriteLatencyBins; i++)
+    {
+        unsigned long long count = m_writeLatency[i].load();
+        pLatencyBins[i] += count;
+        pStats->writeLatencyHistogram[LatencyCoarseBin(i)] += count;
+    }
+
+    long long elapsed = GetElapsedMicroseconds();
+    *pBusyPercent = elapsed > 0 ? static_cast<unsigned int>(busy * 100 / static_cast<unsigned long long>(elapsed)) : 0;
+}
+
+long long Recorder::GetElapsedMicroseconds() const
+{
+    long long openTime = m_openTime.load();
+    if (openTime == 0) return 0;
+
+    long long closeTime = m_closeTime.load();
+    return (closeTime != 0 ? closeTime : SteadyMicroseconds()) - openTime;
+}
+
+bool Recorder::Push(const ImageData& image, bool wait)
+{
+    m_pushing.fetch_add(1);
+
+    bool accepted = false;
+    if (m_open.load() && !m_failed.load() && image.pData && image.dataSize > 0)
+    {
+        if (m_codec != RawCodec_None)
+        {
+            accepted = GetPixelBytes(image.pixelFormat) != 0 && m_compressQueue.Push(image, m_open);
+        }
+        else
+        {
+            accepted = AppendFrame(image, image.pData, static_cast<size_t>(image.dataSize), wait);
+        }
+    }
+
+    if (!accepted && m_open.load()) m_framesDropped.fetch_add(1);
+
+    m_pushing.fetch_sub(1);
+    return accepted;
+}
+
+/// <summary>
+/// ׷һ֡¼֡¼ͷ + payload + 䣩
+/// </summary>
+/// <param name="image">֡ϢpDataʹã</param>
+/// <param name="payload">֡¼ͷ֮󱣴ݣԭʼͼѹݣ</param>
+/// <param name="wait">true=ʱȴд̣߳ѹ̣߳false=ɼ̣߳</param>
+/// <returns>true=д뻺</returns>
+bool Recorder::AppendFrame(const ImageData& image, const void* payload, size_t payloadSize, bool wait)
+{
+    size_t recordSize;
+    if (m_codec == RawCodec_None)
+    {
+        if (m_slotSize == 0)
+        {
+            m_slotSize = static_cast<size_t>(AlignUp(sizeof(RawFrameHeader) + payloadSize, kRecordAlignment));
+        }
+        recordSize = m_slotSize;
+        if (sizeof(RawFrameHeader) + payloadSize > recordSize) return false;
+    }
+    else
+    {
+        recordSize = static_cast<size_t>(AlignUp(sizeof(RawFrameHeader) + payloadSize, kRecordAlignment));
+    }
+
+    if (!wait)
+    {
+        // һ¼Խ飺ǰʣռһ飨Уŵ
+        // дǰлһ飬ϸСڱȽ
+        size_t available = kChunkSize - m_chunks[m_fillIndex].used;
+        if (m_chunks[(m_fillIndex + 1) % m_chunkCount].state.load() == ChunkState_Free)
+        {
+            available += kChunkSize;
+        }
+        if (recordSize >= available) return false;
+    }
+
+    if (m_dataBytes == 0)
+    {
+        m_header->width = image.width;
+        m_header->height = image.height;
+        m_header->stride = image.stride;
+        m_header->pixelFormat = image.pixelFormat;
+        m_header->slotSize = m_codec == RawCodec_None ? static_cast<uint32_t>(recordSize) : 0;
+    }
+
+    RawIndexEntry entry;
+    entry.blockId = image.blockId;
+    entry.timeStamp = image.timeStamp;
+    entry.offset = sizeof(RawFileHeader) + m_dataBytes;
+    if (!m_index.Push(entry)) return false;
+
+    RawFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kRawFrameMagic;
+    header.headerSize = sizeof(RawFrameHeader);
+    header.blockId = image.blockId;
+    header.timeStamp = image.timeStamp;
+    header.dataSize = static_cast<uint32_t>(image.dataSize);
+    header.recordSize = static_cast<uint32_t>(recordSize);
+    header.width = image.width;
+    header.height = image.height;
+    header.stride = image.stride;
+    header.pixelFormat = image.pixelFormat;
+    header.storedSize = static_cast<uint32_t>(payloadSize);
+    header.sessionTag = m_sessionTag;
+
+    static const unsigned char kPadding[kRecordAlignment] = { 0 };
+    Append(&header, sizeof(header));
+    Append(payload, payloadSize);
+    Append(kPadding, recordSize - sizeof(header) - payloadSize);
+
+    Chunk& chunk = m_chunks[m_fillIndex];
+    chunk.framesEnded++;
+    chunk.framesEnd = entry.offset + recordSize;
+    chunk.committed.store((static_cast<unsigned long long>(chunk.framesEnded) << 32) | chunk.used,
+        std::memory_order_release);
+    m_dataBytes += recordSize;
+    m_framesReceived.fetch_add(1);
+
+    // ѹд̻ʱ֡λڴ
+    unsigned long long queued = m_bytesReceived.fetch_add(recordSize) + recordSize - m_bytesWritten.load();
+    if (queued > kRecordChunkCount * kChunkSize) m_framesSpilled.fetch_add(1);
+    UpdateMax(m_peakQueuedBytes, queued);
+    return true;
+}
+
+/// <summary>
+/// ѹ̣߳ѹȡֿ֡鲢ѹд뻺
+/// </summary>
+void Recorder::CompressorProc()
+{
+    for (;;)
+    {
+        // β׶βٵȴȡպ˳
+        bool finishing = m_compressFinishing.load();
+
+        ImageData image;
+        int ret = m_compressQueue.Pop(&image, finishing ? 0 : 100);
+        if (ret != SC_OK)
+        {
+            if (finishing || ret != SC_TIMEOUT) return;
+            continue;
+        }
+
+        if (m_failed.load()) continue;
+
+        int pixelBytes = GetPixelBytes(image.pixelFormat);
+        size_t bound = GetCompressedFrameBound(image.width, image.height, pixelBytes);
+        if (m_compressed.size() < bound) m_compressed.resize(bound);
+
+        size_t size = CompressFrame(image.pData, image.stride, image.width, image.height, pixelBytes,
+            m_compressed.data(), m_compressed.size());
+        if (size == 0)
+        {
+            m_framesDropped.fetch_add(1);
+            continue;
+        }
+
+        // ѹΪ
+        ImageData packed = image;
+        packed.stride = image.width * pixelBytes;
+        packed.dataSize = packed.stride * image.height;
+        AppendFrame(packed, m_compressed.data(), size, true);
+    }
+}
+
+/// <summary>
+/// ׷ӵǰ飬ʱύлһ
+/// PushǰȷһУȴClose׷ʱܵȴд߳
+/// </summary>
+void Recorder::Append(const void* p, size_t size)
+{
+    const unsigned char* src = static_cast<const unsigned char*>(p);
+    while (size > 0)
+    {
+        Chunk& chunk = m_chunks[m_fillIndex];
+        size_t n = kChunkSize - chunk.used;
+        if (n > size) n = size;
+
+        memcpy(chunk.data + chunk.used, src, n);
+        chunk.used += n;
+        src += n;
+        size -= n;
+
+        if (chunk.used == kChunkSize)
+        {
+            SubmitChunk(m_fillIndex);
+            m_fillIndex = (m_fillIndex + 1) % m_chunkCount;
+            WaitChunkFree(m_fillIndex);
+            m_chunks[m_fillIndex].used = 0;
+            m_chunks[m_fillIndex].framesEnded = 0;
+            m_chunks[m_fillIndex].committed.store(0);
+            m_chunks[m_fillIndex].state.store(ChunkState_Filling);
+        }
+    }
+}
+
+void Recorder::WaitChunkFree(int index)
+{
+    Chunk& chunk = m_chunks[index];
+    if (chunk.state.load() == ChunkState_Free) return;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [&]() { return chunk.state.load() == ChunkState_Free; });
+}
+
+void Recorder::SubmitChunk(int index)
+{
+    Chunk& chunk = m_chunks[index];
+    if (chunk.state.load() != ChunkState_Filling) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        chunk.state.store(ChunkState_Ready);
+    }
+    m_cond.notify_all();
+}
+
+void Recorder::WriterProc()
+{
+    for (;;)
+    {
+        Chunk& chunk = m_chunks[m_writeIndex];
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            auto ready = [&]() { return chunk.state.load() == ChunkState_Ready || m_finishing; };
+            while (!ready())
+            {
+                if (m_journal == INVALID_HANDLE_VALUE || m_checkpointMilliseconds == 0 || m_failed.load())
+                {
+                    m_cond.wait(lock, ready);
+                    break;
+                }
+
+                // ʱļ㣺ȵһʱ䣬δдʱд֡
+                long long remaining = m_checkpointTime + m_checkpointMilliseconds * 1000LL - SteadyMicroseconds();
+                if (remaining < 1000) remaining = 1000;
+                if (!m_cond.wait_for(lock, std::chrono::microseconds(remaining), ready))
+                {
+                    lock.unlock();
+                    WriteFillingCheckpoint(chunk);
+
+                    // ûµ֡ͣȴʼ֡ʱͬƳٵһд̲߳ת
+                    long long now = SteadyMicroseconds();
+                    if (now - m_checkpointTime >= m_checkpointMilliseconds * 1000LL) m_checkpointTime = now;
+                    lock.lock();
+                }
+            }
+            if (chunk.state.load() != ChunkState_Ready) return;
+        }
+
+        if (!m_failed.load())
+        {
+            // һδ㵽СĲڹرʱضϣ
+            size_t bytes = static_cast<size_t>(AlignUp(chunk.used, kSectorSize));
+            memset(chunk.data + chunk.used, 0, bytes - chunk.used);
+
+            long long start = SteadyMicroseconds();
+            if (WriteChunk(chunk, bytes))
+            {
+                unsigned long long elapsed = static_cast<unsigned long long>(SteadyMicroseconds() - start);
+                m_writeMicroseconds.fetch_add(elapsed);
+                m_writeLatency[LatencyBin(elapsed)].fetch_add(1);
+                UpdateMax(m_writeLatencyMax, elapsed);
+
+                m_bytesWritten.fetch_add(chunk.used);
+                m_framesWritten.fetch_add(chunk.framesEnded);
+                if (chunk.framesEnded > 0) m_framesEnd = chunk.framesEnd;
+                if (m_journal != INVALID_HANDLE_VALUE) WriteCheckpoint();
+                Notify(kExportProcessing, static_cast<int>(m_framesWritten.load()));
+            }
+            else
+            {
+                // ֮֡ȫCloseϱʧ
+                m_failed.store(true);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            chunk.state.store(ChunkState_Free);
+        }
+        m_cond.notify_all();
+        m_writeIndex = (m_writeIndex + 1) % m_chunkCount;
+    }
+}
+
+/// <summary>
+/// Ԥļendֽ
+/// </summary>
+bool Recorder::EnsureAllocated(unsigned long long end)
+{
+    if (end <= m_allocated) return true;
+
+    unsigned long long size = AlignUp(end, kPreallocateStep);
+
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<long long>(size);
+    if (!SetFilePointerEx(m_file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file))
+        return false;
+
+    // Ȩʱļϵͳ㣨ʧܲӰȷԣ
+    if (m_canSetValidData) SetFileValidData(m_file, static_cast<long long>(size));
+
+    m_allocated = size;
+    return true;
+}
+
+/// <summary>
+/// ѿдm_fileOffsetʱд
+/// </summary>
+bool Recorder::WriteChunk(Chunk& chunk, size_t bytes)
+{
+    if (!EnsureAllocated(m_fileOffset + bytes)) return false;
+
+    // ͬͨOVERLAPPEDָƫƣļָ
+    size_t skip = m_fillingFlushed < bytes ? m_fillingFlushed : bytes;
+    unsigned long long offset = m_fileOffset + skip;
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD written = 0;
+    DWORD size = static_cast<DWORD>(bytes - skip);
+    if (size > 0 && (!WriteFile(m_file, chunk.data + skip, size, &written, &overlapped) || written != size))
+        return false;
+
+    m_fileOffset += bytes;
+    m_fillingFlushed = 0;
+    return true;
+}
+
+/// <summary>
+/// д̣߳дһ󣬴ﵽ֡/ʱʱд
+/// </summary>
+void Recorder::WriteCheckpoint()
+{
+    unsigned long long frames = m_framesWritten.load();
+    long long now = SteadyMicroseconds();
+    if (IsCheckpointDue(frames, now)) CommitCheckpoint(frames, m_framesEnd, now);
+}
+
+/// <summary>
+/// д̣߳д֮䶨ʱãĿ֡дļд
+/// - ļеλþm_fileOffset֮ǰĿ鶼дֻ꣩ȡɼ߳ѷcommittedĲ֣
+///   ɼֻ߳׷ӣҪ
+/// - ϴֱ֮ӴӿдƵд
+///   m_fileOffsetǰдʱдǲ
+/// </summary>
+void Recorder::WriteFillingCheckpoint(Chunk& chunk)
+{
+    if (chunk.state.load() != ChunkState_Filling) return;
+
+    unsigned long long committed = chunk.committed.load(std::memory_order_acquire);
+    size_t used = static_cast<size_t>(committed & 0xFFFFFFFF);
+    unsigned long long frames = m_framesWritten.load() + (committed >> 32);
+
+    long long now = SteadyMicroseconds();
+    if (!IsCheckpointDue(frames, now)) return;
+
+    size_t whole = used & ~(kSectorSize - 1);
+    size_t tail = used - whole;
+    bool ok = EnsureAllocated(m_fileOffset + AlignUp(used, kSectorSize));
+    if (ok && whole > m_fillingFlushed)
+    {
+        ok = WriteAt(m_file, m_fileOffset + m_fillingFlushed, chunk.data + m_fillingFlushed,
+            static_cast<DWORD>(whole - m_fillingFlushed));
+        if (ok) m_fillingFlushed = whole;
+    }
+    if (ok && tail > 0)
+    {
+        memcpy(m_checkpointSector, chunk.data + whole, tail);
+        memset(m_checkpointSector + tail, 0, kSectorSize - tail);
+        ok = WriteAt(m_file, m_fileOffset + whole, m_checkpointSector, static_cast<DWORD>(kSectorSize));
+    }
+    if (!ok)
+    {
+        CloseHandle(m_journal);
+        m_journal = INVALID_HANDLE_VALUE;
+        return;
+    }
+
+    CommitCheckpoint(frames, m_fileOffset + used, now);
+}
+
+bool Recorder::IsCheckpointDue(unsigned long long frames, long long now) const
+{
+    if (frames <= m_checkpointFrames) return false;
+    return (m_checkpointFrameInterval > 0 && frames - m_checkpointFrames >= m_checkpointFrameInterval) ||
+        (m_checkpointMilliseconds > 0 && now - m_checkpointTime >= m_checkpointMilliseconds * 1000LL);
+}
+
+/// <summary>
+/// д̣߳ˢ¼ļѵm_checkpointFramesframes֡׷ӵļ
+/// дʧֹֻͣ㣬Ӱ¼
+/// </summary>
+/// <param name="dataEnd">frames֡Ľƫƣļƫƣ</param>
+void Recorder::CommitCheckpoint(unsigned long long frames, unsigned long long dataEnd, long long now)
+{
+    // ȱ֤㸲ǵ֡
+    if (!FlushFileBuffers(m_file))
+    {
+        CloseHandle(m_journal);
+        m_journal = INVALID_HANDLE_VALUE;
+        return;
+    }
+
+    size_t entries = static_cast<size_t>(frames - m_checkpointFrames);
+    size_t bytes = sizeof(RawCheckpointHeader) + entries * sizeof(RawIndexEntry);
+    if (m_checkpointBuffer.size() < bytes) m_checkpointBuffer.resize(bytes);
+    m_index.CopyTo(static_cast<size_t>(m_checkpointFrames), entries,
+        reinterpret_cast<RawIndexEntry*>(m_checkpointBuffer.data() + sizeof(RawCheckpointHeader)));
+
+    RawCheckpointHeader header;
+    header.magic = kRawCheckpointMagic;
+    header.entryCount = static_cast<uint32_t>(entries);
+    header.frameCount = frames;
+    header.dataEnd = dataEnd;
+    header.sessionTag = m_sessionTag;
+    header.checksum = 0;
+    memcpy(m_checkpointBuffer.data(), &header, sizeof(header));
+    header.checksum = UpdateCrc32(0, m_checkpointBuffer.data(), bytes);
+    memcpy(m_checkpointBuffer.data(), &header, sizeof(header));
+
+    DWORD written = 0;
+    if (!WriteFile(m_journal, m_checkpointBuffer.data(), static_cast<DWORD>(bytes), &written, nullptr) ||
+        written != bytes || !FlushFileBuffers(m_journal))
+    {
+        CloseHandle(m_journal);
+        m_journal = INVALID_HANDLE_VALUE;
+        return;
+    }
+
+    m_checkpointFrames = frames;
+    m_checkpointTime = now;
+}
+
+bool Recorder::WriteHeader()
+{
+    m_header->frameCount = m_index.Size();
+    m_header->dataBytes = m_dataBytes;
+    m_header->indexOffset = sizeof(RawFileHeader) + m_dataBytes;
+    m_header->indexBytes = m_index.Size() * sizeof(RawIndexEntry);
+
+    OVERLAPPED overlapped = {};
+    DWORD written = 0;
+    return WriteFile(m_file, m_header, sizeof(RawFileHeader), &written, &overlapped) &&
+        written == sizeof(RawFileHeader);
+}
+
+// =================================================================
+// ָ
+// =================================================================
+
+static bool ReadAt(HANDLE file, unsigned long long offset, void* p, DWORD size)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD read = 0;
+    return ReadFile(file, p, size, &read, &overlapped) && read == size;
+}
+
+/// <summary>
+/// ȡoffset֡¼ͷǷڱ¼Ҽ¼ļΧ
+/// </summary>
+/// <param name="slotSize">ԭʼʽ֡۴С0=δȷ</param>
+static bool ReadRecoverableFrame(HANDLE file, const RawFileHeader& header, unsigned long long fileSize,
+    unsigned long long offset, uint32_t slotSize, RawFrameHeader* pFrame)
+{
+    if (offset + sizeof(RawFrameHeader) > fileSize || !ReadAt(file, offset, pFrame, sizeof(RawFrameHeader)))
+        return false;
+
+    const RawFrameHeader& frame = *pFrame;
+    return frame.magic == kRawFrameMagic &&
+        frame.headerSize == sizeof(RawFrameHeader) &&
+        frame.sessionTag == header.sessionTag &&
+        frame.recordSize >= sizeof(RawFrameHeader) && frame.recordSize % kRecordAlignment == 0 &&
+        frame.storedSize <= frame.recordSize - sizeof(RawFrameHeader) &&
+        offset + frame.recordSize <= fileSize &&
+        (header.codec != RawCodec_None || slotSize == 0 || frame.recordSize == slotSize);
+}
+
+/// <summary>
+/// ӼļȡȷϵһЧ¼дһ롢УͲΪֹ
+/// </summary>
+/// <returns>һЧ¼dataEndûЧ¼ʱΪļͷ֮</returns>
+static unsigned long long ReadCheckpoints(const std::string& journalPath, const RawFileHeader& header,
+    unsigned long long fileSize, std::vector<RawIndexEntry>& index)
+{
+    unsigned long long dataEnd = sizeof(RawFileHeader);
+
+    HANDLE journal = CreateFileA(journalPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (journal == INVALID_HANDLE_VALUE) return dataEnd;
+
+    LARGE_INTEGER size;
+    std::vector<unsigned char> data;
+    if (GetFileSizeEx(journal, &size) && size.QuadPart > 0 && size.QuadPart < 0x7FFFFFFF)
+    {
+        data.resize(static_cast<size_t>(size.QuadPart));
+        if (!ReadAt(journal, 0, data.data(), static_cast<DWORD>(data.size()))) data.clear();
+    }
+    CloseHandle(journal);
+
+    size_t position = 0;
+    while (data.size() - position >= sizeof(RawCheckpointHeader))
+    {
+        RawCheckpointHeader record;
+        memcpy(&record, data.data() + position, sizeof(record));
+        unsigned long long entryBytes = static_cast<unsigned long long>(record.entryCount) * sizeof(RawIndexEntry);
+        if (record.magic != kRawCheckpointMagic || record.sessionTag != header.sessionTag ||
+            record.entryCount == 0 || record.frameCount != index.size() + record.entryCount ||
+            record.dataEnd <= dataEnd || record.dataEnd > fileSize ||
+            entryBytes > data.size() - position - sizeof(record))
+        {
+            break;
+        }
+
+        const unsigned char* entries = data.data() + position + sizeof(record);
+        uint32_t checksum = record.checksum;
+        record.checksum = 0;
+        uint32_t crc = UpdateCrc32(0, reinterpret_cast<const uint8_t*>(&record), sizeof(record));
+        crc = UpdateCrc32(crc, entries, static_cast<size_t>(entryBytes));
+        if (crc != checksum) break;
+
+        const RawIndexEntry* first = reinterpret_cast<const RawIndexEntry*>(entries);
+        index.insert(index.end(), first, first + record.entryCount);
+        dataEnd = record.dataEnd;
+        position += sizeof(record) + static_cast<size_t>(entryBytes);
+    }
+    return dataEnd;
+}
+
+static ErrorCode RecoverFile(HANDLE file, const std::string& journalPath, unsigned long long* pFrameCount)
+{
+    LARGE_INTEGER size;
+    RawFileHeader header;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<long long>(sizeof(RawFileHeader)) ||
+        !ReadAt(file, 0, &header, sizeof(header)))
+    {
+        return SC_INVALID_RESOURCE;
+    }
+    unsigned long long fileSize = static_cast<unsigned long long>(size.QuadPart);
+
+    if (memcmp(header.magic, kRawFileMagic, sizeof(kRawFileMagic)) != 0 || header.version != kRawFileVersion ||
+        header.headerSize != sizeof(RawFileHeader) ||
+        (header.codec != RawCodec_None && header.codec != RawCodec_Lz4))
+    {
+        return SC_INVALID_RESOURCE;
+    }
+
+    // 
+    if (header.indexOffset != 0)
+    {
+        if (pFrameCount) *pFrameCount = header.frameCount;
+        return SC_OK;
+    }
+    if (header.sessionTag == 0) return SC_INVALID_RESOURCE;
+
+    std::vector<RawIndexEntry> index;
+    unsigned long long dataEnd = ReadCheckpoints(journalPath, header, fileSize, index);
+
+    // ֡ȡԵһ֡
+    RawFrameHeader frame;
+    uint32_t slotSize = 0;
+    if (!index.empty())
+    {
+        if (!ReadRecoverableFrame(file, header, fileSize, index[0].offset, 0, &frame)) return SC_INVALID_RESOURCE;
+        if (header.codec == RawCodec_None) slotSize = frame.recordSize;
+    }
+
+    // ɨһ֮֡
+    // д̰ļ˳Уһ¼ͷЧ˵¼д룻
+    // ʱдĿֻдһ֣һ޷ȷϵļ¼ָ
+    unsigned long long offset = dataEnd;
+    bool valid = ReadRecoverableFrame(file, header, fileSize, offset, slotSize, &frame);
+    while (valid)
+    {
+        if (header.codec == RawCodec_None && slotSize == 0) slotSize = frame.recordSize;
+
+        unsigned long long end = offset + frame.recordSize;
+        RawFrameHeader next;
+        bool nextValid = ReadRecoverableFrame(file, header, fileSize, end, slotSize, &next);
+        if (!nextValid) break;
+
+        RawIndexEntry entry;
+        entry.blockId = frame.blockId;
+        entry.timeStamp = frame.timeStamp;
+        entry.offset = offset;
+        index.push_back(entry);
+
+        offset = end;
+        frame = next;
+        valid = nextValid;
+    }
+    dataEnd = offset;
+
+    if (!index.empty())
+    {
+        if (!ReadRecoverableFrame(file, header, fileSize, index[0].offset, 0, &frame)) return SC_INVALID_RESOURCE;
+        header.width = frame.width;
+        header.height = frame.height;
+        header.stride = frame.stride;
+        header.pixelFormat = frame.pixelFormat;
+        header.slotSize = slotSize;
+    }
+
+    // дһ̺֮֡ٻдļͷȥԤĲ
+    unsigned long long indexBytes = index.size() * sizeof(RawIndexEntry);
+    header.frameCount = index.size();
+    header.dataBytes = dataEnd - sizeof(RawFileHeader);
+    header.indexOffset = dataEnd;
+    header.indexBytes = indexBytes;
+
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<long long>(dataEnd + indexBytes);
+    bool ok = (indexBytes == 0 || WriteAt(file, dataEnd, index.data(), static_cast<DWORD>(indexBytes))) &&
+        FlushFileBuffers(file) &&
+        WriteAt(file, 0, &header, sizeof(header)) &&
+        SetFilePointerEx(file, end, nullptr, FILE_BEGIN) && SetEndOfFile(file) &&
+        FlushFileBuffers(file);
+    if (!ok) return SC_ERROR;
+
+    if (pFrameCount) *pFrameCount = index.size();
+    return SC_OK;
+}
+
+ErrorCode RecoverRecording(const char* path, unsigned long long* pFrameCount)
+{
+    if (!path || !path[0]) return SC_INVALID_PARAM;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return SC_ERROR;
+
+    std::string journalPath = std::string(path) + kRecordJournalSuffix;
+    ErrorCode ret = RecoverFile(file, journalPath, pFrameCount);
+    CloseHandle(file);
+
+    if (ret == SC_OK) DeleteFileA(journalPath.c_str());
+    return ret;
+}
+
+// =================================================================
+// StripedRecorder
+// =================================================================
+
+StripedRecorder::StripedRecorder()
+    : m_stripeCount(0), m_next(0), m_notify(nullptr), m_notifyUser(nullptr), m_spill(kDefaultRecordSpill),
+    m_checkpointFrameInterval(0), m_checkpointMilliseconds(0), m_pressure(false), m_decimateCounter(0), m_framesDecimated(0), m_pressureEvents(0),
+    m_openTime(0), m_closeTime(0), m_open(false), m_pushing(0)
+{
+    for (unsigned int i = 0; i < kMaxRecordStripes; i++)
+    {
+        m_notifyContexts[i].owner = this;
+        m_notifyContexts[i].index = i;
+        m_written[i].store(0);
+    }
+}
+
+StripedRecorder::~StripedRecorder()
+{
+    Close();
+}
+
+ErrorCode StripedRecorder::Open(const char* const* paths, unsigned int count, RecorderNotify notify, void* pUser,
+    int codec)
+{
+    if (m_open.load()) return SC_BUSY;
+    if (!paths || count == 0 || count > kMaxRecordStripes) return SC_INVALID_PARAM;
+
+    // ʶͬһͬͬ¼֮䲻ͬ
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    unsigned long long setId = static_cast<unsigned long long>(counter.QuadPart) ^
+        (static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(this)) << 16);
+
+    m_notify = notify;
+    m_notifyUser = pUser;
+
+    long long openTime = SteadyMicroseconds();
+
+    // ڴԤƽָ
+    unsigned long long spillChunks = 0;
+    if (m_spill.policy == RecordSpill_Memory) spillChunks = m_spill.memoryBytes / kChunkSize / count;
+    if (spillChunks > kMaxSpillChunks) spillChunks = kMaxSpillChunks;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        m_written[i].store(0);
+        m_stripes[i].SetStripe(i, count > 1 ? count : 0, count > 1 ? setId : 0);
+        m_stripes[i].SetSpillChunks(static_cast<unsigned int>(spillChunks));
+        m_stripes[i].SetCheckpoint(m_checkpointFrameInterval, m_checkpointMilliseconds);
+
+        int ret = m_stripes[i].Open(paths[i], StripeNotify, &m_notifyContexts[i], codec);
+        if (ret != SC_OK)
+        {
+            // Ѵرպɾ²
+            for (unsigned int k = 0; k < i; k++)
+            {
+                m_stripes[k].Close();
+                DeleteFileA(paths[k]);
+            }
+            return ret;
+        }
+    }
+
+    m_stripeCount = count;
+    m_openTime.store(openTime);
+    m_closeTime.store(0);
+    m_next = 0;
+    m_pressure.store(false);
+    m_decimateCounter = 0;
+    m_framesDecimated.store(0);
+    m_pressureEvents.store(0);
+    m_open.store(true);
+
+    Notify(kExportStart, 0);
+    return SC_OK;
+}
+
+ErrorCode StripedRecorder::Close()
+{
+    if (!m_open.exchange(false)) return SC_OK;
+
+    // ȴڽеPush˳
+    while (m_pushing.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    bool ok = true;
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        if (m_stripes[i].Close() != SC_OK) ok = false;
+    }
+    m_closeTime.store(SteadyMicroseconds());
+
+    int written = 0;
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        written += m_written[i].load();
+    }
+
+    if (ok) Notify(kExportFinish, written);
+    Notify(kExportClose, ok ? written : kExportFailed);
+    return ok ? SC_OK : SC_ERROR;
+}
+
+bool StripedRecorder::Push(const ImageData& image)
+{
+    m_pushing.fetch_add(1);
+
+    bool accepted = false;
+    if (m_open.load())
+    {
+        // ѹԽֵʱѹ״̬䵽ֵһʱ˳ͻأֵϱ
+        unsigned int percent = GetQueuePercent();
+        bool pressure = m_pressure.load();
+        if (!pressure && percent >= m_spill.thresholdPercent)
+        {
+            pressure = true;
+            m_pressure.store(true);
+            m_pressureEvents.fetch_add(1);
+            if (m_spill.notify) Notify(kExportPressureHigh, static_cast<int>(percent));
+        }
+        else if (pressure && percent < m_spill.thresholdPercent / 2)
+        {
+            pressure = false;
+            m_pressure.store(false);
+            if (m_spill.notify) Notify(kExportPressureNormal, static_cast<int>(percent));
+        }
+
+        if (pressure && m_spill.policy == RecordSpill_Decimate && ++m_decimateCounter >= m_spill.decimation)
+        {
+            m_decimateCounter = 0;
+            m_framesDecimated.fetch_add(1);
+        }
+        else
+        {
+            // תλÿʼѡѹٵ
+            unsigned int best = m_next;
+            if (m_stripeCount > 1)
+            {
+                unsigned long long bestDepth = m_stripes[best].GetQueueDepth();
+                for (unsigned int k = 1; k < m_stripeCount && bestDepth > 0; k++)
+                {
+                    unsigned int i = (m_next + k) % m_stripeCount;
+                    unsigned long long depth = m_stripes[i].GetQueueDepth();
+                    if (depth < bestDepth)
+                    {
+                        best = i;
+                        bestDepth = depth;
+                    }
+                }
+                m_next = (best + 1) % m_stripeCount;
+            }
+
+            accepted = m_stripes[best].Push(image);
+        }
+    }
+
+    m_pushing.fetch_sub(1);
+    return accepted;
+}
+
+unsigned long long StripedRecorder::GetFramesReceived() const
+{
+    unsigned long long frames = 0;
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        frames += m_stripes[i].GetFramesReceived();
+    }
+    return frames;
+}
+
+unsigned long long StripedRecorder::GetFramesDropped() const
+{
+    unsigned long long frames = m_framesDecimated.load();
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        frames += m_stripes[i].GetFramesDropped();
+    }
+    return frames;
+}
+
+void StripedRecorder::SetSpillPolicy(const RecordSpillParam& param)
+{
+    m_spill = param;
+}
+
+void StripedRecorder::SetCheckpoint(unsigned int frameInterval, unsigned int milliseconds)
+{
+    m_checkpointFrameInterval = frameInterval;
+    m_checkpointMilliseconds = milliseconds;
+}
+
+/// <summary>
+/// ϼƵĻѹٷֱȣδдֽ / 
+/// </summary>
+unsigned int StripedRecorder::GetQueuePercent() const
+{
+    unsigned long long queued = 0;
+    unsigned long long capacity = 0;
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        queued += m_stripes[i].GetQueuedBytes();
+        capacity += m_stripes[i].GetCapacityBytes();
+    }
+    return capacity > 0 ? static_cast<unsigned int>(queued * 100 / capacity) : 0;
+}
+
+void StripedRecorder::GetStats(RecordStats* pStats) const
+{
+    memset(pStats, 0, sizeof(RecordStats));
+
+    unsigned int stripeCount = m_stripeCount;
+    unsigned long long latencyBins[kWriteLatencyBins] = {};
+    for (unsigned int i = 0; i < stripeCount; i++)
+    {
+        unsigned int busyPercent = 0;
+        m_stripes[i].AccumulateStats(pStats, latencyBins, &busyPercent);
+        if (busyPercent > pStats->diskBusyPercent) pStats->diskBusyPercent = busyPercent;
+    }
+
+    pStats->stripeCount = stripeCount;
+    pStats->framesDecimated = m_framesDecimated.load();
+    pStats->framesDropped += pStats->framesDecimated;
+    pStats->pressureEvents = m_pressureEvents.load();
+    pStats->pressure = m_open.load() && m_pressure.load() ? 1 : 0;
+    if (pStats->capacityBytes > 0)
+    {
+        pStats->queuePercent = static_cast<unsigned int>(pStats->queuedBytes * 100 / pStats->capacityBytes);
+    }
+
+    // ֽ/΢뼴MB/s1MB = 10^6ֽڣʱΪӴ򿪵һرһ
+    long long openTime = m_openTime.load();
+    long long closeTime = m_closeTime.load();
+    long long elapsed = openTime != 0 ? (closeTime != 0 ? closeTime : SteadyMicroseconds()) - openTime : 0;
+    if (stripeCount > 0 && elapsed > 0)
+    {
+        pStats->inputMBps = pStats->bytesReceived / static_cast<double>(elapsed);
+        pStats->outputMBps = pStats->bytesWritten / static_cast<double>(elapsed);
+    }
+
+    // ٷλȡϸͰϽ
+    unsigned long long total = 0;
+    for (unsigned int i = 0; i < kWriteLatencyBins; i++)
+    {
+        total += latencyBins[i];
+    }
+    if (total > 0)
+    {
+        const double kPercentiles[3] = { 0.50, 0.95, 0.99 };
+        unsigned long long* outputs[3] = { &pStats->writeLatencyP50, &pStats->writeLatencyP95, &pStats->writeLatencyP99 };
+        for (int p = 0; p < 3; p++)
+        {
+            unsigned long long rank = static_cast<unsigned long long>(kPercentiles[p] * total + 0.999999);
+            if (rank == 0) rank = 1;
+            unsigned long long seen = 0;
+            for (unsigned int i = 0; i < kWriteLatencyBins; i++)
+            {
+                seen += latencyBins[i];
+                if (seen >= rank)
+                {
+                    unsigned long long upper = LatencyBinUpper(i);
+                    *outputs[p] = upper < pStats->writeLatencyMax ? upper : pStats->writeLatencyMax;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/// <summary>
+/// ״ֻ̬֪ͨܽеĽȣʼ//رStripedRecorderͳһϱ
+/// </summary>
+void StripedRecorder::StripeNotify(int status, int progress, void* pUser)
+{
+    StripeNotifyContext* context = static_cast<StripeNotifyContext*>(pUser);
+    StripedRecorder* owner = context->owner;
+    if (status != kExportProcessing) return;
+
+    owner->m_written[context->index].store(progress);
+
+    int written = 0;
+    for (unsigned int i = 0; i < owner->m_stripeCount; i++)
+    {
+        written += owner->m_written[i].load();
+    }
+    owner->Notify(kExportProcessing, written);
+}
+
+void StripedRecorder::Notify(int status, int progress)
+{
+    std::lock_guard<std::mutex> lock(m_notifyLock);
+    if (m_notify) m_notify(status, progress, m_notifyUser);
+}
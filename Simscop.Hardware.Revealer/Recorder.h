@@ -0,0 +1,498 @@
+#pragma once
+
+#include "Revealer.h"
+#include "FrameQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+// =================================================================
+// ԭʼ¼
+// =================================================================
+
+/// <summary>
+/// ¼״̬֪ͨSDKExportNotifyȡֵһ£ͨExportEventCallBackϱ
+/// </summary>
+static const int kExportStart = 0;
+static const int kExportProcessing = 1;
+static const int kExportFinish = 2;
+static const int kExportClose = 3;
+static const int kExportPressureHigh = 4;      // ѹֵprogressΪѹٷֱȣ
+static const int kExportPressureNormal = 5;    // ѹ䵽ֵһ
+
+/// <summary>
+/// дʧʱkExportCloseϱprogress
+/// </summary>
+static const int kExportFailed = -1;
+
+/// <summary>
+/// ԭʼļ.rvrļͷ
+/// ̶4096ֽڣλļͷ¼ƽʱд֡λ
+/// 
+/// ļ֣
+/// | ļͷ(4096) | ֡0 | ֡1 | ... | ֡N-1 | (N * RawIndexEntry) |
+/// - ֡۴С̶slotSizeɵһ֡n֡λ headerSize + n * slotSize
+/// - ѹļcodec != 0֡¼ȿɱ䣨slotSizeΪ0ֻͨλ
+/// - λļĩβ֡¼blockIdʱ֡ƫ
+/// - ¼ʱһļstripeCountstripeSetIdÿļǶ.rvrȡʱblockIdϲ
+/// - ļͷÿ֡¼ͷͬsessionTagָʱݴֱ¼Ƶ֡Ԥеľ
+/// </summary>
+struct RawFileHeader
+{
+    char magic[8];              // "RVLRAW\0\0"
+    uint32_t version;           // ʽ汾
+    uint32_t headerSize;        // ļͷֽ4096
+    int32_t width;              // һ֡Ŀ
+    int32_t height;             // һ֡ĸ߶
+    int32_t stride;             // һ֡пȣֽڣ
+    int32_t pixelFormat;        // һ֡ظʽ
+    uint32_t slotSize;          // ֽ֡֡¼ͷ +  + 䣩0=ȿɱ
+    uint32_t codec;             // ֡ѹʽRawCodec
+    uint64_t frameCount;        // ֡
+    uint64_t dataBytes;         // ֽ֡ļͷ
+    uint64_t indexOffset;       // ļƫƣ0=û¼δ
+    uint64_t indexBytes;        // ֽ
+    uint32_t stripeIndex;       // ţ¼ƣ
+    uint32_t stripeCount;       // 0=¼ƣ
+    uint64_t stripeSetId;       // ʶͬһ¼Ƶͬ
+    uint32_t sessionTag;        // ¼Ƶıǣ0֡¼ͷͬ
+    uint8_t reserved[4096 - 92];
+};
+
+/// <summary>
+/// ֡¼ͷ64ֽڣλ֡ۿͷ֮ͼ
+/// </summary>
+struct RawFrameHeader
+{
+    uint32_t magic;             // kRawFrameMagic
+    uint32_t headerSize;        // ֡¼ͷֽ64
+    uint64_t blockId;           // ֡ID
+    uint64_t timeStamp;         // ʱ
+    uint32_t dataSize;          // ͼֽѹʱΪѹֽ
+    uint32_t recordSize;        // ֽ֡
+    int32_t width;
+    int32_t height;
+    int32_t stride;             // пȣѹʱΪѹĽпȣ
+    int32_t pixelFormat;
+    uint32_t storedSize;        // ֡¼ͷ֮ʵʱֽ
+    uint32_t sessionTag;        // ļͷͬ
+    uint8_t reserved[8];
+};
+
+/// <summary>
+/// ļĩβÿ֡һ
+/// </summary>
+struct RawIndexEntry
+{
+    uint64_t blockId;           // ֡ID
+    uint64_t timeStamp;         // ʱ
+    uint64_t offset;            // ֡۵ļƫ
+};
+
+/// <summary>
+/// ¼ͷ32ֽڣλڼļ¼ļ· + kRecordJournalSuffix
+/// 
+/// ļֻ׷ӣ| ¼ͷ | (entryCount * RawIndexEntry) | ¼ͷ | ... |
+/// - д߳ÿдһ黺֡/ʱжϣˢ¼ļ׷Ӳˢ¼
+/// - ¼ǽdataEndȫд֡һ¼ָܲʱУͶ
+/// - رպɾļ
+/// </summary>
+struct RawCheckpointHeader
+{
+    uint32_t magic;             // kRawCheckpointMagic
+    uint32_t entryCount;        // ¼
+    uint64_t frameCount;        // ¼֡
+    uint64_t dataEnd;           // ¼һ֡Ľƫƣļƫƣ
+    uint32_t sessionTag;        // ¼ļͷͬ
+    uint32_t checksum;          // ¼ͷֶΪ0CRC-32
+};
+
+static_assert(sizeof(RawFileHeader) == 4096, "RawFileHeader must be 4096 bytes");
+static_assert(sizeof(RawFrameHeader) == 64, "RawFrameHeader must be 64 bytes");
+static_assert(sizeof(RawIndexEntry) == 24, "RawIndexEntry must be 24 bytes");
+static_assert(sizeof(RawCheckpointHeader) == 32, "RawCheckpointHeader must be 32 bytes");
+
+/// <summary>
+/// ֡ѹʽ
+/// </summary>
+enum RawCodec
+{
+    RawCodec_None = 0,          // ѹ̶ۣ֡ط㿽
+    RawCodec_Lz4 = 1,           // Ԥ + ֽڷ + LZ4FrameCodec
+};
+
+static const char kRawFileMagic[8] = { 'R', 'V', 'L', 'R', 'A', 'W', 0, 0 };
+static const uint32_t kRawFileVersion = 2;
+static const uint32_t kRawFrameMagic = 0x48465652;     // "RVFH"
+static const uint32_t kRawCheckpointMagic = 0x50435652; // "RVCP"
+
+/// <summary>
+/// ļĺ׺׷¼ļ·֮
+/// </summary>
+static const char kRecordJournalSuffix[] = ".idx";
+
+/// <summary>
+/// д̻ڴ㣩
+/// </summary>
+static const unsigned int kRecordChunkCount = 2;
+
+/// <summary>
+/// ÿ¼ڴÿд̻ͬ64MB
+/// </summary>
+static const unsigned int kMaxSpillChunks = 256;
+
+/// <summary>
+/// д̺ʱϸֱͼͰÿ2Ϊ4Ͱڼٷλ
+/// </summary>
+static const unsigned int kWriteLatencyBins = 24 * 4;
+
+/// <summary>
+/// ¼״̬֪ͨص
+/// </summary>
+typedef void (*RecorderNotify)(int status, int progress, void* pUser);
+
+/// <summary>
+/// ¼ÿ64K1.5MB
+/// </summary>
+static const size_t kRecordIndexBlockEntries = 64 * 1024;
+
+/// <summary>
+/// ¼Լ2.7֡
+/// </summary>
+static const size_t kRecordIndexMaxBlocks = 4096;
+
+/// <summary>
+/// ¼
+/// ̶СĿ׷ӣĿ¼ڹʱһη䣺׷ʱֻڿʱ¿飬ƶе
+/// ߳Լɼ߳׷ӣֻ߳ȡѷͨԭӼ
+/// </summary>
+class RecordIndex
+{
+public:
+    RecordIndex();
+    ~RecordIndex();
+
+    RecordIndex(const RecordIndex&) = delete;
+    RecordIndex& operator=(const RecordIndex&) = delete;
+
+    /// <summary>׷һﵽ޻ڴ治ʱfalse</summary>
+    bool Push(const RawIndexEntry& entry);
+
+    /// <summary>indexͬһڵĺţβΪֹ</summary>
+    const RawIndexEntry* At(size_t index) const
+    {
+        return m_blocks[index / kRecordIndexBlockEntries] + index % kRecordIndexBlockEntries;
+    }
+
+    /// <summary>[first, first + count)</summary>
+    void CopyTo(size_t first, size_t count, RawIndexEntry* dst) const;
+
+    size_t Size() const { return m_size; }
+
+    /// <summary>ղͷп</summary>
+    void Clear();
+
+private:
+    std::vector<RawIndexEntry*> m_blocks;   // kRecordIndexMaxBlocksδĿΪnullptr
+    size_t m_size;
+};
+
+/// <summary>
+/// ԭʼ¼
+/// ;ɼ߳̽֡д黺д߳޻I/O˳д̣SDKĵ
+/// 
+/// ƣ
+/// - 64MBʹãɼ߳һʱд߳дһ
+/// - ׷ڴ㣨SetSpillChunksչΪ飬ʱʱ֡Ŀ飬˳д̣⸴
+/// - ļFILE_FLAG_NO_BUFFERING򿪣дСƫƶ4096ֽڶ룬ռϵͳļ
+/// - ļ1GBԤ䣨"ִоά"ȨʱͬʱЧݳȣرʱضϵʵʴС
+/// - п鶼ڵȴдʱ̸ϣ֡ɼ̲߳
+/// - ͳƣ/дֽѹֵÿд̵ĺʱֱͼԭӼȡʱ
+/// - ֡۴Сɵһ֡ݸ֡¼;ROI
+/// - ڴаۻRecordIndex׷Ӳƶеرʱ׷ӵļĩβ
+/// - 㣨SetCheckpointд̶߳ˢļд֡׷ӵļ
+///   쳣˳RecoverRecordingָдֻ߳ȡд֡ɼ߳׷Ӳ
+/// - ʱļд֮ҲᶨʱУд̰߳Ŀ֡дļеλ
+///   ֻдϴ֮㣬ƫƲǰдʱд
+///   ֡ʵ͡һ鳤ʱдʱҲʱ̣û֡ʱдд̰߳ȴ
+/// - ѹģʽɼֻ߳֡ƵѹУѹ̳߳߳Ϸֿѹд뻺
+///   ʱ֡ѹ̵߳ȴж֡
+/// 
+/// ߳Լ
+/// - Pushֻһ̣߳ɼ̣߳
+/// - Open/Closeɿ̵߳
+/// </summary>
+class Recorder
+{
+public:
+    Recorder();
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /// <summary>ļд߳</summary>
+    /// <param name="codec">֡ѹʽRawCodec</param>
+    ErrorCode Open(const char* path, RecorderNotify notify, void* pUser, int codec = RawCodec_None);
+
+    /// <summary>дʣݡдļͷرļ</summary>
+    ErrorCode Close();
+
+    bool IsOpen() const { return m_open.load(); }
+
+    /// <summary>
+    /// дһ֡Ƶѹкأ
+    /// </summary>
+    /// <param name="wait">true=ʱȴд̶ʵʱߣѹʱЧ</param>
+    /// <returns>true=ѽգfalse=</returns>
+    bool Push(const ImageData& image, bool wait = false);
+
+    unsigned long long GetFramesReceived() const { return m_framesReceived.load(); }
+    unsigned long long GetFramesDropped() const { return m_framesDropped.load(); }
+
+    /// <summary>ѽյδд̵֡ѹе֡</summary>
+    unsigned long long GetQueueDepth() const;
+
+    /// <summary>ϢдļͷOpen֮ǰã</summary>
+    void SetStripe(unsigned int stripeIndex, unsigned int stripeCount, unsigned long long stripeSetId);
+
+    /// <summary>ڴOpen֮ǰãOpenʱһԷ䣩Χ[0, kMaxSpillChunks]</summary>
+    void SetSpillChunks(unsigned int count);
+
+    /// <summary>Open֮ǰã߶Ϊ0ʾд</summary>
+    /// <param name="frameInterval">һд֡ﵽֵʱд㣨0=֡</param>
+    /// <param name="milliseconds">һʱﵽֵʱд㣨0=ʱ䣩</param>
+    void SetCheckpoint(unsigned int frameInterval, unsigned int milliseconds);
+
+    /// <summary>ѽδд̵ֽ</summary>
+    unsigned long long GetQueuedBytes() const;
+
+    /// <summary>д̻ + ڴ㣬Open֮Ч</summary>
+    unsigned long long GetCapacityBytes() const { return m_capacityBytes.load(); }
+
+    /// <summary>
+    /// ѱ¼ͳۼӵpStatsٷֱȺͰٷλ
+    /// </summary>
+    /// <param name="pLatencyBins">ۼϸֵд̺ʱֱͼkWriteLatencyBins</param>
+    /// <param name="pBusyPercent">д̺ʱռ¼ʱİٷֱ</param>
+    void AccumulateStats(RecordStats* pStats, unsigned long long* pLatencyBins, unsigned int* pBusyPercent) const;
+
+    /// <summary>¼Ƶʱ΢룬رպΪ򿪵رյʱδʱΪ0</summary>
+    long long GetElapsedMicroseconds() const;
+
+private:
+    enum ChunkState
+    {
+        ChunkState_Free = 0,    // 
+        ChunkState_Filling,     // ɼ߳
+        ChunkState_Ready,       // ȴд
+    };
+
+    struct Chunk
+    {
+        unsigned char* data;
+        size_t used;                    // ֽ
+        unsigned int framesEnded;       // ڱڽ֡
+        unsigned long long framesEnd;   // ֡ĽƫƣļƫƣframesEndedΪ0ʱЧ
+        std::atomic<unsigned long long> committed;  // ׷ӵ֡32λΪframesEnded32λΪusedд̶߳ʱȡ
+        std::atomic<int> state;
+
+        Chunk() : data(nullptr), used(0), framesEnded(0), framesEnd(0), committed(0), state(ChunkState_Free) {}
+    };
+
+    void WriterProc();
+    void CompressorProc();
+    bool AppendFrame(const ImageData& image, const void* payload, size_t payloadSize, bool wait);
+    bool WriteChunk(Chunk& chunk, size_t bytes);
+    bool EnsureAllocated(unsigned long long end);
+    void SubmitChunk(int index);
+    void Append(const void* p, size_t size);
+    void WaitChunkFree(int index);
+    void Notify(int status, int progress);
+    bool WriteHeader();
+    void WriteCheckpoint();
+    void WriteFillingCheckpoint(Chunk& chunk);
+    bool IsCheckpointDue(unsigned long long frames, long long now) const;
+    void CommitCheckpoint(unsigned long long frames, unsigned long long dataEnd, long long now);
+    void ReleaseResources();
+
+    void* m_file;                       // HANDLE
+    RecorderNotify m_notify;
+    void* m_notifyUser;
+
+    Chunk m_chunks[kRecordChunkCount + kMaxSpillChunks];
+    int m_chunkCount;                   // д̻ + ڴ㣩
+    unsigned int m_spillChunks;         // ڴOpen֮ǰã
+    int m_fillIndex;                    // ɼ߳Ŀ
+    int m_writeIndex;                   // д߳һҪдĿ
+
+    unsigned long long m_fileOffset;    // һд̵ļƫƣд̣߳
+    unsigned long long m_allocated;     // ԤļСд̣߳
+    unsigned long long m_dataBytes;     // ѽյֽ֡ɼ̣߳
+    size_t m_slotSize;                  // ֡۴Сһ֡ȷ0=δȷ
+    RecordIndex m_index;                // ѽ֡ɼ߳׷ӣ
+    bool m_canSetValidData;
+
+    RawFileHeader* m_header;            // ļͷ4096ֽڶ뻺
+
+    int m_codec;                        // RawCodec
+    unsigned int m_stripeIndex;
+    unsigned int m_stripeCount;         // 0=¼
+    unsigned long long m_stripeSetId;
+    uint32_t m_sessionTag;
+
+    // 㣨д̣߳
+    void* m_journal;                    // HANDLEINVALID_HANDLE_VALUE=д
+    std::string m_journalPath;
+    unsigned int m_checkpointFrameInterval;
+    unsigned int m_checkpointMilliseconds;
+    unsigned long long m_checkpointFrames;  // д֡
+    unsigned long long m_framesEnd;         // д֡Ľƫ
+    long long m_checkpointTime;             // һʱ䣨steady_clock΢룩
+    size_t m_fillingFlushed;                // λm_fileOffsetĿɶʱдֽ
+    std::vector<unsigned char> m_checkpointBuffer;
+    unsigned char* m_checkpointSector;      // ʱдδĻ룩
+
+    FrameQueue m_compressQueue;         // ɼ߳  ѹ߳
+    std::thread m_compressor;
+    std::atomic<bool> m_compressFinishing;  // ֹͣѹк˳
+    std::vector<unsigned char> m_compressed;    // ѹѹ̣߳
+
+    std::thread m_writer;
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+    bool m_finishing;                   // βдʣ˳m_lock
+
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_failed;
+    std::atomic<int> m_pushing;
+    std::atomic<unsigned long long> m_framesReceived;
+    std::atomic<unsigned long long> m_framesDropped;
+    std::atomic<unsigned long long> m_framesWritten;
+
+    // ͳ
+    std::atomic<unsigned long long> m_framesSpilled;
+    std::atomic<unsigned long long> m_bytesReceived;    // ѽ뻺ֽļͷ
+    std::atomic<unsigned long long> m_bytesWritten;     // д̵ֽ䣩
+    std::atomic<unsigned long long> m_peakQueuedBytes;
+    std::atomic<unsigned long long> m_capacityBytes;    // Openʱã
+    std::atomic<unsigned long long> m_writeMicroseconds;    // д̺ʱ֮
+    std::atomic<unsigned long long> m_writeLatencyMax;
+    std::atomic<unsigned long long> m_writeLatency[kWriteLatencyBins];
+    std::atomic<long long> m_openTime;                  // ʱ䣨steady_clock΢룩
+    std::atomic<long long> m_closeTime;                 // رʱ䣨0=¼ƣ
+};
+
+/// <summary>
+/// ָ쳣¼ļΪ0.rvr
+/// Ӽļȡȷϵٴһ֮ɨ֡¼ͷ
+/// һЧ֮֡׷дļͷде֡
+/// </summary>
+/// <param name="path">¼ļ·</param>
+/// <param name="pFrameCount">ָ֡Ϊnullptr</param>
+/// <returns>SC_OKʾѻָļSC_INVALID_RESOURCEʾǱ¼Ƶļļͷδд</returns>
+ErrorCode RecoverRecording(const char* path, unsigned long long* pFrameCount);
+
+/// <summary>
+/// ¼ƵĿ¼
+/// </summary>
+static const unsigned int kMaxRecordStripes = 8;
+
+/// <summary>
+/// ¼ƵĿ¼/ļ·бķָ
+/// '|'ܳWindowsļУ';'ǺϷļַָ
+/// </summary>
+static const char kRecordPathSeparator = '|';
+
+/// <summary>
+/// Ĭϻѹʱֵ֡80%ϱ
+/// </summary>
+static const RecordSpillParam kDefaultRecordSpill = { RecordSpill_Drop, 80, 0, 2, 0 };
+
+/// <summary>
+/// ¼
+/// ;ַ֡ϵԭʼļÿһRecorderԵд̺߳ϼƴԼΪ֮
+///
+/// ˵
+/// - ÿ֡תλÿʼѡѹ֡ٵѹͬʱתĳ̱ʱԶٷָ
+/// - ļЧļͷ¼šʶRecordingReaderblockIdϲ
+/// - ֻһʱRecorderͬ
+/// - ״̬ϱʼ//رոһΣеprogressΪд̵֮֡
+/// - ÿռд̻128MBлѹԸڴ
+/// - ѹSetSpillPolicyϼƵĻѹٷֱжϣԽֵʱϱ
+///   RecordSpill_Decimateڻѹ֮ǰÿdecimation֡1֡
+/// - ߳ԼRecorderͬ
+/// </summary>
+class StripedRecorder
+{
+public:
+    StripedRecorder();
+    ~StripedRecorder();
+
+    StripedRecorder(const StripedRecorder&) = delete;
+    StripedRecorder& operator=(const StripedRecorder&) = delete;
+
+    /// <summary>ļ</summary>
+    /// <param name="paths">ļ·</param>
+    /// <param name="count">Χ[1, kMaxRecordStripes]</param>
+    ErrorCode Open(const char* const* paths, unsigned int count, RecorderNotify notify, void* pUser,
+        int codec = RawCodec_None);
+
+    /// <summary>رһʧʱʧ</summary>
+    ErrorCode Close();
+
+    /// <summary>ûѹԣOpen֮ǰã</summary>
+    void SetSpillPolicy(const RecordSpillParam& param);
+
+    /// <summary>øOpen֮ǰã</summary>
+    void SetCheckpoint(unsigned int frameInterval, unsigned int milliseconds);
+
+    /// <summary>ȡͳƣ¼ƽһ¼Ƶͳƣ</summary>
+    void GetStats(RecordStats* pStats) const;
+
+    bool IsOpen() const { return m_open.load(); }
+
+    /// <returns>true=ѽգfalse=</returns>
+    bool Push(const ImageData& image);
+
+    unsigned long long GetFramesReceived() const;
+    unsigned long long GetFramesDropped() const;
+
+private:
+    struct StripeNotifyContext
+    {
+        StripedRecorder* owner;
+        unsigned int index;
+    };
+
+    static void StripeNotify(int status, int progress, void* pUser);
+    void Notify(int status, int progress);
+    unsigned int GetQueuePercent() const;
+
+    Recorder m_stripes[kMaxRecordStripes];
+    StripeNotifyContext m_notifyContexts[kMaxRecordStripes];
+    std::atomic<int> m_written[kMaxRecordStripes];  // д̵֡
+    std::atomic<unsigned int> m_stripeCount;    // رպͳƣ
+    unsigned int m_next;                // תλãɼ̣߳
+
+    RecorderNotify m_notify;
+    void* m_notifyUser;
+    std::mutex m_notifyLock;            // д̲߳ϱ
+
+    RecordSpillParam m_spill;           // ѹOpen֮ǰã
+    unsigned int m_checkpointFrameInterval;
+    unsigned int m_checkpointMilliseconds;
+    std::atomic<bool> m_pressure;       // ѹֵδ䣨ɼ߳д
+    unsigned int m_decimateCounter;     // ϡ趪ɼ̣߳
+    std::atomic<unsigned long long> m_framesDecimated;
+    std::atomic<unsigned long long> m_pressureEvents;
+    std::atomic<long long> m_openTime;          // Ĵʱ䣨steady_clock΢룩
+    std::atomic<long long> m_closeTime;         // رյʱ䣨0=¼ƣ
+
+    std::atomic<bool> m_open;
+    std::atomic<int> m_pushing;
+};
@@ -0,0 +1,307 @@
+#include "RecordingReader.h"
+#include "FrameCodec.h"
+#include "ImageKernels.h"
+#include <SCDefines.h>
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <string.h>
+
+RecordingReader::RecordingReader()
+    : m_stripeCount(0), m_frameCount(0), m_sortedByBlockId(false)
+{
+    for (unsigned int i = 0; i < kMaxRecordStripes; i++)
+    {
+        StripeFile& stripe = m_stripes[i];
+        stripe.file = INVALID_HANDLE_VALUE;
+        stripe.mapping = nullptr;
+        stripe.base = nullptr;
+        stripe.fileSize = 0;
+        stripe.header = nullptr;
+        stripe.index = nullptr;
+    }
+}
+
+RecordingReader::~RecordingReader()
+{
+    Close();
+}
+
+ErrorCode RecordingReader::Open(const char* path)
+{
+    if (!path || !path[0]) return SC_INVALID_PARAM;
+    if (m_stripeCount > 0) return SC_BUSY;
+
+    // ļ·
+    std::vector<std::string> paths;
+    const char* begin = path;
+    for (;;)
+    {
+        const char* end = strchr(begin, kRecordPathSeparator);
+        size_t length = end ? static_cast<size_t>(end - begin) : strlen(begin);
+        if (length > 0) paths.push_back(std::string(begin, length));
+        if (!end) break;
+        begin = end + 1;
+    }
+    if (paths.empty() || paths.size() > kMaxRecordStripes) return SC_INVALID_PARAM;
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        int ret = OpenStripe(m_stripes[i], paths[i].c_str());
+        m_stripeCount = static_cast<unsigned int>(i + 1);
+        if (ret != SC_OK)
+        {
+            Close();
+            return ret;
+        }
+    }
+
+    if (m_stripeCount > 1)
+    {
+        // ͬһȫ
+        const RawFileHeader* first = m_stripes[0].header;
+        unsigned int seen = 0;
+        bool valid = first->stripeCount == m_stripeCount;
+        for (unsigned int i = 0; i < m_stripeCount && valid; i++)
+        {
+            const RawFileHeader* header = m_stripes[i].header;
+            valid = header->stripeCount == m_stripeCount && header->stripeSetId == first->stripeSetId &&
+                header->stripeIndex < m_stripeCount && !(seen & (1u << header->stripeIndex));
+            seen |= 1u << header->stripeIndex;
+        }
+        if (!valid)
+        {
+            Close();
+            return SC_INVALID_RESOURCE;
+        }
+
+        MergeStripes();
+        m_frameCount = m_order.size();
+    }
+    else
+    {
+        m_frameCount = m_stripes[0].header->frameCount;
+    }
+
+    m_sortedByBlockId = true;
+    for (unsigned long long i = 1; i < m_frameCount; i++)
+    {
+        if (GetEntry(i).blockId <= GetEntry(i - 1).blockId)
+        {
+            m_sortedByBlockId = false;
+            break;
+        }
+    }
+
+    return SC_OK;
+}
+
+/// <summary>
+/// ӳһ.rvrļУļͷΧ
+/// </summary>
+ErrorCode RecordingReader::OpenStripe(StripeFile& stripe, const char* path)
+{
+    stripe.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (stripe.file == INVALID_HANDLE_VALUE) return SC_ERROR;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(stripe.file, &size) || size.QuadPart < static_cast<long long>(sizeof(RawFileHeader)) ||
+        static_cast<unsigned long long>(size.QuadPart) > static_cast<unsigned long long>(SIZE_MAX))
+    {
+        return SC_INVALID_RESOURCE;
+    }
+    stripe.fileSize = static_cast<unsigned long long>(size.QuadPart);
+
+    stripe.mapping = CreateFileMappingA(stripe.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (stripe.mapping)
+    {
+        stripe.base = static_cast<const unsigned char*>(MapViewOfFile(stripe.mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!stripe.base) return SC_NO_MEMORY;
+
+    // УļͷΧΪ0ʾ¼δ
+    const RawFileHeader* header = reinterpret_cast<const RawFileHeader*>(stripe.base);
+    // ѹļ֡¼ȿɱ䣬У֡۴С
+    bool fixedSlots = header->codec == RawCodec_None;
+    bool valid = memcmp(header->magic, kRawFileMagic, sizeof(kRawFileMagic)) == 0 &&
+        header->version == kRawFileVersion &&
+        header->headerSize == sizeof(RawFileHeader) &&
+        (header->codec == RawCodec_None || header->codec == RawCodec_Lz4) &&
+        header->indexOffset != 0 &&
+        header->frameCount <= stripe.fileSize / sizeof(RawIndexEntry) &&
+        (!fixedSlots || header->frameCount == 0 ||
+            (header->slotSize >= sizeof(RawFrameHeader) && header->frameCount <= stripe.fileSize / header->slotSize)) &&
+        header->indexBytes == header->frameCount * sizeof(RawIndexEntry) &&
+        (!fixedSlots || header->dataBytes == header->frameCount * header->slotSize) &&
+        header->indexOffset == header->headerSize + header->dataBytes &&
+        header->indexOffset + header->indexBytes <= stripe.fileSize;
+    if (!valid) return SC_INVALID_RESOURCE;
+
+    stripe.header = header;
+    stripe.index = reinterpret_cast<const RawIndexEntry*>(stripe.base + header->indexOffset);
+    return SC_OK;
+}
+
+void RecordingReader::CloseStripe(StripeFile& stripe)
+{
+    if (stripe.base) UnmapViewOfFile(stripe.base);
+    if (stripe.mapping) CloseHandle(stripe.mapping);
+    if (stripe.file != INVALID_HANDLE_VALUE) CloseHandle(stripe.file);
+
+    stripe.file = INVALID_HANDLE_VALUE;
+    stripe.mapping = nullptr;
+    stripe.base = nullptr;
+    stripe.fileSize = 0;
+    stripe.header = nullptr;
+    stripe.index = nullptr;
+}
+
+/// <summary>
+/// blockId·鲢ÿڱԭ˳
+/// </summary>
+void RecordingReader::MergeStripes()
+{
+    unsigned long long total = 0;
+    unsigned long long position[kMaxRecordStripes] = {};
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        total += m_stripes[i].header->frameCount;
+    }
+
+    m_order.clear();
+    m_order.reserve(static_cast<size_t>(total));
+    for (unsigned long long n = 0; n < total; n++)
+    {
+        unsigned int best = kMaxRecordStripes;
+        for (unsigned int i = 0; i < m_stripeCount; i++)
+        {
+            if (position[i] == m_stripes[i].header->frameCount) continue;
+            if (best == kMaxRecordStripes ||
+                m_stripes[i].index[position[i]].blockId < m_stripes[best].index[position[best]].blockId)
+            {
+                best = i;
+            }
+        }
+
+        FrameRef frame;
+        frame.entry = &m_stripes[best].index[position[best]++];
+        frame.stripe = best;
+        m_order.push_back(frame);
+    }
+}
+
+const RawIndexEntry& RecordingReader::GetEntry(unsigned long long frameIndex) const
+{
+    return m_order.empty() ? m_stripes[0].index[frameIndex] : *m_order[static_cast<size_t>(frameIndex)].entry;
+}
+
+void RecordingReader::Close()
+{
+    for (unsigned int i = 0; i < m_stripeCount; i++)
+    {
+        CloseStripe(m_stripes[i]);
+    }
+    m_stripeCount = 0;
+    std::vector<FrameRef>().swap(m_order);
+    m_frameCount = 0;
+}
+
+void RecordingReader::GetInfo(RecordingInfo* pInfo) const
+{
+    memset(pInfo, 0, sizeof(RecordingInfo));
+    if (m_stripeCount == 0) return;
+
+    // ߴظʽȡһ֡ڵļ
+    const RawFileHeader* header = m_stripes[m_order.empty() ? 0 : m_order[0].stripe].header;
+    pInfo->width = header->width;
+    pInfo->height = header->height;
+    pInfo->stride = header->stride;
+    pInfo->pixelFormat = header->pixelFormat;
+    pInfo->frameCount = m_frameCount;
+    if (m_frameCount > 0)
+    {
+        pInfo->firstBlockId = GetEntry(0).blockId;
+        pInfo->lastBlockId = GetEntry(m_frameCount - 1).blockId;
+        pInfo->firstTimeStamp = GetEntry(0).timeStamp;
+        pInfo->lastTimeStamp = GetEntry(m_frameCount - 1).timeStamp;
+    }
+}
+
+ErrorCode RecordingReader::ReadFrame(unsigned long long frameIndex, ImageData* pImage) const
+{
+    if (frameIndex >= m_frameCount) return SC_INVALID_PARAM;
+
+    const StripeFile& stripe = m_stripes[m_order.empty() ? 0 : m_order[static_cast<size_t>(frameIndex)].stripe];
+    const RawFileHeader* header = stripe.header;
+    unsigned long long offset = GetEntry(frameIndex).offset;
+    if (offset < header->headerSize || offset + sizeof(RawFrameHeader) > header->indexOffset)
+        return SC_INVALID_RESOURCE;
+
+    const RawFrameHeader* frame = reinterpret_cast<const RawFrameHeader*>(stripe.base + offset);
+    if (frame->magic != kRawFrameMagic || offset + frame->recordSize > header->indexOffset ||
+        sizeof(RawFrameHeader) + frame->storedSize > frame->recordSize)
+        return SC_INVALID_RESOURCE;
+
+    const unsigned char* data = stripe.base + offset + sizeof(RawFrameHeader);
+    if (header->codec != RawCodec_None)
+    {
+        // ѹ֡ѹ̵߳Ļ
+        static thread_local std::vector<unsigned char> t_frame;
+        int pixelBytes = GetPixelBytes(frame->pixelFormat);
+        if (pixelBytes == 0 || frame->width <= 0 || frame->height <= 0 ||
+            frame->dataSize != static_cast<uint32_t>(frame->width) * pixelBytes * frame->height)
+            return SC_INVALID_RESOURCE;
+
+        if (t_frame.size() < frame->dataSize) t_frame.resize(frame->dataSize);
+        if (!DecompressFrame(data, frame->storedSize, frame->width, frame->height, pixelBytes, t_frame.data()))
+            return SC_INVALID_RESOURCE;
+        data = t_frame.data();
+    }
+    else if (frame->storedSize != frame->dataSize)
+    {
+        return SC_INVALID_RESOURCE;
+    }
+
+    pImage->width = frame->width;
+    pImage->height = frame->height;
+    pImage->stride = frame->stride;
+    pImage->pixelFormat = frame->pixelFormat;
+    pImage->pData = const_cast<unsigned char*>(data);
+    pImage->dataSize = static_cast<int>(frame->dataSize);
+    pImage->blockId = frame->blockId;
+    pImage->timeStamp = frame->timeStamp;
+    return SC_OK;
+}
+
+ErrorCode RecordingReader::FindFrame(unsigned long long blockId, unsigned long long* pFrameIndex) const
+{
+    if (m_sortedByBlockId)
+    {
+        unsigned long long lo = 0;
+        unsigned long long hi = m_frameCount;
+        while (lo < hi)
+        {
+            unsigned long long mid = lo + (hi - lo) / 2;
+            if (GetEntry(mid).blockId < blockId) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo < m_frameCount && GetEntry(lo).blockId == blockId)
+        {
+            *pFrameIndex = lo;
+            return SC_OK;
+        }
+        return SC_INVALID_PARAM;
+    }
+
+    // ֡ID
+    for (unsigned long long i = 0; i < m_frameCount; i++)
+    {
+        if (GetEntry(i).blockId == blockId)
+        {
+            *pFrameIndex = i;
+            return SC_OK;
+        }
+    }
+    return SC_INVALID_PARAM;
+}
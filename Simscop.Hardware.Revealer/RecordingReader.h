@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Revealer.h"
+#include "Recorder.h"
+#include <vector>
+
+// =================================================================
+// ¼ļȡ
+// =================================================================
+
+/// <summary>
+/// ԭʼļ.rvrȡ
+/// ;ӳļ֡O(1)λָۣ֡ͨӳڴImageData㿽
+/// 
+/// ˵
+/// - ֡ϵͳҳ룬˳طʱϵͳԤٶڴ
+/// - صpDataClose֮ǰһֱЧͬʱ֡
+/// - ѹļ֡ѹ̵߳ĻpDataڸ߳һReadFrameǰЧ
+/// - ֻ߳̿ͬʱReadFrame/FindFrame
+/// - ļӳ䵽ַռ䣬32λֻܴСԼ1GBļ
+/// - ¼Ƶһļ·'|'ָһ򿪣blockIdϲΪһ֡
+/// </summary>
+class RecordingReader
+{
+public:
+    RecordingReader();
+    ~RecordingReader();
+
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+
+    /// <summary>򿪲УļļͷļСһ£</summary>
+    /// <param name="path">ļ·Ϊ'|'ָȫļ·</param>
+    ErrorCode Open(const char* path);
+
+    void Close();
+
+    /// <summary>ȡ¼Ϣ</summary>
+    void GetInfo(RecordingInfo* pInfo) const;
+
+    /// <summary>ȡframeIndex֡pDataָӳڴ棩</summary>
+    ErrorCode ReadFrame(unsigned long long frameIndex, ImageData* pImage) const;
+
+    /// <summary>֡ID֡</summary>
+    ErrorCode FindFrame(unsigned long long blockId, unsigned long long* pFrameIndex) const;
+
+private:
+    /// <summary>
+    /// һӳ.rvrļ
+    /// </summary>
+    struct StripeFile
+    {
+        void* file;                     // HANDLE
+        void* mapping;                  // HANDLE
+        const unsigned char* base;      // ӳʼַ
+        unsigned long long fileSize;
+        const RawFileHeader* header;
+        const RawIndexEntry* index;
+    };
+
+    /// <summary>
+    /// ϲ֡飩
+    /// </summary>
+    struct FrameRef
+    {
+        const RawIndexEntry* entry;
+        unsigned int stripe;
+    };
+
+    ErrorCode OpenStripe(StripeFile& stripe, const char* path);
+    void CloseStripe(StripeFile& stripe);
+    void MergeStripes();
+    const RawIndexEntry& GetEntry(unsigned long long frameIndex) const;
+
+    StripeFile m_stripes[kMaxRecordStripes];
+    unsigned int m_stripeCount;
+    std::vector<FrameRef> m_order;      // 鰴blockIdϲ֡򣨵ļʱΪգֱʹ
+    unsigned long long m_frameCount;
+    bool m_sortedByBlockId;             // ֡blockIdɶֲң
+};
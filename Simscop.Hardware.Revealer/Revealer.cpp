@@ -1,8 +1,29 @@
 #include "Revealer.h"
+#include "FrameMemory.h"
+#include "FrameQueue.h"
+#include "FrameHistory.h"
+#include "FeatureCache.h"
+#include "HandleTable.h"
+#include "FeatureTable.h"
+#include "NodeMap.h"
+#include "Recorder.h"
+#include "BigTiffWriter.h"
+#include "RecordingReader.h"
+#include "SnapshotEncoder.h"
+#include "ImageKernels.h"
 #include <SCApi.h>
 #include <SCDefines.h>
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
 #include <string.h>
+#include <assert.h>
 
 // =================================================================
 // ȫݹ
@@ -10,19 +31,11 @@
 
 /// <summary>
 /// 豸б
-/// ;ö豸󱣴豸Ϣʹ
+/// ;ö豸󱣴豸ϢȲʹ
 /// ڣCamera_EnumDevicesʱ
 /// </summary>
 static SC_DeviceList g_deviceList = { 0 };
 
-/// <summary>
-/// ӳ
-/// CameraHandle (void*) - Ⱪ¶ľ
-/// ֵSC_DEV_HANDLE - SDKڲ
-/// ;ⲿӳ䵽SDKʵ־
-/// </summary>
-static std::map<CameraHandle, SC_DEV_HANDLE> g_handleMap;
-
 // =================================================================
 // ص
 // =================================================================
@@ -37,2041 +50,5551 @@ struct CallbackInfo
 };
 
 /// <summary>
-/// ״̬صӳ
-/// </summary>
-static std::map<CameraHandle, CallbackInfo> g_connectCallbackMap;
-
-/// <summary>
-/// »صӳ
-/// </summary>
-static std::map<CameraHandle, CallbackInfo> g_paramUpdateCallbackMap;
-
-/// <summary>
-/// ״̬صӳ
-/// </summary>
-static std::map<CameraHandle, CallbackInfo> g_exportCallbackMap;
-
-/// <summary>
-/// ֡ص
+/// ص
+/// ;һԭ滻ûصSDKص߳ȡ
+/// 滻
+/// - infoָ򲻿ɱCallbackInfoע/ȡʱ彻
+/// - inFlight¼ڶȡò۵Ļص
+/// - ȴinFlightͷžɵCallbackInfo
 /// </summary>
-static std::map<CameraHandle, CallbackInfo> g_processedFrameCallbackMap;
+struct CallbackSlot
+{
+    std::atomic<CallbackInfo*> info;
+    std::atomic<int> inFlight;
 
-// =================================================================
-// 
-// =================================================================
+    CallbackSlot() : info(nullptr), inFlight(0) {}
+};
 
 /// <summary>
-/// CameraHandleȡӦSDK
+/// ǰ߳ڷַĻص
+/// ;ûصע/ȡͬһʱȴ˳
 /// </summary>
-/// <param name="handle">ⲿ</param>
-/// <returns>ӦSDKδҵnullptr</returns>
-static SC_DEV_HANDLE GetSDKHandle(CameraHandle handle)
-{
-    auto it = g_handleMap.find(handle);
-    return (it != g_handleMap.end()) ? it->second : nullptr;
-}
-// =================================================================
-// ̬صװ
-// =================================================================
+static thread_local CallbackSlot* t_dispatchingSlot = nullptr;
 
 /// <summary>
-/// ״̬صװ
+/// صַ
+/// ;SDKص߳жȡص
+/// - ʱǼinFlightƵǰصϢ
+/// - ʱעinFlight
+/// ƳĻصϢʼЧʹ߳ͬʱȡע
 /// </summary>
-static void SC_CALL OnConnectCallback(const SC_SConnectArg* pConnectArg, void* pUser)
+struct CallbackScope
 {
-    if (!pConnectArg) return;
+    CallbackSlot& slot;
+    CallbackSlot* previous;
+    CallbackInfo info;
+    bool valid;
 
-    CameraHandle handle = reinterpret_cast<CameraHandle>(pUser);
-    auto it = g_connectCallbackMap.find(handle);
-    if (it != g_connectCallbackMap.end())
+    explicit CallbackScope(CallbackSlot& s) : slot(s), previous(t_dispatchingSlot), info(), valid(false)
     {
-        ConnectCallBack callback = reinterpret_cast<ConnectCallBack>(it->second.userCallback);
-        if (callback)
+        slot.inFlight.fetch_add(1);
+        t_dispatchingSlot = &slot;
+
+        CallbackInfo* current = slot.info.load();
+        if (current && current->userCallback)
         {
-            int isConnected = (pConnectArg->event == eOnLine) ? 1 : 0;
-            const char* deviceId = pConnectArg->serialNumber;
-            callback(isConnected, deviceId, it->second.userData);
+            info = *current;
+            valid = true;
         }
     }
-}
-
-/// <summary>
-/// »صװ
-/// </summary>
-static void SC_CALL OnParamUpdateCallback(const SC_SParamUpdateArg* pParamUpdateArg, void* pUser)
-{
-    if (!pParamUpdateArg || !pParamUpdateArg->pParamNameList) return;
 
-    CameraHandle handle = reinterpret_cast<CameraHandle>(pUser);
-    auto it = g_paramUpdateCallbackMap.find(handle);
-    if (it != g_paramUpdateCallbackMap.end())
+    ~CallbackScope()
     {
-        ParamUpdateCallBack callback = reinterpret_cast<ParamUpdateCallBack>(it->second.userCallback);
-        if (callback)
-        {
-            // ӰĲÿһûص
-            for (unsigned int i = 0; i < pParamUpdateArg->nParamCnt; i++)
-            {
-                const char* paramName = pParamUpdateArg->pParamNameList[i].str;
-                callback(paramName, it->second.userData);
-            }
-        }
+        t_dispatchingSlot = previous;
+        slot.inFlight.fetch_sub(1);
     }
-}
+
+    CallbackScope(const CallbackScope&) = delete;
+    CallbackScope& operator=(const CallbackScope&) = delete;
+};
 
 /// <summary>
-/// ״̬صװ
-/// SDK壺ExportEventCB(int progress, const char *msgText, int notify, void* user)
+/// ԭ滻صеĻص
 /// </summary>
-static void SC_CALL OnExportCallback(int progress, const char* msgText, int notify, void* pUser)
+/// <param name="slot">ص</param>
+/// <param name="userCallback">µûصnullptrʾȡע</param>
+/// <param name="userData">û</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// غɻص֤ٱãûصڶ۵ĵó⣩
+/// C#˿ڷغȫͷί
+/// </remarks>
+static ErrorCode SetCallback(CallbackSlot& slot, void* userCallback, void* userData)
 {
-    CameraHandle handle = reinterpret_cast<CameraHandle>(pUser);
-    auto it = g_exportCallbackMap.find(handle);
-    if (it != g_exportCallbackMap.end())
+    CallbackInfo* info = nullptr;
+    if (userCallback)
     {
-        ExportEventCallBack callback = reinterpret_cast<ExportEventCallBack>(it->second.userCallback);
-        if (callback)
-        {
-            // SDKnotifyӳΪ򻯵status
-            // ExportNotifyö٣eExportStart=0, eExportProcessing=1, eExportFinish=2, eExportClose=3
-            int status = notify;  // ֱʹSDKnotifyֵ
-
-            callback(status, progress, it->second.userData);
-        }
+        info = new (std::nothrow) CallbackInfo;
+        if (!info) return SC_NO_MEMORY;
+        info->userCallback = userCallback;
+        info->userData = userData;
     }
-}
-
-static void SC_CALL OnProcessedFrameCallback(SC_Frame* pFrame, void* pUser)
-{
-    if (!pFrame) return;
 
-    CameraHandle handle = reinterpret_cast<CameraHandle>(pUser);
-    auto it = g_processedFrameCallbackMap.find(handle);
-    if (it != g_processedFrameCallbackMap.end())
+    CallbackInfo* old = slot.info.exchange(info);
+    if (old)
     {
-        FrameCallBack callback = reinterpret_cast<FrameCallBack>(it->second.userCallback);
-        if (callback)
+        // ȴִеĻص˳ǰ߳ڷַʱ룩
+        int self = (t_dispatchingSlot == &slot) ? 1 : 0;
+        while (slot.inFlight.load() > self)
         {
-            // ת SC_Frame  ImageData
-            ImageData imageData;
-            imageData.width = pFrame->frameInfo.width;
-            imageData.height = pFrame->frameInfo.height;
-            imageData.pixelFormat = pFrame->frameInfo.pixelFormat;
-            imageData.dataSize = pFrame->frameInfo.size;
-            imageData.stride = pFrame->frameInfo.size / pFrame->frameInfo.height;
-            imageData.blockId = pFrame->frameInfo.frameId;
-            imageData.timeStamp = pFrame->frameInfo.timeStamp;
-            imageData.pData = (unsigned char*)pFrame->pData;
-
-            callback(&imageData, it->second.userData);
+            std::this_thread::yield();
         }
+        delete old;
     }
+
+    return SC_OK;
 }
 
+/// <summary>
+/// 豸״̬صȫ֣κξ
+/// </summary>
+static CallbackSlot g_connectCallbackSlot;
+
 // =================================================================
-// 5.1 ϵͳ
+// ֡
 // =================================================================
 
 /// <summary>
-/// ȡSDK汾Ϣ
+/// ÿͬʱ֡
 /// </summary>
-/// <returns>汾ַ磺"1.1.6"</returns>
-/// <remarks>
-/// - صַSDKڲҪͷ
-/// - 汾ʽ汾.ΰ汾.޶汾
-/// </remarks>
-REVEALER_API const char* Camera_GetVersion()
+static const unsigned int kMaxLeaseSlots = 64;
+
+/// <summary>
+/// ĬϿͬʱ֡
+/// SDK֡黹أᵼSDKľ
+/// </summary>
+static const unsigned int kDefaultMaxLeasedFrames = 4;
+
+/// <summary>
+/// ֡Դ黹ʽ
+/// </summary>
+enum LeaseSource
 {
-    return SC_GetVersion();
-}
+    LeaseSource_Copy = 0,       // SDKڻصغջѸƵcopyBuffer
+    LeaseSource_SdkFrame = 1,   // SDK֡黹ʱSC_ReleaseFrame㿽
+    LeaseSource_PoolSlot = 2    // ֡زۣ黹ʱͷ֡زۣ㿽
+};
 
 /// <summary>
-/// ʼSDK
-/// ע⣺ʹκSDK֮ǰ
+/// ֡
+/// ;һ֡ͼüʱ黹
 /// </summary>
-/// <param name="logLevel">־
-///   0 = Off    - ر־
-///   1 = Error  - 
-///   2 = Warn   - 漰
-///   3 = Info   - ϢϣƼ
-///   4 = Debug  - Լϣϸ
-/// </param>
-/// <param name="logPath">־·nullptrʾǰĿ¼</param>
-/// <param name="fileSize">־ļСֽڣ
-///   Ƽֵ10485760 (10MB)
-/// </param>
-/// <param name="fileNum">־ļѭ
-///   Ƽֵ10
-///   ˵ﵽḲɵļ
-/// </param>
-/// <returns>SC_OK(0)ʾɹֵʾ</returns>
-/// <remarks>
-/// ʹʾ
-/// Camera_Initialize(3, "C:/Logs", 10485760, 10);
-/// C:/LogsĿ¼10־ļÿ10MB
-/// </remarks>
-REVEALER_API ErrorCode Camera_Initialize(int logLevel, const char* logPath,
-    unsigned int fileSize, unsigned int fileNum)
+struct FrameLeaseSlot
 {
-    // δָ·ʹõǰĿ¼
-    if (!logPath) logPath = ".";
+    std::atomic<int> state;         // 0=, 1=ռ
+    std::atomic<int> refCount;      // ü
+    std::atomic<const unsigned char*> leasedData;   // pDataɺ󷢲nullptr=δ
+    LeaseSource source;             // ֡Դ
+    SC_Frame frame;                 // SDK֡source=LeaseSource_SdkFrameʱЧ
+    ImageData image;                // ͼ
+    unsigned char* copyBuffer;      // ƻã֡䣩
+    size_t copyCapacity;            // ƻ
+
+    FrameLeaseSlot() : state(0), refCount(0), leasedData(nullptr), source(LeaseSource_Copy), frame(), image(),
+        copyBuffer(nullptr), copyCapacity(0) {}
+};
 
-    // תΪSDK־ö
-    SCLogLevel level = static_cast<SCLogLevel>(logLevel);
+// =================================================================
+// ֡
+// =================================================================
 
-    return SC_Init(level, logPath, fileSize, fileNum);
-}
+/// <summary>
+/// ֡ĬϲδCamera_SetBufferCountʱ
+/// </summary>
+static const unsigned int kDefaultFramePoolSlots = 8;
 
 /// <summary>
-/// ͷSDKԴ
-/// ע⣺˳ǰãͷԴ
+/// ֡
+/// ;Camera_GetFrameSDK֡ƵԤĲУ黹SDK֡
+/// - Camera_SetBufferCount
+/// - ۰64ֽڶ룬ڴʹôҳ
+/// - ֻ֡ߴ仯ʱ·䣬ڼڴռú㶨
+/// - enabledֶlockʱ
 /// </summary>
-/// <remarks>
-/// ˳
-/// 1. ر (Camera_Close)
-/// 2. о (Camera_DestroyHandle)
-/// 3. ñ
-/// </remarks>
-REVEALER_API void Camera_Release()
+struct FramePool
 {
-    // վӳ
-    g_handleMap.clear();
+    std::mutex lock;
+    std::atomic<bool> enabled;      // Ƿ֡ģʽ
+    unsigned int requestedCount;    // ĲCamera_SetBufferCount
+    unsigned int slotCount;         // ǰѷĲ
+    size_t slotSize;                // ÿ۵ֽ64ֽڶ룩
+    unsigned char* memory;          // ڴ
+    unsigned char* held;            // ÿǷ񱻳УslotCount
+    unsigned int heldCount;         // еĲ
+    unsigned int next;              // һηʼλãΣ
+
+    FramePool() : enabled(false), requestedCount(kDefaultFramePoolSlots), slotCount(0), slotSize(0),
+        memory(nullptr), held(nullptr), heldCount(0), next(0) {}
+};
 
-    // ջصӳ
-    g_connectCallbackMap.clear();
-    g_paramUpdateCallbackMap.clear();
-    g_exportCallbackMap.clear();
+// =================================================================
+// ͳ
+// =================================================================
 
-    g_processedFrameCallbackMap.clear();
+/// <summary>
+/// ͳֱͼͰStreamStatisticsе鳤һ£
+/// kͰͳ[2^k, 2^(k+1))0Ͱͬʱ0һͰиֵ
+/// </summary>
+static const unsigned int kStreamHistogramBins = 24;
 
-    // ͷSDKԴ
-    SC_Release();
-}
+/// <summary>
+/// δյ֡ʱ֡ID
+/// </summary>
+static const unsigned long long kNoBlockId = ~0ULL;
 
 /// <summary>
-/// ö豸
+/// ԭʼ/󣩵ͳƼ
+/// ;ȡ֡/ص·relaxedԭӲۼӣȡͳʱ
+/// - ԭʼCamera_GetFrameɼ߳
+/// - Camera_GetProcessedFrameͼص
 /// </summary>
-/// <param name="pDeviceCount">ҵ豸</param>
-/// <param name="interfaceType">ӿͣöٷΧ
-///   0 (eInterfaceTypeAll)    - öнӿ͵豸Ƽ
-///   1 (eInterfaceTypeUsb3)   - öUSB3ӿ豸
-///   2 (eInterfaceTypeCXP)    - öCXPCoaXPressӿ豸
-///   3 (eInterfaceTypeCustom) - ö豸ڲԣ
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// Ҫ˵
-/// 1. öٽȫg_deviceList
-/// 2. ÿεûḲ֮ǰöٽ
-/// 3. ڴ֮ǰ
-/// 4. ȲΣ豸״̬ıҪö
-/// 
-/// interfaceTypeѡ飺
-/// - ͨʹ eInterfaceTypeAll (0)
-/// - ȷ֪豸ָͣöٶ
-/// - Gloria 4.2ͨUSB3CXPӿ
-/// 
-/// ע⣺SDKĵб
-/// - eInterfaceTypeCXP ӦöCXP豸
-/// - eInterfaceTypeUsb3 ӦöUSB3豸
-/// ʵʹʱ豸ʵʽӿΪ׼
-/// </remarks>
-REVEALER_API ErrorCode Camera_EnumDevices(int* pDeviceCount, unsigned int interfaceType)
+struct StreamStats
 {
-    if (!pDeviceCount) return -1;
+    std::atomic<unsigned long long> framesDelivered;    // յ֡
+    std::atomic<unsigned long long> framesLost;         // ֡IDۼƵĶ֡
+    std::atomic<unsigned long long> lastBlockId;        // һ֡֡ID
+    std::atomic<unsigned long long> lastTimeStamp;      // һ֡ʱ
+    std::atomic<unsigned long long> intervalHistogram[kStreamHistogramBins];   // ֡ʱӿ̶ȣ
+    std::atomic<unsigned long long> callbackHistogram[kStreamHistogramBins];   // صʱ΢룩
+    std::atomic<unsigned long long> callbackMaxMicroseconds;                   // صʱ΢룩
 
-    // SDKöٽӿ
-    // ˵
-    // - &g_deviceList: 豸б
-    // - interfaceType: ӿͣϷעͣ
-    // - nullptr: cti·nullptrʾʹûGENICAM_GENTL64_PATH
-    int ret = SC_EnumDevices(&g_deviceList, interfaceType, nullptr);
+    StreamStats() { Reset(); }
 
-    if (ret == SC_OK)
+    void Reset()
     {
-        // ҵ豸
-        *pDeviceCount = g_deviceList.devNum;
+        framesDelivered.store(0);
+        framesLost.store(0);
+        lastBlockId.store(kNoBlockId);
+        lastTimeStamp.store(0);
+        for (unsigned int i = 0; i < kStreamHistogramBins; i++)
+        {
+            intervalHistogram[i].store(0);
+            callbackHistogram[i].store(0);
+        }
+        callbackMaxMicroseconds.store(0);
     }
+};
 
-    return ret;
-}
+// =================================================================
+// ¼Ƶ
+// =================================================================
 
 /// <summary>
-/// ȡָ豸
-/// ע⣺ȵCamera_EnumDevices
+/// ¼Ƶĵ״̬
 /// </summary>
-/// <param name="index">豸Χ [0, deviceCount-1]</param>
-/// <param name="name">豸ƻ</param>
-/// <param name="nameSize">СƼ256ֽ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// 豸ʾ"Gloria 4.2"
-/// ʹʾ
-/// char name[256];
-/// Camera_GetDeviceName(0, name, sizeof(name));
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetDeviceName(int index, char* name, int nameSize)
+enum RecordState
 {
-    if (!name || index < 0 || index >= g_deviceList.devNum)
-        return -1;
-
-    // öٽи豸
-    strncpy_s(name, nameSize, g_deviceList.pDevInfo[index].cameraName, _TRUNCATE);
-    return SC_OK;
-}
+    RecordState_Idle = 0,       // ûб¼
+    RecordState_Armed,          // ļѴȴʼ֡
+    RecordState_Recording,      // ¼
+    RecordState_Finishing,      // ¼رգȴ̹߳رļ
+};
 
 /// <summary>
-/// 豸
-/// ע⣺ȵCamera_EnumDevices
+/// ¼ƵĵȣRecordParam.startFrame/startTimeStamp/count
+/// - ɼ߳ÿ֡ȡstateֻ״̬תʱCAS֡·û
+/// - ¼count֡ɼ̰߳״̬лΪFinishingɼ̹߳رļдβռòɼ߳
+/// - ߳¼ƴرļ˳Camera_CloseRecord/Camera_OpenRecordLifecycleScopeڻ
 /// </summary>
-/// <param name="pHandle">豸</param>
-/// <param name="deviceIndex">豸Ӧöʱ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ڣ
-/// 1.  (Camera_CreateHandle)
-/// 2.  (Camera_Open)
-/// 3. ʹ...
-/// 4. ر (Camera_Close)
-/// 5. پ (Camera_DestroyHandle)
-/// 
-/// ע⣺
-/// - һ豸ֻܴһExclusiveģʽ
-/// - 󲻻Զ
-/// - ԵDestroyHandle
-/// </remarks>
-REVEALER_API ErrorCode Camera_CreateHandle(CameraHandle* pHandle, int deviceIndex)
+struct RecordSchedule
 {
-    if (!pHandle || deviceIndex < 0 || deviceIndex >= g_deviceList.devNum)
-        return -1;
-
-    SC_DEV_HANDLE sdkHandle = nullptr;
-
-    // ʹCameraKeyʽƼ
-    // ʽ
-    // - eModeByIndex: ͨȶȲκܱ仯
-    // - eModeBySerialNumber: ͨкţȶ
-    // - eModeByCameraKey: ͨCameraKeyƼȶԺͱԣ
-    int ret = SC_CreateHandle(&sdkHandle, eModeByCameraKey,
-        g_deviceList.pDevInfo[deviceIndex].cameraKey);
+    std::atomic<int> state;                 // RecordState
+    unsigned long long startBlockId;        // ʼ֡ID0=ʼ
+    unsigned long long startTimeStamp;      // ʼʱ0=ʹã
+    unsigned int count;                     // ¼֡0=¼ƣ
+    unsigned int recordedFrames;            // ¼֡ɼ̷߳ʣ
+
+    std::thread monitor;                    // ߳
+    std::mutex monitorLock;
+    std::condition_variable monitorCond;
+    std::atomic<int> result;                // رļĽ
+
+    RecordSchedule() : state(RecordState_Idle), startBlockId(0), startTimeStamp(0), count(0), recordedFrames(0),
+        result(SC_OK) {}
+};
 
-    if (ret == SC_OK && sdkHandle != nullptr)
-    {
-        // ʹSDKΪⲿ
-        CameraHandle handle = (CameraHandle)sdkHandle;
+// =================================================================
+// 
+// =================================================================
 
-        // ӳϵ
-        g_handleMap[handle] = sdkHandle;
+/// <summary>
+/// ЧԱ
+/// ;ԶԣⲿCameraHandleg_contextTableУ飩ʱ
+/// </summary>
+static const unsigned int kCameraContextMagic = 0x52564C43;  // "RVLC"
 
-        // ⲿ
-        *pHandle = handle;
-    }
+/// <summary>
+/// ԭʼ¼Ĭϵ룩
+/// </summary>
+static const unsigned int kDefaultRecordCheckpointMilliseconds = 1000;
 
-    return ret;
-}
+/// <summary>
+/// ɼ߳ȡ֡ǳʱ˱ʱ䣨룩
+/// </summary>
+static const unsigned int kGrabErrorBackoffMaxMilliseconds = 100;
 
 /// <summary>
-/// 豸ͷԴ
-/// ע⣺ǰȹر
+/// ÿ̨
+/// Ⱪ¶CameraHandleھg_contextTableеľ
+/// ;
+/// - SDKڲ
+/// - лص
+/// - ״̬
+/// 
+/// ߳ģͣ
+/// - ڵ̣߳ͨΪUỊִ߳
+/// - SDKصͨpUserֱõģ֡ص·ûв
 /// </summary>
-/// <param name="handle">Ҫٵľ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-REVEALER_API ErrorCode Camera_DestroyHandle(CameraHandle handle)
+struct CameraContext
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    unsigned int magic;
+    SC_DEV_HANDLE sdkHandle;
+
+    CallbackSlot paramUpdateSlot;       // »ص
+    CallbackSlot exportSlot;            // ״̬ص
+    CallbackSlot processedFrameSlot;    // ͼص
+    CallbackSlot rawFrameSlot;          // ԭʼͼص
+
+    std::mutex lifecycleLock;               // лɼ̡߳¼Ƽ̵߳/ֹͣLifecycleScope
+    std::thread grabThread;                 // ɼ̣߳ԭʼͼص/ɼУ
+    std::atomic<bool> grabRunning;          // ɼ߳б־
+    std::atomic<bool> grabActive;           // ɼ߳δ˳grabRunningȡ֡
+    std::string serialNumber;               // 豸кţƥ״̬¼
+    std::atomic<bool> deviceLost;           // 豸ߣ״̬¼ɼ߳˳
+    FrameQueue frameQueue;                  // ɼУCamera_PopFrame
+    StripedRecorder recorder;               // ԭʼ¼ƣRecordFormat_Raw/RawLZ4Ŀ¼
+    TiffRecorder tiffRecorder;              // BigTIFF¼ƣRecordFormat_BigTIFF
+    FrameHistory history;                   // Ԥʷ壨Camera_SaveHistory
+    std::thread historySaver;               // 첽ʷ̣߳Camera_SaveHistoryAsync
+    std::atomic<bool> historySaving;        // 첽
+    RecordSchedule recordSchedule;          // ¼Ƶĵ
+    std::mutex recordSpillLock;             // recordSpill
+    RecordSpillParam recordSpill;           // ԭʼ¼ƵĻѹһ¼Ч
+    std::atomic<unsigned int> recordCheckpointFrames;       // ֡һ¼Ч
+    std::atomic<unsigned int> recordCheckpointMilliseconds; // ʱһ¼Ч
+    SnapshotEncoder snapshot;               // 첽գCamera_SnapshotAsync
+    std::mutex snapshotGrabLock;            // մSDKȡ֡ڼУɼ߳ǰȴ
+    std::atomic<int> directGrabs;           // еCamera_GetFrameȡ֡snapshotPullLockӣ
+    std::mutex snapshotPullLock;            // ֶΣȡ֡ȴCamera_GetFrame
+    std::condition_variable snapshotPullCond;
+    bool snapshotPulling;                   // ڴSDKȡ֡
+    int snapshotPullWaiters;                // ȴָ֡Camera_GetFrame
+    bool snapshotHandoff;                   // snapshotHandoffFrameЧһȴȡ
+    SC_Frame snapshotHandoffFrame;
+    FeatureTable features;                  // ѽԣCamera_ResolveFeature
+    FeatureCache featureCache;              // ֵ棨Camera_SetFeatureCacheEnabled
+    std::mutex nodeMapLock;                 // nodeMapDirectoryֵļ/
+    std::string nodeMapDirectory;           // ֵĻĿ¼=ʹã
+    NodeMap nodeMap;                        // ֵ䣨غٱ仯
+    std::atomic<bool> nodeMapReady;         // nodeMapѼأ֮Ҳ
+
+    FrameLeaseSlot leaseSlots[kMaxLeaseSlots];  // ֡
+    std::mutex sdkFramesLock;                   // sdkFrames
+    std::vector<SC_Frame> sdkFrames;            // Camera_GetFrame/GetProcessedFrameδͷŻSDK֡
+    std::atomic<unsigned int> leasedCount;      // ǰ
+    std::atomic<unsigned int> maxLeasedFrames;  // ͬʱ֡
+
+    FramePool framePool;                        // Camera_GetFrame֡
+
+    StreamStats rawStats;                       // ԭʼͳ
+    StreamStats processedStats;                 // ͳ
+
+    std::atomic<unsigned int> frameStatsInterval;   // ɼ߳м֡ͳƵļ0=رգ
+    std::mutex frameStatsLock;                      // ֶ
+    double frameStatsLow;                           // Ͱٷλ
+    double frameStatsHigh;                          // ߰ٷλ
+    FrameStats latestFrameStats;                    // һε֡ͳ
+
+    std::mutex colorLutLock;                        // userColorLut
+    std::vector<uint32_t> userColorLut;             // ûαʱ2564096ձʾδã
+
+    std::atomic<int> displayRotation;               // ʾתתRotationMode
+    std::atomic<int> displayFlip;                   // ʾתķתFlipMode-1=ת
+
+    CameraContext() : magic(kCameraContextMagic), sdkHandle(nullptr), grabRunning(false), grabActive(false),
+        deviceLost(false), historySaving(false), recordSpill(kDefaultRecordSpill), recordCheckpointFrames(0),
+        recordCheckpointMilliseconds(kDefaultRecordCheckpointMilliseconds), directGrabs(0),
+        snapshotPulling(false), snapshotPullWaiters(0), snapshotHandoff(false), nodeMapReady(false), leasedCount(0), maxLeasedFrames(kDefaultMaxLeasedFrames),
+        frameStatsInterval(0), frameStatsLow(0.1), frameStatsHigh(99.9), latestFrameStats(),
+        displayRotation(Rotate_0), displayFlip(-1) {}
+};
 
-    // SDK
-    int ret = SC_DestroyHandle(sdkHandle);
+/// <summary>
+/// Ѵģ1
+/// ;УⲿContextScopeCamera_Releaseʱͳһͷ
+/// پʱȹرվȴеĵýͷţ֮ԸþõĽӿڷ-1
+/// </summary>
+static HandleTable g_contextTable(1);
 
-    if (ret == SC_OK)
-    {
-        // ӳƳ
-        g_handleMap.erase(handle);
+static void StopGrabThread(CameraContext* ctx);
+static ErrorCode LoadNodeMap(CameraContext* ctx, bool build);
+static ErrorCode FinishNativeRecord(CameraContext* ctx);
 
-        // صӳ
-        g_connectCallbackMap.erase(handle);
-        g_paramUpdateCallbackMap.erase(handle);
-        g_exportCallbackMap.erase(handle);
+/// <summary>
+/// ֹͣпܷSDKı̣߳ɼ̡߳¼Ƽ̡߳ձ̣߳ȴ첽ʷ
+/// SDKSC_DestroyHandle/SC_Release֮ǰ
+/// lifecycleLockеĵͬʱ/̣߳Ѿܾڲɼ߳нУ
+/// </summary>
+static void StopContextThreads(CameraContext* ctx)
+{
+    std::lock_guard<std::mutex> lock(ctx->lifecycleLock);
+    StopGrabThread(ctx);
+    FinishNativeRecord(ctx);
+    ctx->snapshot.Shutdown();
+    if (ctx->historySaver.joinable()) ctx->historySaver.join();
+}
 
-        g_processedFrameCallbackMap.erase(handle);
+/// <summary>
+/// ͷļص
+/// ע⣺δ黹֡ٹ黹SDKSDK٣ͷŸƻ
+/// </summary>
+static void DestroyContext(CameraContext* ctx)
+{
+    ctx->magic = 0;
+    StopContextThreads(ctx);
+    ctx->frameQueue.Close();
+    ctx->history.SetBudget(0);
+    SetCallback(ctx->paramUpdateSlot, nullptr, nullptr);
+    SetCallback(ctx->exportSlot, nullptr, nullptr);
+    SetCallback(ctx->processedFrameSlot, nullptr, nullptr);
+    SetCallback(ctx->rawFrameSlot, nullptr, nullptr);
+
+    for (unsigned int i = 0; i < kMaxLeaseSlots; i++)
+    {
+        delete[] ctx->leaseSlots[i].copyBuffer;
     }
-
-    return ret;
+    FreeFrameMemory(ctx->framePool.memory);
+    delete[] ctx->framePool.held;
+    delete ctx;
 }
 
 // =================================================================
-// 5.2 
+// 
 // =================================================================
 
 /// <summary>
-/// ĬȨޣ
-/// ͬ Camera_OpenEx(handle, AccessPermissionExclusive)
+/// 
+/// ;CameraHandleȡ
+/// - ʱھһCASЧٵľõnullptr
+/// - ʱCamera_DestroyHandle/Camera_Releaseȴͷ
+/// ÷ָͬContextScope ctx(handle); if (!ctx) return -1;
 /// </summary>
-/// <param name="handle">豸</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ĬʹöռģʽExclusive޷ͬʱ
-/// </remarks>
-REVEALER_API ErrorCode Camera_Open(CameraHandle handle)
+struct ContextScope
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_Open(sdkHandle);
-}
+    CameraHandle handle;
+    CameraContext* ctx;
 
-///// <summary>
-///// ָȨޣ
-///// </summary>
-///// <param name="handle">豸</param>
-///// <param name="accessPermission">Ȩģʽ
-/////   0 (AccessPermissionUnknown)   - δ֪Ȩ
-/////   1 (AccessPermissionNone)      - ޷Ȩ
-/////   2 (AccessPermissionMonitor)   - ֻģʽͬʱ
-/////   3 (AccessPermissionControl)   - ģʽ޸Ĳռ
-/////   4 (AccessPermissionExclusive) - ռģʽȫƣƼ
-///// </param>
-///// <returns>SC_OK(0)ʾɹ</returns>
-///// <remarks>
-///// Ȩ˵
-///// - Monitor: ʺֻأܲɼͼ
-///// - Control: ɿռ
-///// - Exclusive: ȫƣƼͼɼ
-///// 
-///// ʧԭ
-///// - ѱ򿪣Exclusiveģʽ
-///// - USB
-///// - δװ
-///// </remarks>
-//REVEALER_API ErrorCode Camera_OpenEx(CameraHandle handle, int accessPermission)
-//{
-//    //SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-//    //if (!sdkHandle) return -1;
-//
-//    //// תȨö
-//    //SC_ECameraAccessPermission permission =
-//    //    static_cast<SC_ECameraAccessPermission>(accessPermission);
-//
-//    //return SC_OpenEx(sdkHandle, permission);
-//
-//    return -1;
-//}
+    explicit ContextScope(CameraHandle h) : handle(h), ctx(static_cast<CameraContext*>(g_contextTable.Pin(h)))
+    {
+        assert(!ctx || ctx->magic == kCameraContextMagic);
+    }
+
+    ~ContextScope()
+    {
+        if (ctx) g_contextTable.Unpin(handle);
+    }
+
+    ContextScope(const ContextScope&) = delete;
+    ContextScope& operator=(const ContextScope&) = delete;
+
+    operator CameraContext*() const { return ctx; }
+    CameraContext* operator->() const { return ctx; }
+
+    /// <summary>ӦSDKЧnullptr</summary>
+    SC_DEV_HANDLE SdkHandle() const { return ctx ? ctx->sdkHandle : nullptr; }
+};
 
 /// <summary>
-/// ر
-/// ע⣺رǰֹͣɼ
+/// SDK֡Ϣ䵽ImageData
+/// ע⣺pDataֱָSDKڴ棬
 /// </summary>
-/// <param name="handle">豸</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ȷĹر˳
-/// 1. ֹͣɼ (Camera_StopGrabbing)
-/// 2. ر (Camera_Close)
-/// 3. پ (Camera_DestroyHandle)
-/// </remarks>
-REVEALER_API ErrorCode Camera_Close(CameraHandle handle)
+static void FillImageData(const SC_Frame& frame, ImageData* pImage)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_Close(sdkHandle);
+    pImage->width = frame.frameInfo.width;
+    pImage->height = frame.frameInfo.height;
+    pImage->pixelFormat = frame.frameInfo.pixelFormat;
+    pImage->dataSize = frame.frameInfo.size;
+    pImage->stride = frame.frameInfo.size / frame.frameInfo.height;
+    pImage->blockId = frame.frameInfo.frameId;      // ֡
+    pImage->timeStamp = frame.frameInfo.timeStamp;  // ʱ
+    pImage->pData = (unsigned char*)frame.pData;    // ע⣺ָSDKڴ
 }
 
-// =================================================================
-// 5.3 
-// =================================================================
+/// <summary>
+/// ImageDataؽSC_Frameڹ黹Camera_GetFrameȡõ֡
+/// </summary>
+static void ImageDataToFrame(const ImageData* pImage, SC_Frame* pFrame)
+{
+    pFrame->pData = pImage->pData;
+    pFrame->frameInfo.width = pImage->width;
+    pFrame->frameInfo.height = pImage->height;
+    pFrame->frameInfo.pixelFormat = (SC_EPixelType)pImage->pixelFormat;
+    pFrame->frameInfo.size = pImage->dataSize;
+}
+/// <summary>
+/// ֱͼͰţfloor(log2(value))ΧֵһͰ
+/// </summary>
+static unsigned int HistogramBin(unsigned long long value)
+{
+    unsigned int bin = 0;
+    while (value > 1 && bin < kStreamHistogramBins - 1)
+    {
+        value >>= 1;
+        bin++;
+    }
+    return bin;
+}
 
 /// <summary>
-/// GenICam XMLļ
-/// ;ڲ鿴Զ
+/// ¼һ֡ͳ
+/// ֡IDˣ¿ʼɼʱֻ»׼Ϊ֡
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="pFullPath">·ļ
-///   磺"C:/Config/camera_config.xml"
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// XMLļ
-/// - пԼ͡Χ
-/// - ֮ϵ
-/// - 
-/// 
-/// ͨڣ
-/// - ԺͿ
-/// - ˽
-/// - GenICam׼ߵ
-/// </remarks>
-REVEALER_API ErrorCode Camera_DownloadGenICamXML(CameraHandle handle, const char* pFullPath)
+static void RecordFrameStats(StreamStats& stats, const SC_Frame& frame)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pFullPath) return -1;
+    stats.framesDelivered.fetch_add(1, std::memory_order_relaxed);
 
-    return SC_DownLoadGenICamXML(sdkHandle, pFullPath);
-}
+    unsigned long long blockId = frame.frameInfo.frameId;
+    unsigned long long lastBlockId = stats.lastBlockId.exchange(blockId, std::memory_order_relaxed);
+    if (lastBlockId != kNoBlockId && blockId > lastBlockId + 1)
+    {
+        stats.framesLost.fetch_add(blockId - lastBlockId - 1, std::memory_order_relaxed);
+    }
 
-// =================================================================
-// 5.4 ȡ豸Ϣ
-// =================================================================
+    unsigned long long timeStamp = frame.frameInfo.timeStamp;
+    unsigned long long lastTimeStamp = stats.lastTimeStamp.exchange(timeStamp, std::memory_order_relaxed);
+    if (lastTimeStamp != 0 && timeStamp > lastTimeStamp)
+    {
+        stats.intervalHistogram[HistogramBin(timeStamp - lastTimeStamp)].fetch_add(1, std::memory_order_relaxed);
+    }
+}
 
 /// <summary>
-/// ȡ豸ϸϢ
+/// ¼һûصִʱ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="pDevInfo">豸Ϣṹ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// Ϣ
-/// - cameraName: 豸ƣ"Gloria 4.2"
-/// - serialNumber: кţΨһʶ
-/// - modelName: ͺ
-/// - manufacturerName: ̣"ZKJD"
-/// - deviceVersion: ̼汾
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetDeviceInfo(CameraHandle handle, DeviceInfo* pDevInfo)
+static void RecordCallbackStats(StreamStats& stats, std::chrono::steady_clock::time_point start)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pDevInfo) return -1;
+    unsigned long long elapsed = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 
-    SC_DeviceInfo info;
-    int ret = SC_GetDeviceInfo(sdkHandle, &info);
+    stats.callbackHistogram[HistogramBin(elapsed)].fetch_add(1, std::memory_order_relaxed);
 
-    if (ret == SC_OK)
+    unsigned long long current = stats.callbackMaxMicroseconds.load(std::memory_order_relaxed);
+    while (elapsed > current &&
+        !stats.callbackMaxMicroseconds.compare_exchange_weak(current, elapsed, std::memory_order_relaxed))
     {
-        // Ƹֶ
-        strncpy_s(pDevInfo->cameraName, sizeof(pDevInfo->cameraName),
-            info.cameraName, _TRUNCATE);
-        strncpy_s(pDevInfo->serialNumber, sizeof(pDevInfo->serialNumber),
-            info.serialNumber, _TRUNCATE);
-        strncpy_s(pDevInfo->modelName, sizeof(pDevInfo->modelName),
-            info.modelName, _TRUNCATE);
-        strncpy_s(pDevInfo->manufacturerInfo, sizeof(pDevInfo->manufacturerInfo),
-            info.manufactureInfo, _TRUNCATE);
-        strncpy_s(pDevInfo->deviceVersion, sizeof(pDevInfo->deviceVersion),
-            info.deviceVersion, _TRUNCATE);
     }
+}
 
-    return ret;
+/// <summary>
+/// һ֡ͳ
+/// ʹȫֱֱͼÿֵһͰֱͼ̸߳
+/// </summary>
+static ErrorCode ComputeImageStats(const ImageData& image, double lowPercentile, double highPercentile,
+    FrameStats* pStats)
+{
+    int bitDepth = GetPixelBitDepth(image.pixelFormat);
+    int pixelBytes = GetPixelBytes(image.pixelFormat);
+    if (bitDepth == 0) return SC_NOT_SUPPORT;
+    if (image.width <= 0 || image.height <= 0 || image.stride < image.width * pixelBytes)
+        return SC_INVALID_PARAM;
+
+    unsigned int binCount = 1u << bitDepth;
+    static thread_local std::vector<uint32_t> t_histogram;
+    if (t_histogram.size() < binCount) t_histogram.resize(binCount);
+
+    ComputeHistogram(image.pData, image.stride, image.width, image.height, pixelBytes, 0,
+        t_histogram.data(), binCount);
+
+    HistogramStats stats;
+    ComputeHistogramStats(t_histogram.data(), binCount, lowPercentile, highPercentile, binCount - 1, &stats);
+
+    pStats->blockId = image.blockId;
+    pStats->pixelCount = stats.pixelCount;
+    pStats->saturatedPixels = stats.saturatedPixels;
+    pStats->mean = stats.mean;
+    pStats->stdDev = stats.stdDev;
+    pStats->minValue = static_cast<int>(stats.minValue);
+    pStats->maxValue = static_cast<int>(stats.maxValue);
+    pStats->lowClip = static_cast<int>(stats.lowClip);
+    pStats->highClip = static_cast<int>(stats.highClip);
+    return SC_OK;
 }
 
 // =================================================================
-// 5.5 
+// ̬صװ
 // =================================================================
 
 /// <summary>
-/// ʼɼͼ
+/// ״̬صװ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ɼ̣
-/// 1. ع⡢ROIȣ
-/// 2. Camera_StartGrabbingʼɼ
-/// 3. Camera_GetFrameȡͼ
-/// 4. ͼ
-/// 5. Camera_ReleaseFrameͷͼ
-/// 6. ظ3-5
-/// 7. Camera_StopGrabbingֹͣɼ
-/// 
-/// ע⣺
-/// - ʼɼǰ
-/// - ԵStopGrabbing
-/// - ɼڼ޸Ĳֲعʱ䣩
-/// </remarks>
-REVEALER_API ErrorCode Camera_StartGrabbing(CameraHandle handle)
+static void SC_CALL OnConnectCallback(const SC_SConnectArg* pConnectArg, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_StartGrabbing(sdkHandle);
+    if (!pConnectArg) return;
+
+    // /ߵɼ߳̾ݴ˳
+    for (unsigned int i = 0; i < kHandleTableSlots; i++)
+    {
+        ContextScope ctx(g_contextTable.HandleAt(i));
+        if (ctx && ctx->serialNumber == pConnectArg->serialNumber) ctx->deviceLost.store(pConnectArg->event != eOnLine);
+    }
+
+    CallbackScope scope(g_connectCallbackSlot);
+    if (scope.valid)
+    {
+        ConnectCallBack callback = reinterpret_cast<ConnectCallBack>(scope.info.userCallback);
+        int isConnected = (pConnectArg->event == eOnLine) ? 1 : 0;
+        const char* deviceId = pConnectArg->serialNumber;
+        callback(isConnected, deviceId, scope.info.userData);
+    }
 }
 
 /// <summary>
-/// ֹͣɼͼ
+/// »صװ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ֹͣ
-/// - ٲµͼ
-/// - еͼԿɻȡ
-/// - ޸в
-/// - StartGrabbing
-/// </remarks>
-REVEALER_API ErrorCode Camera_StopGrabbing(CameraHandle handle)
+static void SC_CALL OnParamUpdateCallback(const SC_SParamUpdateArg* pParamUpdateArg, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_StopGrabbing(sdkHandle);
+    if (!pParamUpdateArg || !pParamUpdateArg->pParamNameList) return;
+
+    CameraContext* ctx = static_cast<CameraContext*>(pUser);
+    if (!ctx) return;
+
+    // ԻʧЧûصлضʱȡֵ
+    for (unsigned int i = 0; i < pParamUpdateArg->nParamCnt; i++)
+    {
+        ctx->featureCache.Invalidate(pParamUpdateArg->pParamNameList[i].str);
+    }
+
+    CallbackScope scope(ctx->paramUpdateSlot);
+    if (scope.valid)
+    {
+        ParamUpdateCallBack callback = reinterpret_cast<ParamUpdateCallBack>(scope.info.userCallback);
+
+        // ӰĲÿһûص
+        for (unsigned int i = 0; i < pParamUpdateArg->nParamCnt; i++)
+        {
+            const char* paramName = pParamUpdateArg->pParamNameList[i].str;
+            callback(paramName, scope.info.userData);
+        }
+    }
 }
 
 /// <summary>
-/// Ƿڲɼ
+/// ״̬صװ
+/// SDK壺ExportEventCB(int progress, const char *msgText, int notify, void* user)
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="pIsGrabbing">1=ڲɼ0=δɼ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-REVEALER_API ErrorCode Camera_IsGrabbing(CameraHandle handle, int* pIsGrabbing)
+static void SC_CALL OnExportCallback(int progress, const char* msgText, int notify, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pIsGrabbing) return -1;
+    CameraContext* ctx = static_cast<CameraContext*>(pUser);
+    if (!ctx) return;
 
-    // SC_IsGrabbingboolתΪint
-    *pIsGrabbing = SC_IsGrabbing(sdkHandle) ? 1 : 0;
-    return SC_OK;
+    CallbackScope scope(ctx->exportSlot);
+    if (scope.valid)
+    {
+        ExportEventCallBack callback = reinterpret_cast<ExportEventCallBack>(scope.info.userCallback);
+
+        // SDKnotifyӳΪ򻯵status
+        // ExportNotifyö٣eExportStart=0, eExportProcessing=1, eExportFinish=2, eExportClose=3
+        int status = notify;  // ֱʹSDKnotifyֵ
+
+        callback(status, progress, scope.info.userData);
+    }
 }
 
 /// <summary>
-/// ֡
-/// StartGrabbing֮ǰ
+/// ǰ߳ڷַ֡
+/// ;Camera_LeaseFrameڻصбʱж֡ԴȨ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="bufferCount">
-///   Ƽֵ3-10
-///   Сܶ֡
-///   ռڴ࣬ӳ
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ƣ
-/// - SDKάһͼ񻺳
-/// - ɼͼȷ
-/// - GetFrameӶͷȡͼ
-/// - ʱͼᶪ֡
-/// 
+struct DispatchFrame
+{
+    CameraContext* ctx;
+    SC_Frame* frame;
+    bool ownedByWrapper;    // true=ɱ⸺黹SDK㿽裩
+    bool leased;            // صѱ裬صغٹ黹
+};
+
+static thread_local DispatchFrame* t_dispatchFrame = nullptr;
+
+/// <summary>
+/// ǰ߳ĸĵıɼ̣߳߳Ϊnullptr
+/// ;ܾԭʼͼصģɼ̷߳غԻģ
+/// </summary>
+static thread_local CameraContext* t_grabContext = nullptr;
+
+/// <summary>
+/// ͼصװ
+/// ֡SDKصغ󼴱
+/// </summary>
+static void SC_CALL OnProcessedFrameCallback(SC_Frame* pFrame, void* pUser)
+{
+    if (!pFrame) return;
+
+    CameraContext* ctx = static_cast<CameraContext*>(pUser);
+    if (!ctx) return;
+
+    RecordFrameStats(ctx->processedStats, *pFrame);
+
+    CallbackScope scope(ctx->processedFrameSlot);
+    if (scope.valid)
+    {
+        FrameCallBack callback = reinterpret_cast<FrameCallBack>(scope.info.userCallback);
+
+        // ת SC_Frame  ImageData
+        ImageData imageData;
+        FillImageData(*pFrame, &imageData);
+
+        DispatchFrame dispatch = { ctx, pFrame, false, false };
+        t_dispatchFrame = &dispatch;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        callback(&imageData, scope.info.userData);
+        RecordCallbackStats(ctx->processedStats, start);
+        t_dispatchFrame = nullptr;
+    }
+}
+
+/// <summary>
+/// Ȱ֡¼ɼ̣߳
+/// - Armed֡IDʱﵽʼֵʱʼ¼ƣʼ֡¼
+/// - Recording¼count֡¼֡ƣлΪFinishingѼ߳
+/// </summary>
+static void RecordScheduledFrame(CameraContext* ctx, const SC_Frame& frame)
+{
+    RecordSchedule& schedule = ctx->recordSchedule;
+    int state = schedule.state.load();
+
+    if (state == RecordState_Armed)
+    {
+        bool reached = schedule.startTimeStamp != 0
+            ? frame.frameInfo.timeStamp >= schedule.startTimeStamp
+            : frame.frameInfo.frameId >= schedule.startBlockId;
+        if (!reached) return;
+
+        // Camera_CloseRecordʧ˵ر
+        if (!schedule.state.compare_exchange_strong(state, RecordState_Recording)) return;
+        state = RecordState_Recording;
+    }
+
+    if (state != RecordState_Recording) return;
+
+    ImageData imageData;
+    FillImageData(frame, &imageData);
+    bool accepted = ctx->tiffRecorder.IsOpen() ? ctx->tiffRecorder.Push(imageData) : ctx->recorder.Push(imageData);
+
+    if (accepted && schedule.count != 0 && ++schedule.recordedFrames >= schedule.count)
+    {
+        if (schedule.state.compare_exchange_strong(state, RecordState_Finishing))
+        {
+            schedule.monitorCond.notify_one();
+        }
+    }
+}
+
+/// <summary>
+/// ¼Ƶļ̣߳ȴ״̬ΪFinishingرļ
+/// ¼رʱͨ״̬صϱFinish/Close
+/// </summary>
+static void RecordMonitorProc(CameraContext* ctx)
+{
+    RecordSchedule& schedule = ctx->recordSchedule;
+    {
+        // ɼ֪߳ͨʱóʱ׶ʧĻ
+        std::unique_lock<std::mutex> lock(schedule.monitorLock);
+        while (schedule.state.load() != RecordState_Finishing)
+        {
+            schedule.monitorCond.wait_for(lock, std::chrono::milliseconds(50));
+        }
+    }
+
+    int ret = SC_OK;
+    if (ctx->recorder.IsOpen()) ret = ctx->recorder.Close();
+    if (ctx->tiffRecorder.IsOpen()) ret = ctx->tiffRecorder.Close();
+
+    schedule.result.store(ret);
+    schedule.state.store(RecordState_Idle);
+}
+
+/// <summary>
+/// ¼ƣδ¼ʱرգȴ̹߳رļ
+/// ÷LifecycleScopelifecycleLockStopContextThreads
+/// </summary>
+/// <returns>رļĽ</returns>
+static ErrorCode FinishNativeRecord(CameraContext* ctx)
+{
+    RecordSchedule& schedule = ctx->recordSchedule;
+
+    int state = schedule.state.load();
+    while ((state == RecordState_Armed || state == RecordState_Recording) &&
+        !schedule.state.compare_exchange_weak(state, RecordState_Finishing))
+    {
+    }
+    schedule.monitorCond.notify_one();
+
+    if (schedule.monitor.joinable()) schedule.monitor.join();
+    return schedule.result.load();
+}
+
+/// <summary>
+/// ɼ߳
+/// ;ͨSC_GetFrameȡԭʼ֡Σ
+/// 1. Ƶʷ塢ȴ֡Ŀպͱ¼ԭʼ/BigTIFFʱ¼Ƶȣ
+/// 2. ƵɼУʱSDK֡ߴռ
+/// 3. ַԭʼͼصpDataֱָSDK㿽
+/// - ֡ɱ̸߳黹ص֡ӳٵCamera_ReturnFrame黹
+/// - ӱڻص֮ǰصܱ֡߳ʱ黹
+/// </summary>
+static void GrabThreadProc(CameraContext* ctx)
+{
+    unsigned int statsCounter = 0;
+    unsigned int errorBackoff = 0;  // 
+
+    t_grabContext = ctx;
+
+    while (ctx->grabRunning.load())
+    {
+        // 豸ߣ˳б־ߺһStartGrabThread
+        if (ctx->deviceLost.load())
+        {
+            ctx->grabRunning.store(false);
+            break;
+        }
+
+        SC_Frame frame;
+        frame.pData = nullptr;
+
+        // ̳ʱԱ㼰ʱӦֹͣ
+        int ret = SC_GetFrame(ctx->sdkHandle, &frame, 100);
+        if (ret != SC_OK)
+        {
+            // δʼɼ豸쳣ȴأ˱ܺԣת
+            if (ret != SC_TIMEOUT)
+            {
+                errorBackoff = errorBackoff ? std::min(errorBackoff * 2, kGrabErrorBackoffMaxMilliseconds) : 1;
+                std::this_thread::sleep_for(std::chrono::milliseconds(errorBackoff));
+            }
+            continue;
+        }
+        errorBackoff = 0;
+
+        if (frame.frameInfo.height == 0 || !frame.pData)
+        {
+            SC_ReleaseFrame(ctx->sdkHandle, &frame);
+            continue;
+        }
+
+        RecordFrameStats(ctx->rawStats, frame);
+
+        // ÿinterval֡һ֡ͳƣӦԶɫ/عжϣ
+        unsigned int statsInterval = ctx->frameStatsInterval.load();
+        if (statsInterval > 0 && ++statsCounter >= statsInterval)
+        {
+            statsCounter = 0;
+
+            double low, high;
+            {
+                std::lock_guard<std::mutex> lock(ctx->frameStatsLock);
+                low = ctx->frameStatsLow;
+                high = ctx->frameStatsHigh;
+            }
+
+            ImageData imageData;
+            FillImageData(frame, &imageData);
+
+            FrameStats stats;
+            if (ComputeImageStats(imageData, low, high, &stats) == SC_OK)
+            {
+                std::lock_guard<std::mutex> lock(ctx->frameStatsLock);
+                ctx->latestFrameStats = stats;
+            }
+        }
+
+        if (ctx->history.IsEnabled())
+        {
+            ImageData imageData;
+            FillImageData(frame, &imageData);
+            ctx->history.Push(imageData);
+        }
+
+        if (ctx->snapshot.IsWaiting())
+        {
+            ImageData imageData;
+            FillImageData(frame, &imageData);
+            ctx->snapshot.Offer(imageData);
+        }
+
+        if (ctx->recordSchedule.state.load() != RecordState_Idle)
+        {
+            RecordScheduledFrame(ctx, frame);
+        }
+
+        if (ctx->frameQueue.IsOpen())
+        {
+            ImageData imageData;
+            FillImageData(frame, &imageData);
+            ctx->frameQueue.Push(imageData, ctx->grabRunning);
+        }
+
+        DispatchFrame dispatch = { ctx, &frame, true, false };
+        {
+            CallbackScope scope(ctx->rawFrameSlot);
+            if (scope.valid)
+            {
+                FrameCallBack callback = reinterpret_cast<FrameCallBack>(scope.info.userCallback);
+
+                ImageData imageData;
+                FillImageData(frame, &imageData);
+
+                t_dispatchFrame = &dispatch;
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                callback(&imageData, scope.info.userData);
+                RecordCallbackStats(ctx->rawStats, start);
+                t_dispatchFrame = nullptr;
+            }
+        }
+
+        // δ֡黹SDK
+        if (!dispatch.leased)
+        {
+            SC_ReleaseFrame(ctx->sdkHandle, &frame);
+        }
+    }
+
+    ctx->grabActive.store(false);
+}
+
+/// <summary>
+/// ɼ߳
+/// ;/ֹͣɼ̺߳¼Ƽ߳ʱctx->lifecycleLock顢joinʹ̲߳ý
+/// - ̣߳
+/// - Ĳɼ̣߳صеã߿ڵȴ߳˳
+///   ѯɼ߳ѱҪֹͣʱЧ÷SC_BUSY
+/// ÷LifecycleScope lifecycle(ctx); if (!lifecycle) return SC_BUSY;
+/// </summary>
+struct LifecycleScope
+{
+    CameraContext* ctx;
+    bool locked;
+
+    explicit LifecycleScope(CameraContext* c) : ctx(c), locked(false)
+    {
+        if (t_grabContext != c)
+        {
+            c->lifecycleLock.lock();
+            locked = true;
+            return;
+        }
+
+        while (!(locked = c->lifecycleLock.try_lock()))
+        {
+            if (!c->grabRunning.load()) return;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ~LifecycleScope()
+    {
+        if (locked) ctx->lifecycleLock.unlock();
+    }
+
+    LifecycleScope(const LifecycleScope&) = delete;
+    LifecycleScope& operator=(const LifecycleScope&) = delete;
+
+    explicit operator bool() const { return locked; }
+};
+
+/// <summary>
+/// ɼ̣߳ʱκ£
+/// ÷LifecycleScope
+/// ڲɼ߳صڣʱָֻб־̴߳ӻصغȡ֡
+/// </summary>
+static void StartGrabThread(CameraContext* ctx)
+{
+    if (ctx->grabRunning.load()) return;
+
+    if (t_grabContext == ctx)
+    {
+        ctx->grabRunning.store(true);
+        return;
+    }
+
+    if (ctx->grabThread.joinable()) ctx->grabThread.join();
+
+    // עSDK״̬صCamera_SubscribeConnectArgעͬһȫֻصڷ豸
+    SC_SubscribeConnectArg(nullptr, OnConnectCallback, nullptr);
+
+    // ȴеĿȡ֮֡ոɲɼ߳ṩ֡
+    {
+        std::lock_guard<std::mutex> lock(ctx->snapshotGrabLock);
+        ctx->grabActive.store(true);
+        ctx->grabRunning.store(true);
+    }
+    ctx->grabThread = std::thread(GrabThreadProc, ctx);
+}
+
+/// <summary>
+/// ǷʹҪɼ̣߳ԭʼͼصɼС¼ơʷ壩
+/// </summary>
+static bool IsGrabThreadNeeded(CameraContext* ctx)
+{
+    return ctx->rawFrameSlot.info.load() != nullptr || ctx->frameQueue.IsOpen() ||
+        ctx->recorder.IsOpen() || ctx->tiffRecorder.IsOpen() || ctx->history.IsEnabled();
+}
+
+/// <summary>
+/// ֹͣɼ߳
+/// ÷LifecycleScopelifecycleLockStopContextThreads
+/// ڲɼ߳صڣʱֻб־̴߳ӻصغ˳һֹͣ
+/// </summary>
+static void StopGrabThread(CameraContext* ctx)
+{
+    ctx->grabRunning.store(false);
+    if (t_grabContext == ctx) return;
+
+    if (ctx->grabThread.joinable()) ctx->grabThread.join();
+}
+
+/// <summary>
+/// յ֡Դ̣߳ûȡ֡ʱֱӴSDKȡһ֡
+/// ɼ߳δ˳Camera_GetFrameȡ֡ʱSC_BUSYṩ֡
+/// - ȡ֡snapshotGrabLockڽУɼ߳ǰȵȴȡ֡
+/// - ȡ֡ڼ俪ʼCamera_GetFrameԼȡ֡ǵȴֱȡ֡Ƹպ󲻹黹SDK
+/// </summary>
+static ErrorCode GrabSnapshotFrame(void* pSource, SnapshotSink sink, void* pSink)
+{
+    CameraContext* ctx = static_cast<CameraContext*>(pSource);
+
+    std::lock_guard<std::mutex> lock(ctx->snapshotGrabLock);
+    if (ctx->grabActive.load()) return SC_BUSY;
+    {
+        std::lock_guard<std::mutex> pullLock(ctx->snapshotPullLock);
+        if (ctx->directGrabs.load() > 0) return SC_BUSY;
+        ctx->snapshotPulling = true;
+    }
+
+    SC_Frame frame;
+    frame.pData = nullptr;
+    int ret = SC_GetFrame(ctx->sdkHandle, &frame, 1000);
+    if (ret == SC_OK)
+    {
+        ImageData imageData;
+        FillImageData(frame, &imageData);
+        sink(imageData, pSink);
+    }
+
+    bool handedOff = false;
+    {
+        std::lock_guard<std::mutex> pullLock(ctx->snapshotPullLock);
+        ctx->snapshotPulling = false;
+        if (ret == SC_OK && ctx->snapshotPullWaiters > 0)
+        {
+            ctx->snapshotHandoffFrame = frame;
+            ctx->snapshotHandoff = true;
+            handedOff = true;
+        }
+    }
+    ctx->snapshotPullCond.notify_all();
+
+    if (ret == SC_OK && !handedOff) SC_ReleaseFrame(ctx->sdkHandle, &frame);
+    return ret;
+}
+
+/// <summary>
+/// SDK֡Ƶ֡صĿв
+/// ÷֮黹SDK֡
+/// </summary>
+/// <returns>SC_OKʾɹSC_BUSYʾв۶УSC_NO_MEMORYʾʧ</returns>
+static ErrorCode CopyFrameToPool(CameraContext* ctx, const SC_Frame& frame, ImageData* pImage)
+{
+    FramePool& pool = ctx->framePool;
+    size_t size = frame.frameInfo.size;
+    unsigned char* dst = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pool.lock);
+
+        // ֡ߴ仯ʱ·䣨ֻûв۱ʱУ
+        if (!pool.memory || pool.slotSize < size || pool.slotCount != pool.requestedCount)
+        {
+            if (pool.heldCount > 0) return SC_BUSY;
+
+            FreeFrameMemory(pool.memory);
+            delete[] pool.held;
+            pool.memory = nullptr;
+            pool.held = nullptr;
+            pool.slotCount = 0;
+
+            size_t slotSize = AlignFrameSize(size);
+            pool.memory = static_cast<unsigned char*>(
+                AllocateFrameMemory(slotSize * pool.requestedCount, nullptr));
+            pool.held = new (std::nothrow) unsigned char[pool.requestedCount]();
+            if (!pool.memory || !pool.held)
+            {
+                FreeFrameMemory(pool.memory);
+                delete[] pool.held;
+                pool.memory = nullptr;
+                pool.held = nullptr;
+                return SC_NO_MEMORY;
+            }
+            pool.slotCount = pool.requestedCount;
+            pool.slotSize = slotSize;
+            pool.next = 0;
+        }
+
+        // ϴλÿʼβҿвۣͷҲܸã
+        for (unsigned int i = 0; i < pool.slotCount && !dst; i++)
+        {
+            unsigned int index = (pool.next + i) % pool.slotCount;
+            if (!pool.held[index])
+            {
+                pool.held[index] = 1;
+                pool.heldCount++;
+                pool.next = (index + 1) % pool.slotCount;
+                dst = pool.memory + index * pool.slotSize;
+            }
+        }
+        if (!dst) return SC_BUSY;
+    }
+
+    memcpy(dst, frame.pData, size);
+    FillImageData(frame, pImage);
+    pImage->pData = dst;
+    return SC_OK;
+}
+
+/// <summary>
+/// ͷ֡ز
+/// </summary>
+/// <returns>pData֡ʱtrue</returns>
+static bool ReleasePoolFrame(CameraContext* ctx, const unsigned char* pData)
+{
+    FramePool& pool = ctx->framePool;
+    std::lock_guard<std::mutex> lock(pool.lock);
+
+    if (!pool.memory || pData < pool.memory ||
+        pData >= pool.memory + pool.slotCount * pool.slotSize)
+        return false;
+
+    size_t index = (pData - pool.memory) / pool.slotSize;
+    if (pool.held[index])
+    {
+        pool.held[index] = 0;
+        pool.heldCount--;
+    }
+    return true;
+}
+
+/// <summary>
+/// жpDataǷ֡
+/// </summary>
+static bool IsPoolFrame(CameraContext* ctx, const unsigned char* pData)
+{
+    FramePool& pool = ctx->framePool;
+    std::lock_guard<std::mutex> lock(pool.lock);
+
+    return pool.memory && pData >= pool.memory &&
+        pData < pool.memory + pool.slotCount * pool.slotSize;
+}
+
+/// <summary>
+/// Ǽǽ÷SDK֡Camera_GetFrame/Camera_GetProcessedFrame
+/// </summary>
+static void TrackSdkFrame(CameraContext* ctx, const SC_Frame& frame)
+{
+    std::lock_guard<std::mutex> lock(ctx->sdkFramesLock);
+    ctx->sdkFrames.push_back(frame);
+}
+
+/// <summary>
+/// ȡǼǵSDK֡ͷŻʱ
+/// </summary>
+/// <returns>pDataǵǼǵSDK֡ʱfalse</returns>
+static bool UntrackSdkFrame(CameraContext* ctx, const unsigned char* pData, SC_Frame* pFrame)
+{
+    std::lock_guard<std::mutex> lock(ctx->sdkFramesLock);
+    for (size_t i = 0; i < ctx->sdkFrames.size(); i++)
+    {
+        if (ctx->sdkFrames[i].pData != pData) continue;
+        *pFrame = ctx->sdkFrames[i];
+        ctx->sdkFrames[i] = ctx->sdkFrames.back();
+        ctx->sdkFrames.pop_back();
+        return true;
+    }
+    return false;
+}
+
+/// <summary>
+/// 黹
+/// üʱãSDK֡黹
+/// </summary>
+static void ReleaseLeaseSlot(CameraContext* ctx, FrameLeaseSlot& slot)
+{
+    slot.leasedData.store(nullptr);
+    if (slot.source == LeaseSource_SdkFrame)
+    {
+        SC_ReleaseFrame(ctx->sdkHandle, &slot.frame);
+    }
+    else if (slot.source == LeaseSource_PoolSlot)
+    {
+        ReleasePoolFrame(ctx, slot.image.pData);
+    }
+    slot.image.pData = nullptr;
+    slot.state.store(0);
+    ctx->leasedCount.fetch_sub(1);
+}
+
+/// <summary>
+/// ü10ʱ黹
+/// </summary>
+/// <returns>üΪ0δ䣩ʱfalse</returns>
+static bool DropLeaseReference(CameraContext* ctx, FrameLeaseSlot& slot)
+{
+    int count = slot.refCount.load();
+    do
+    {
+        if (count <= 0) return false;
+    } while (!slot.refCount.compare_exchange_weak(count, count - 1));
+
+    if (count == 1) ReleaseLeaseSlot(ctx, slot);
+    return true;
+}
+
+// =================================================================
+// 5.1 ϵͳ
+// =================================================================
+
+/// <summary>
+/// ȡSDK汾Ϣ
+/// </summary>
+/// <returns>汾ַ磺"1.1.6"</returns>
+/// <remarks>
+/// - صַSDKڲҪͷ
+/// - 汾ʽ汾.ΰ汾.޶汾
+/// </remarks>
+REVEALER_API const char* Camera_GetVersion()
+{
+    return SC_GetVersion();
+}
+
+/// <summary>
+/// ʼSDK
+/// ע⣺ʹκSDK֮ǰ
+/// </summary>
+/// <param name="logLevel">־
+///   0 = Off    - ر־
+///   1 = Error  - 
+///   2 = Warn   - 漰
+///   3 = Info   - ϢϣƼ
+///   4 = Debug  - Լϣϸ
+/// </param>
+/// <param name="logPath">־·nullptrʾǰĿ¼</param>
+/// <param name="fileSize">־ļСֽڣ
+///   Ƽֵ10485760 (10MB)
+/// </param>
+/// <param name="fileNum">־ļѭ
+///   Ƽֵ10
+///   ˵ﵽḲɵļ
+/// </param>
+/// <returns>SC_OK(0)ʾɹֵʾ</returns>
+/// <remarks>
+/// ʹʾ
+/// Camera_Initialize(3, "C:/Logs", 10485760, 10);
+/// C:/LogsĿ¼10־ļÿ10MB
+/// </remarks>
+REVEALER_API ErrorCode Camera_Initialize(int logLevel, const char* logPath,
+    unsigned int fileSize, unsigned int fileNum)
+{
+    // δָ·ʹõǰĿ¼
+    if (!logPath) logPath = ".";
+
+    // תΪSDK־ö
+    SCLogLevel level = static_cast<SCLogLevel>(logLevel);
+
+    return SC_Init(level, logPath, fileSize, fileNum);
+}
+
+/// <summary>
+/// ͷSDKԴ
+/// ע⣺˳ǰãͷԴ
+/// </summary>
+/// <remarks>
+/// ˳
+/// 1. ر (Camera_Close)
+/// 2. о (Camera_DestroyHandle)
+/// 3. ñ
+/// ڱɼ̣߳ԭʼͼصеãʱκ
+/// </remarks>
+REVEALER_API void Camera_Release()
+{
+    if (t_grabContext) return;
+
+    // ȹرо֮ЩõĽӿڷ-1
+    std::vector<CameraHandle> handles;
+    std::vector<CameraContext*> contexts;
+    for (unsigned int i = 0; i < kHandleTableSlots; i++)
+    {
+        CameraHandle handle = g_contextTable.HandleAt(i);
+        CameraContext* ctx = static_cast<CameraContext*>(g_contextTable.Close(handle));
+        if (!ctx) continue;
+
+        handles.push_back(handle);
+        contexts.push_back(ctx);
+    }
+
+    // ֹͣĲɼ¼ƼӺͿ̣߳ǻSDKѵȴɼеĵã
+    // ٵȴеĵýЩỵ̈߳ȴֹͣһ
+    for (size_t i = 0; i < contexts.size(); i++)
+    {
+        StopContextThreads(contexts[i]);
+        contexts[i]->frameQueue.Close();
+        g_contextTable.WaitUnpinned(handles[i], 0);
+        StopContextThreads(contexts[i]);
+    }
+
+    // ͷSDKԴ֮󲻻SDKص룩
+    SC_Release();
+
+    // ͷ
+    for (size_t i = 0; i < contexts.size(); i++)
+    {
+        DestroyContext(contexts[i]);
+        g_contextTable.Remove(handles[i]);
+    }
+
+    // ȫֻص
+    SetCallback(g_connectCallbackSlot, nullptr, nullptr);
+}
+
+/// <summary>
+/// ö豸
+/// </summary>
+/// <param name="pDeviceCount">ҵ豸</param>
+/// <param name="interfaceType">ӿͣöٷΧ
+///   0 (eInterfaceTypeAll)    - öнӿ͵豸Ƽ
+///   1 (eInterfaceTypeUsb3)   - öUSB3ӿ豸
+///   2 (eInterfaceTypeCXP)    - öCXPCoaXPressӿ豸
+///   3 (eInterfaceTypeCustom) - ö豸ڲԣ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// Ҫ˵
+/// 1. öٽȫg_deviceList
+/// 2. ÿεûḲ֮ǰöٽ
+/// 3. ڴ֮ǰ
+/// 4. ȲΣ豸״̬ıҪö
+/// 
+/// interfaceTypeѡ飺
+/// - ͨʹ eInterfaceTypeAll (0)
+/// - ȷ֪豸ָͣöٶ
+/// - Gloria 4.2ͨUSB3CXPӿ
+/// 
+/// ע⣺SDKĵб
+/// - eInterfaceTypeCXP ӦöCXP豸
+/// - eInterfaceTypeUsb3 ӦöUSB3豸
+/// ʵʹʱ豸ʵʽӿΪ׼
+/// </remarks>
+REVEALER_API ErrorCode Camera_EnumDevices(int* pDeviceCount, unsigned int interfaceType)
+{
+    if (!pDeviceCount) return -1;
+
+    // SDKöٽӿ
+    // ˵
+    // - &g_deviceList: 豸б
+    // - interfaceType: ӿͣϷעͣ
+    // - nullptr: cti·nullptrʾʹûGENICAM_GENTL64_PATH
+    int ret = SC_EnumDevices(&g_deviceList, interfaceType, nullptr);
+
+    if (ret == SC_OK)
+    {
+        // ҵ豸
+        *pDeviceCount = g_deviceList.devNum;
+    }
+
+    return ret;
+}
+
+/// <summary>
+/// ȡָ豸
+/// ע⣺ȵCamera_EnumDevices
+/// </summary>
+/// <param name="index">豸Χ [0, deviceCount-1]</param>
+/// <param name="name">豸ƻ</param>
+/// <param name="nameSize">СƼ256ֽ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// 豸ʾ"Gloria 4.2"
+/// ʹʾ
+/// char name[256];
+/// Camera_GetDeviceName(0, name, sizeof(name));
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetDeviceName(int index, char* name, int nameSize)
+{
+    if (!name || index < 0 || index >= g_deviceList.devNum)
+        return -1;
+
+    // öٽи豸
+    strncpy_s(name, nameSize, g_deviceList.pDevInfo[index].cameraName, _TRUNCATE);
+    return SC_OK;
+}
+
+/// <summary>
+/// 豸
+/// ע⣺ȵCamera_EnumDevices
+/// </summary>
+/// <param name="pHandle">豸</param>
+/// <param name="deviceIndex">豸Ӧöʱ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ڣ
+/// 1.  (Camera_CreateHandle)
+/// 2.  (Camera_Open)
+/// 3. ʹ...
+/// 4. ر (Camera_Close)
+/// 5. پ (Camera_DestroyHandle)
+/// 
+/// ע⣺
+/// - һ豸ֻܴһExclusiveģʽ
+/// - 󲻻Զ
+/// - ԵDestroyHandle
+/// - ͬʱڵľkHandleTableSlotsʱSC_NO_MEMORY
+/// </remarks>
+REVEALER_API ErrorCode Camera_CreateHandle(CameraHandle* pHandle, int deviceIndex)
+{
+    if (!pHandle || deviceIndex < 0 || deviceIndex >= g_deviceList.devNum)
+        return -1;
+
+    SC_DEV_HANDLE sdkHandle = nullptr;
+
+    // ʹCameraKeyʽƼ
+    // ʽ
+    // - eModeByIndex: ͨȶȲκܱ仯
+    // - eModeBySerialNumber: ͨкţȶ
+    // - eModeByCameraKey: ͨCameraKeyƼȶԺͱԣ
+    int ret = SC_CreateHandle(&sdkHandle, eModeByCameraKey,
+        g_deviceList.pDevInfo[deviceIndex].cameraKey);
+
+    if (ret == SC_OK && sdkHandle != nullptr)
+    {
+        // ģǼǵ
+        CameraContext* ctx = new (std::nothrow) CameraContext;
+        if (!ctx)
+        {
+            SC_DestroyHandle(sdkHandle);
+            return SC_NO_MEMORY;
+        }
+        ctx->sdkHandle = sdkHandle;
+        ctx->serialNumber = g_deviceList.pDevInfo[deviceIndex].serialNumber;
+        ctx->snapshot.SetFrameSource(GrabSnapshotFrame, ctx);
+
+        CameraHandle handle = g_contextTable.Add(ctx);
+        if (!handle)
+        {
+            delete ctx;
+            SC_DestroyHandle(sdkHandle);
+            return SC_NO_MEMORY;
+        }
+
+        // ⲿ
+        *pHandle = handle;
+    }
+
+    return ret;
+}
+
+/// <summary>
+/// 豸ͷԴ
+/// ע⣺ǰȹر
+/// </summary>
+/// <param name="handle">Ҫٵľ</param>
+/// <returns>SC_OK(0)ʾɹڸԭʼͼصеʱSC_BUSY</returns>
+REVEALER_API ErrorCode Camera_DestroyHandle(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    // ɼ̴߳ӻصغҪ黹֡ʻصۣڻصͷ
+    if (t_grabContext == ctx) return SC_BUSY;
+
+    // ȹرվ֮ԸþõĽӿڷ-1ͬʱֻһ
+    if (!g_contextTable.Close(handle)) return -1;
+
+    // ֹͣĲɼ¼ƼӺͿ̣߳ѵȴɼеĵãȴеĵý
+    // SDK֮þSDKص룩
+    // رǰĵãCamera_StartAcquisitionڵȴڼ̣߳ȴֹͣһ
+    // ʧʱ´򿪾ȻЧ֮ĿշSC_INVALID_RESOURCE
+    StopContextThreads(ctx);
+    ctx->frameQueue.Close();
+    g_contextTable.WaitUnpinned(handle, 1);
+    StopContextThreads(ctx);
+    int ret = SC_DestroyHandle(ctx->sdkHandle);
+    if (ret != SC_OK)
+    {
+        g_contextTable.Reopen(handle);
+        return ret;
+    }
+
+    // ͷļصĲ۲Ż
+    DestroyContext(ctx);
+    g_contextTable.Remove(handle);
+    return SC_OK;
+}
+
+// =================================================================
+// 5.2 
+// =================================================================
+
+/// <summary>
+/// ĬȨޣ
+/// ͬ Camera_OpenEx(handle, AccessPermissionExclusive)
+/// </summary>
+/// <param name="handle">豸</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ĬʹöռģʽExclusive޷ͬʱ
+/// Իʱ򿪺ע»صעʧʱرջ棩
+/// ֵĿ¼ʱ򿪺豸ͺš̼汾һµֵ
+/// </remarks>
+REVEALER_API ErrorCode Camera_Open(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    int ret = SC_Open(ctx->sdkHandle);
+    if (ret == SC_OK) ctx->deviceLost.store(false);
+    ctx->featureCache.Clear();
+    if (ret == SC_OK && ctx->featureCache.IsEnabled() &&
+        SC_SubscribeParamUpdateArg(ctx->sdkHandle, OnParamUpdateCallback, ctx) != SC_OK)
+    {
+        ctx->featureCache.SetEnabled(false);
+    }
+
+    // ˻Ŀ¼ʱӳѱֵ䣨ʱ
+    if (ret == SC_OK)
+    {
+        std::lock_guard<std::mutex> lock(ctx->nodeMapLock);
+        if (!ctx->nodeMapDirectory.empty()) LoadNodeMap(ctx, false);
+    }
+    return ret;
+}
+
+///// <summary>
+///// ָȨޣ
+///// </summary>
+///// <param name="handle">豸</param>
+///// <param name="accessPermission">Ȩģʽ
+/////   0 (AccessPermissionUnknown)   - δ֪Ȩ
+/////   1 (AccessPermissionNone)      - ޷Ȩ
+/////   2 (AccessPermissionMonitor)   - ֻģʽͬʱ
+/////   3 (AccessPermissionControl)   - ģʽ޸Ĳռ
+/////   4 (AccessPermissionExclusive) - ռģʽȫƣƼ
+///// </param>
+///// <returns>SC_OK(0)ʾɹ</returns>
+///// <remarks>
+///// Ȩ˵
+///// - Monitor: ʺֻأܲɼͼ
+///// - Control: ɿռ
+///// - Exclusive: ȫƣƼͼɼ
+///// 
+///// ʧԭ
+///// - ѱ򿪣Exclusiveģʽ
+///// - USB
+///// - δװ
+///// </remarks>
+//REVEALER_API ErrorCode Camera_OpenEx(CameraHandle handle, int accessPermission)
+//{
+//    //SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
+//    //if (!sdkHandle) return -1;
+//
+//    //// תȨö
+//    //SC_ECameraAccessPermission permission =
+//    //    static_cast<SC_ECameraAccessPermission>(accessPermission);
+//
+//    //return SC_OpenEx(sdkHandle, permission);
+//
+//    return -1;
+//}
+
+/// <summary>
+/// ر
+/// ע⣺رǰֹͣɼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ȷĹر˳
+/// 1. ֹͣɼ (Camera_StopGrabbing)
+/// 2. ر (Camera_Close)
+/// 3. پ (Camera_DestroyHandle)
+/// </remarks>
+REVEALER_API ErrorCode Camera_Close(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    ctx->featureCache.Clear();
+    {
+        // رպSDK֡ʧЧٰǼǵ֡黹
+        std::lock_guard<std::mutex> lock(ctx->sdkFramesLock);
+        ctx->sdkFrames.clear();
+    }
+    return SC_Close(ctx->sdkHandle);
+}
+
+// =================================================================
+// 5.3 
+// =================================================================
+
+/// <summary>
+/// GenICam XMLļ
+/// ;ڲ鿴Զ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pFullPath">·ļ
+///   磺"C:/Config/camera_config.xml"
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// XMLļ
+/// - пԼ͡Χ
+/// - ֮ϵ
+/// - 
+/// 
+/// ͨڣ
+/// - ԺͿ
+/// - ˽
+/// - GenICam׼ߵ
+/// </remarks>
+REVEALER_API ErrorCode Camera_DownloadGenICamXML(CameraHandle handle, const char* pFullPath)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pFullPath) return -1;
+
+    return SC_DownLoadGenICamXML(sdkHandle, pFullPath);
+}
+
+// =================================================================
+// 5.4 ȡ豸Ϣ
+// =================================================================
+
+/// <summary>
+/// ȡ豸ϸϢ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pDevInfo">豸Ϣṹ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// Ϣ
+/// - cameraName: 豸ƣ"Gloria 4.2"
+/// - serialNumber: кţΨһʶ
+/// - modelName: ͺ
+/// - manufacturerName: ̣"ZKJD"
+/// - deviceVersion: ̼汾
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetDeviceInfo(CameraHandle handle, DeviceInfo* pDevInfo)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pDevInfo) return -1;
+
+    SC_DeviceInfo info;
+    int ret = SC_GetDeviceInfo(sdkHandle, &info);
+
+    if (ret == SC_OK)
+    {
+        // Ƹֶ
+        strncpy_s(pDevInfo->cameraName, sizeof(pDevInfo->cameraName),
+            info.cameraName, _TRUNCATE);
+        strncpy_s(pDevInfo->serialNumber, sizeof(pDevInfo->serialNumber),
+            info.serialNumber, _TRUNCATE);
+        strncpy_s(pDevInfo->modelName, sizeof(pDevInfo->modelName),
+            info.modelName, _TRUNCATE);
+        strncpy_s(pDevInfo->manufacturerInfo, sizeof(pDevInfo->manufacturerInfo),
+            info.manufactureInfo, _TRUNCATE);
+        strncpy_s(pDevInfo->deviceVersion, sizeof(pDevInfo->deviceVersion),
+            info.deviceVersion, _TRUNCATE);
+    }
+
+    return ret;
+}
+
+// =================================================================
+// 5.5 
+// =================================================================
+
+/// <summary>
+/// ʼɼͼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ɼ̣
+/// 1. ع⡢ROIȣ
+/// 2. Camera_StartGrabbingʼɼ
+/// 3. Camera_GetFrameȡͼ
+/// 4. ͼ
+/// 5. Camera_ReleaseFrameͷͼ
+/// 6. ظ3-5
+/// 7. Camera_StopGrabbingֹͣɼ
+/// 
+/// ע⣺
+/// - ʼɼǰ
+/// - ԵStopGrabbing
+/// - ɼڼ޸Ĳֲعʱ䣩
+/// </remarks>
+REVEALER_API ErrorCode Camera_StartGrabbing(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
+    return SC_StartGrabbing(sdkHandle);
+}
+
+/// <summary>
+/// ֹͣɼͼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ֹͣ
+/// - ٲµͼ
+/// - еͼԿɻȡ
+/// - ޸в
+/// - StartGrabbing
+/// </remarks>
+REVEALER_API ErrorCode Camera_StopGrabbing(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
+    return SC_StopGrabbing(sdkHandle);
+}
+
+/// <summary>
+/// Ƿڲɼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pIsGrabbing">1=ڲɼ0=δɼ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+REVEALER_API ErrorCode Camera_IsGrabbing(CameraHandle handle, int* pIsGrabbing)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pIsGrabbing) return -1;
+
+    // SC_IsGrabbingboolתΪint
+    *pIsGrabbing = SC_IsGrabbing(sdkHandle) ? 1 : 0;
+    return SC_OK;
+}
+
+/// <summary>
+/// ֡
+/// StartGrabbing֮ǰ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="bufferCount">
+///   Ƽֵ3-10
+///   Сܶ֡
+///   ռڴ࣬ӳ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ƣ
+/// - SDKάһͼ񻺳
+/// - ɼͼȷ
+/// - GetFrameӶͷȡͼ
+/// - ʱͼᶪ֡
+/// 
 /// ֵ
 /// - ʵʱԤ3-5
 /// - ¼/棺5-10
 /// - ٲɼ10-20
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetBufferCount(CameraHandle handle, unsigned int bufferCount)
+REVEALER_API ErrorCode Camera_SetBufferCount(CameraHandle handle, unsigned int bufferCount)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    int ret = SC_SetBufferCount(ctx->sdkHandle, bufferCount);
+    if (ret == SC_OK && bufferCount > 0)
+    {
+        // ֡زSDKһ£һȡ֡ʱ·
+        std::lock_guard<std::mutex> lock(ctx->framePool.lock);
+        ctx->framePool.requestedCount = bufferCount;
+    }
+    return ret;
+}
+
+/// <summary>
+/// ֡ģʽ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="enable">1=, 0=</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ֡ģʽ£Camera_GetFrame / Camera_GetProcessedFrame
+/// - SDK֡ƵԤĲУ黹SDK
+/// - pImage->pDataָ֡زۣCamera_ReleaseFrameͷŲ
+/// - ÷ͷŻͷֻռ֡زۣľSDK
+/// - в۶ʱ֡SC_BUSY
+/// 
+/// ֡ڴ棺
+/// - Camera_SetBufferCountõĬ8
+/// - ÿ۰64ֽڶ룬ڴʹôҳ
+/// - ֻ֡ߴ仯ʱ·䣬ʱڴռú㶨
+/// 
+/// ۣÿ֡һڴ渴
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetFramePoolEnabled(CameraHandle handle, int enable)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    ctx->framePool.enabled.store(enable != 0);
+    return SC_OK;
+}
+
+/// <summary>
+/// ȡһ֡ͼͬʽ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pImage">ͼݽṹ</param>
+/// <param name="timeout">ʱʱ䣨룩
+///   0xFFFFFFFF = ޵ȴ
+///   0 = 
+///   ֵ = ȴָ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// Ҫ
+/// 1. pImage->pDataָSDKڲڴ
+/// 2. C#˱
+/// 3. Camera_ReleaseFrameͷ
+/// 4. ͷŻᵼڴй©ͻľ
+/// 5. ֡ģʽ£Camera_SetFramePoolEnabledpDataָ򱾿֡زۣ
+///    SDK֡黹δͷֻռ֡ز
+/// 
+/// ͼݽṹ
+/// - width, height: ͼߴ
+/// - stride: ÿֽ!=width*pixelSize
+/// - pixelFormat: ظʽöٶ壩
+/// - pData: ͼָ
+/// - dataSize: ܴС
+/// - blockId: ֡ţ0ʼ
+/// - timeStamp: ʱڲʱӣ
+/// 
+/// ʱ
+/// - ʱش
+/// - ͨԭδ̫֡͡Ӳ
+/// 
+/// 첽ڴSDKȡ֡ʱؿȡͬһ֡֡
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pImage) return -1;
+    SC_DEV_HANDLE sdkHandle = ctx->sdkHandle;
+
+    SC_Frame frame;
+    frame.pData = nullptr;
+
+    // ȡһ֡ͼȵǼȡ֡ղٴSDKȡ֡
+    // ȡ֡ʱȡ֡ոƺ󽻸ãҲȴ
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool handedOff = false;
+    bool pullTimedOut = false;
+    int ret = SC_TIMEOUT;
+    {
+        std::unique_lock<std::mutex> lock(ctx->snapshotPullLock);
+        ctx->directGrabs.fetch_add(1);
+        if (ctx->snapshotPulling)
+        {
+            ctx->snapshotPullWaiters++;
+            auto done = [&]() { return !ctx->snapshotPulling; };
+            if (timeout == 0xFFFFFFFF) ctx->snapshotPullCond.wait(lock, done);
+            else ctx->snapshotPullCond.wait_for(lock, std::chrono::milliseconds(timeout), done);
+            ctx->snapshotPullWaiters--;
+            pullTimedOut = ctx->snapshotPulling;
+
+            if (ctx->snapshotHandoff)
+            {
+                frame = ctx->snapshotHandoffFrame;
+                ctx->snapshotHandoff = false;
+                handedOff = true;
+                ret = SC_OK;
+            }
+        }
+    }
+
+    // ȡ֡ʧʱʣĳʱʱԼȡ֡
+    if (!handedOff && !pullTimedOut)
+    {
+        unsigned int remaining = timeout;
+        if (timeout != 0xFFFFFFFF)
+        {
+            long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            remaining = elapsed >= static_cast<long long>(timeout) ? 0 : timeout - static_cast<unsigned int>(elapsed);
+        }
+        ret = SC_GetFrame(sdkHandle, &frame, remaining);
+    }
+    ctx->directGrabs.fetch_sub(1);
+    if (ret != SC_OK) return ret;
+
+    // ֤ͼЧ
+    if (frame.frameInfo.width == 0 || frame.frameInfo.height == 0 ||
+        frame.frameInfo.size == 0 || !frame.pData)
+    {
+        // ЧͷŲش
+        SC_ReleaseFrame(sdkHandle, &frame);
+        return -1;
+    }
+
+    RecordFrameStats(ctx->rawStats, frame);
+
+    // ȴ֡Ŀɱȡ֡ṩ
+    if (ctx->snapshot.IsWaiting())
+    {
+        ImageData imageData;
+        FillImageData(frame, &imageData);
+        ctx->snapshot.Offer(imageData);
+    }
+
+    // ֡ģʽƵ֡ز۲黹SDK֡
+    if (ctx->framePool.enabled.load())
+    {
+        ret = CopyFrameToPool(ctx, frame, pImage);
+        SC_ReleaseFrame(sdkHandle, &frame);
+        return ret;
+    }
+
+    // ImageDataṹpDataָSDKڴ棩
+    FillImageData(frame, pImage);
+    TrackSdkFrame(ctx, frame);
+
+    return SC_OK;
+}
+
+/// <summary>
+/// ͷ֡Դ
+/// Camera_GetFrameԵ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pImage">Ҫͷŵͼ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ͷŻƣ
+/// - 黹SDK
+/// - Ա
+/// - δͷŻᵼ»ľ
+/// 
+/// ע⣺
+/// - ͷźpDataָʧЧ
+/// - Ҫظͷͬһ֡
+/// - ֡ģʽ¿ͷ
+/// </remarks>
+REVEALER_API ErrorCode Camera_ReleaseFrame(CameraHandle handle, ImageData* pImage)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pImage) return -1;
+    SC_DEV_HANDLE sdkHandle = ctx->sdkHandle;
+
+    // ֡زֻۣͷŲۣSDK֡ȡ֡ʱѹ黹
+    if (ReleasePoolFrame(ctx, pImage->pData)) return SC_OK;
+
+    // ȡ֡ʱSC_Frame黹δǼǵ֡رǰȡãImageDataؽ
+    SC_Frame frame;
+    if (!UntrackSdkFrame(ctx, pImage->pData, &frame)) ImageDataToFrame(pImage, &frame);
+
+    return SC_ReleaseFrame(sdkHandle, &frame);
+}
+
+/// <summary>
+/// һ֡ͼü
+/// ;ڻصغͼ罻̴߳⸴
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pImage">룺ҪͼͼpDataڹ黹ǰЧ</param>
+/// <param name="pLease">Camera_ReturnFrame</param>
+/// <returns>SC_OK(0)ʾɹSC_BUSYʾѴﵽޣSC_INVALID_PARAMʾͼԴ֮һ</returns>
+/// <remarks>
+/// ͼԴ
+/// - ԭʼͼصCamera_AttachRawGrabbingеͼ㿽
+///   SDKڹ黹ǰص
+/// - Camera_GetFrameȡõͼ񣨺֡ģʽ㿽Camera_ReturnFrameͷţ
+///   ҪٵCamera_ReleaseFrame
+/// - ͼصCamera_AttachProcessedGrabbingеͼ
+///   SDKڻصغմ󻺳˸Ƶ۵ĸû
+/// 
+/// ü
+/// - ͬһ֡ظ践ͬһü1
+/// - ÿ趼ӦһCamera_ReturnFrame
+/// 
+/// ޣ
+/// - ͬʱ֡Camera_SetMaxLeasedFramesƣĬ4
+/// - SDK֡ռSDKӦСCamera_SetBufferCountõ
+/// </remarks>
+REVEALER_API ErrorCode Camera_LeaseFrame(CameraHandle handle, ImageData* pImage, FrameLease* pLease)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pImage || !pImage->pData || !pLease) return -1;
+
+    // ֡ü
+    for (unsigned int i = 0; i < kMaxLeaseSlots; i++)
+    {
+        FrameLeaseSlot& slot = ctx->leaseSlots[i];
+        if (slot.leasedData.load() != pImage->pData) continue;
+
+        int count = slot.refCount.load();
+        while (count > 0 && !slot.refCount.compare_exchange_weak(count, count + 1)) {}
+        if (count <= 0) continue;
+
+        // ֮ǰۿѹ黹һ֡ȷϺʹ
+        if (slot.leasedData.load() == pImage->pData)
+        {
+            *pImage = slot.image;
+            *pLease = static_cast<FrameLease>(&slot);
+            return SC_OK;
+        }
+        DropLeaseReference(ctx, slot);
+    }
+
+    // 
+    if (ctx->leasedCount.fetch_add(1) >= ctx->maxLeasedFrames.load())
+    {
+        ctx->leasedCount.fetch_sub(1);
+        return SC_BUSY;
+    }
+
+    // ռһ
+    FrameLeaseSlot* pSlot = nullptr;
+    for (unsigned int i = 0; i < kMaxLeaseSlots && !pSlot; i++)
+    {
+        int expected = 0;
+        if (ctx->leaseSlots[i].state.compare_exchange_strong(expected, 1))
+        {
+            pSlot = &ctx->leaseSlots[i];
+        }
+    }
+    if (!pSlot)
+    {
+        ctx->leasedCount.fetch_sub(1);
+        return SC_BUSY;
+    }
+
+    FrameLeaseSlot& slot = *pSlot;
+    slot.image = *pImage;
+
+    DispatchFrame* dispatch = t_dispatchFrame;
+    bool inCallback = dispatch && dispatch->ctx == ctx &&
+        dispatch->frame->pData == pImage->pData;
+
+    if (inCallback && !dispatch->ownedByWrapper)
+    {
+        // ͼSDKصغ󼴻գƵû
+        size_t size = static_cast<size_t>(pImage->dataSize);
+        if (slot.copyCapacity < size)
+        {
+            delete[] slot.copyBuffer;
+            slot.copyBuffer = new (std::nothrow) unsigned char[size];
+            slot.copyCapacity = slot.copyBuffer ? size : 0;
+            if (!slot.copyBuffer)
+            {
+                slot.state.store(0);
+                ctx->leasedCount.fetch_sub(1);
+                return SC_NO_MEMORY;
+            }
+        }
+        memcpy(slot.copyBuffer, pImage->pData, size);
+        slot.image.pData = slot.copyBuffer;
+        slot.source = LeaseSource_Copy;
+    }
+    else if (inCallback)
+    {
+        // ԭʼͼ񣺽ӹSDK֡صغٹ黹
+        slot.frame = *dispatch->frame;
+        slot.source = LeaseSource_SdkFrame;
+        dispatch->leased = true;
+    }
+    else if (IsPoolFrame(ctx, pImage->pData))
+    {
+        // ֡ģʽCamera_GetFrameȡõ֡ӹ֡ز
+        slot.source = LeaseSource_PoolSlot;
+    }
+    else if (UntrackSdkFrame(ctx, pImage->pData, &slot.frame))
+    {
+        // Camera_GetFrameȡõ֡ӹͷ
+        slot.source = LeaseSource_SdkFrame;
+    }
+    else
+    {
+        // Ǳ⽻֡÷ԼĻ
+        slot.state.store(0);
+        ctx->leasedCount.fetch_sub(1);
+        return SC_INVALID_PARAM;
+    }
+
+    // ɺ󷢲ظĲֻƥѷĲ
+    slot.refCount.store(1);
+    slot.leasedData.store(slot.image.pData);
+    *pImage = slot.image;
+    *pLease = static_cast<FrameLease>(&slot);
+    return SC_OK;
+}
+
+/// <summary>
+/// 黹֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="lease">Camera_LeaseFrameص</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - ü1ʱSDKص
+/// - ̵߳
+/// - 黹pDataʧЧ
+/// </remarks>
+REVEALER_API ErrorCode Camera_ReturnFrame(CameraHandle handle, FrameLease lease)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !lease) return -1;
+
+    // Уڸ
+    FrameLeaseSlot* pSlot = static_cast<FrameLeaseSlot*>(lease);
+    if (pSlot < ctx->leaseSlots || pSlot >= ctx->leaseSlots + kMaxLeaseSlots)
+        return SC_INVALID_PARAM;
+    if (pSlot->state.load() != 1 || !DropLeaseReference(ctx, *pSlot))
+        return SC_INVALID_FRAME_HANDLE;
+
+    return SC_OK;
+}
+
+/// <summary>
+/// ÿͬʱ֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="maxCount">ޣΧ[0, 64]0ʾֹ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - Ӱ֮裬֡Ӱ
+/// - SDK֡ռSDKСCamera_SetBufferCountõ
+///   SDK޿û֡
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetMaxLeasedFrames(CameraHandle handle, unsigned int maxCount)
+{
+    ContextScope ctx(handle);
+    if (!ctx || maxCount > kMaxLeaseSlots) return -1;
+
+    ctx->maxLeasedFrames.store(maxCount);
+    return SC_OK;
+}
+
+/// <summary>
+/// ȡͼͬʽ
+/// ;ȡSDKͼͼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pImage">ͼ</param>
+/// <param name="timeout">ʱʱ䣨룩</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ͼ
+/// - /Աȶ/Gamma
+/// - αӳ
+/// - ת/ת
+/// - ɫ׵
+/// 
+/// ʹ̣
+/// 1. Camera_SetImageProcessingEnabledô
+/// 2. Camera_SetImageProcessingValueò
+/// 3. ñȡͼ
+/// 
+/// ע⣺
+/// - ҪCPUʱ
+/// - ͬҪReleaseFrameͷ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetProcessedFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pImage) return -1;
+    SC_DEV_HANDLE sdkHandle = ctx->sdkHandle;
+
+    SC_Frame frame;
+    frame.pData = nullptr;
+
+    // ȡͼ
+    int ret = SC_GetProcessedFrame(sdkHandle, &frame, timeout);
+    if (ret != SC_OK) return ret;
+
+    // ֤Ч
+    if (frame.frameInfo.width == 0 || frame.frameInfo.height == 0 ||
+        frame.frameInfo.size == 0 || !frame.pData)
+    {
+        SC_ReleaseFrame(sdkHandle, &frame);
+        return -1;
+    }
+
+    RecordFrameStats(ctx->processedStats, frame);
+
+    // ֡ģʽƵ֡ز۲黹SDK֡
+    if (ctx->framePool.enabled.load())
+    {
+        ret = CopyFrameToPool(ctx, frame, pImage);
+        SC_ReleaseFrame(sdkHandle, &frame);
+        return ret;
+    }
+
+    // 
+    FillImageData(frame, pImage);
+    TrackSdkFrame(ctx, frame);
+
+    return SC_OK;
+}
+
+// =================================================================
+// ɼ
+// =================================================================
+
+/// <summary>
+/// ɼ
+/// ;ɱɼ߳ȡԭʼ֡ƵнУԼ߳ȡ֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="queueCapacity">֡Χ[1, 1024]ȡΪ2</param>
+/// <param name="overflowPolicy">ʱĲԣOverflowPolicy</param>
+/// <returns>SC_OK(0)ʾɹSC_BUSYʾ</returns>
+/// <remarks>
+/// صʽ
+/// - ûʱֻʹлѹSDKȡ֡
+/// - SDK֡ƺ黹SDKľ
+/// 
+/// ʱĲԣ
+/// - OverflowPolicy_DropOldestɵ֡ʺʵʱʾ
+/// - OverflowPolicy_DropNewestµ֤֡Ŷӵ֡
+/// - OverflowPolicy_Blockɼ̵߳ȴߣSDKеѹ
+/// 
+/// ע⣺
+/// - Camera_AttachRawGrabbingñɼ̣߳߿ͬʱʹ
+/// - Camera_GetFrame⣬ֻѡһ
+/// - лһ֡ĴС䣬޸ROI/ظʽ
+/// </remarks>
+REVEALER_API ErrorCode Camera_StartAcquisition(CameraHandle handle, unsigned int queueCapacity, int overflowPolicy)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
+
+    int ret = ctx->frameQueue.Open(queueCapacity, overflowPolicy);
+    if (ret != SC_OK) return ret;
+
+    StartGrabThread(ctx);
+    return SC_OK;
+}
+
+/// <summary>
+/// ֹͣɼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - ڵȴCamera_PopFrameSC_INVALID_RESOURCE
+/// - ֮ǰȡ֮֡ʧЧ
+/// - Ӱԭʼͼص
+/// </remarks>
+REVEALER_API ErrorCode Camera_StopAcquisition(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
+
+    // ֹͣߣٹرն
+    StopGrabThread(ctx);
+    ctx->frameQueue.Close();
+
+    // ԭʼͼص򱾿¼ʹʱɼ߳
+    if (IsGrabThreadNeeded(ctx)) StartGrabThread(ctx);
+    return SC_OK;
+}
+
+/// <summary>
+/// Ӳɼȡһ֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pImage">ͼ</param>
+/// <param name="timeout">ʱʱ䣨룩0ʾȴ0xFFFFFFFFʾ޵ȴ</param>
+/// <returns>SC_OK(0)ʾɹSC_TIMEOUTʾʱSC_INVALID_RESOURCEʾδ</returns>
+/// <remarks>
+/// - pDataָ򱾿⻺һCamera_PopFrameCamera_StopAcquisitionǰЧ
+/// - Camera_ReleaseFrame
+/// - ֻһ̵߳
+/// </remarks>
+REVEALER_API ErrorCode Camera_PopFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pImage) return -1;
+
+    return ctx->frameQueue.Pop(pImage, timeout);
+}
+
+/// <summary>
+/// ȡɼ״̬
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pDroppedFrames">֡Ϊnullptr</param>
+/// <param name="pQueuedFrames">ǰŶӵ֡Ϊnullptr</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+REVEALER_API ErrorCode Camera_GetAcquisitionStatus(CameraHandle handle, unsigned long long* pDroppedFrames,
+    unsigned int* pQueuedFrames)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    if (pDroppedFrames) *pDroppedFrames = ctx->frameQueue.GetDroppedCount();
+    if (pQueuedFrames) *pQueuedFrames = ctx->frameQueue.IsOpen() ? ctx->frameQueue.GetCount() : 0;
+    return SC_OK;
+}
+
+// =================================================================
+// ͳ
+// =================================================================
+
+/// <summary>
+/// ȡͳ
+/// ;λ֡·/SDKǱ֮
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="streamType">StreamType</param>
+/// <param name="pStatistics">ͳ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ֡Ķλ
+/// - framesLost֡ID֡ڵﱾ֮ǰʧ·SDKľ
+/// - queueDroppedFrames֡ѵﱾ⣬ɼߴ
+/// 
+/// ֱͼ
+/// - kͰͳ[2^k, 2^(k+1))0Ͱͬʱ0һͰиֵ
+/// - intervalHistogram֡ʱλImageData.timeStampͬ
+/// - callbackHistogramûصִʱ䣬λΪ΢
+/// 
+/// ע⣺
+/// - ȡ֡·ԭӲۼӣȡʱֶ֮䲻֤ͬһʱ̵Ŀ
+/// - ռãqueuedFrames/leasedFrames/poolHeldFramesstreamType޹
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetStreamStatistics(CameraHandle handle, int streamType, StreamStatistics* pStatistics)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pStatistics) return -1;
+
+    StreamStats* stats = nullptr;
+    switch (streamType)
+    {
+    case StreamType_Raw: stats = &ctx->rawStats; break;
+    case StreamType_Processed: stats = &ctx->processedStats; break;
+    default: return SC_INVALID_PARAM;
+    }
+
+    memset(pStatistics, 0, sizeof(StreamStatistics));
+
+    pStatistics->framesDelivered = stats->framesDelivered.load(std::memory_order_relaxed);
+    pStatistics->framesLost = stats->framesLost.load(std::memory_order_relaxed);
+
+    unsigned long long lastBlockId = stats->lastBlockId.load(std::memory_order_relaxed);
+    pStatistics->lastBlockId = (lastBlockId == kNoBlockId) ? 0 : lastBlockId;
+
+    static_assert(sizeof(pStatistics->intervalHistogram) / sizeof(pStatistics->intervalHistogram[0]) == kStreamHistogramBins,
+        "StreamStatistics histogram size mismatch");
+    for (unsigned int i = 0; i < kStreamHistogramBins; i++)
+    {
+        pStatistics->intervalHistogram[i] = stats->intervalHistogram[i].load(std::memory_order_relaxed);
+        pStatistics->callbackHistogram[i] = stats->callbackHistogram[i].load(std::memory_order_relaxed);
+    }
+    pStatistics->callbackMaxMicroseconds = stats->callbackMaxMicroseconds.load(std::memory_order_relaxed);
+
+    // ռ
+    pStatistics->queueDroppedFrames = ctx->frameQueue.GetDroppedCount();
+    if (ctx->frameQueue.IsOpen())
+    {
+        pStatistics->queuedFrames = ctx->frameQueue.GetCount();
+        pStatistics->queueCapacity = ctx->frameQueue.GetCapacity();
+    }
+    pStatistics->leasedFrames = ctx->leasedCount.load();
+    {
+        std::lock_guard<std::mutex> lock(ctx->framePool.lock);
+        pStatistics->poolHeldFrames = ctx->framePool.heldCount;
+        pStatistics->poolCapacity = ctx->framePool.slotCount;
+    }
+    return SC_OK;
+}
+
+/// <summary>
+/// ͳƣͬʱ㣬ӰɼеĶ֡
+/// </summary>
+REVEALER_API ErrorCode Camera_ResetStreamStatistics(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    ctx->rawStats.Reset();
+    ctx->processedStats.Reset();
+    return SC_OK;
+}
+
+/// <summary>
+/// ¼״̬֪ͨSDK֪ͨõ״̬ص
+/// </summary>
+static void OnRecorderNotify(int status, int progress, void* pUser)
+{
+    CameraContext* ctx = static_cast<CameraContext*>(pUser);
+
+    CallbackScope scope(ctx->exportSlot);
+    if (scope.valid)
+    {
+        ExportEventCallBack callback = reinterpret_cast<ExportEventCallBack>(scope.info.userCallback);
+        callback(status, progress, scope.info.userData);
+    }
+}
+
+/// <summary>
+/// ƴӱ¼Ƶļ·directory\fileNameļûչʱdefaultExtension
+/// </summary>
+static std::string BuildRecordPath(const std::string& directory, const RecordParam* pParam,
+    const char* defaultExtension)
+{
+    std::string path;
+    if (!directory.empty())
+    {
+        path = directory;
+        char last = path[path.size() - 1];
+        if (last != '\\' && last != '/') path += '\\';
+    }
+    path += pParam->fileName;
+
+    const char* name = pParam->fileName;
+    const char* slash = strrchr(name, '\\');
+    if (slash) name = slash + 1;
+    slash = strrchr(name, '/');
+    if (slash) name = slash + 1;
+    if (!strchr(name, '.')) path += defaultExtension;
+    return path;
+}
+
+/// <summary>
+/// recordFilePath'|'ָĿ¼ԣȫΪʱһĿ¼fileName
+/// </summary>
+static std::vector<std::string> SplitRecordDirectories(const char* recordFilePath)
+{
+    std::vector<std::string> directories;
+    const char* begin = recordFilePath;
+    for (;;)
+    {
+        const char* end = strchr(begin, kRecordPathSeparator);
+        size_t length = end ? static_cast<size_t>(end - begin) : strlen(begin);
+        if (length > 0) directories.push_back(std::string(begin, length));
+        if (!end) break;
+        begin = end + 1;
+    }
+    if (directories.empty()) directories.push_back(std::string());
+    return directories;
+}
+
+/// <summary>
+/// Ա¼ʼ¼ƣRecordFormat_Raw/RecordFormat_RawLZ4/RecordFormat_BigTIFF
+/// ͬһʱֻһ¼
+/// - startFrame/startTimeStamp0ʱļָ֡ʼд
+/// - count0ʱ¼Զرļͨ״̬صϱ(2)/ر(3)
+/// - ԭʼʽrecordFilePath'|'ָĶĿ¼ÿĿ¼дһļ̵ͬ֡
+/// </summary>
+static ErrorCode OpenNativeRecord(CameraContext* ctx, const RecordParam* pParam)
+{
+    if (!pParam->fileName[0]) return SC_INVALID_PARAM;
+
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
+
+    RecordSchedule& schedule = ctx->recordSchedule;
+    if (schedule.state.load() != RecordState_Idle) return SC_BUSY;
+
+    // һ¼Զرյļ߳
+    if (schedule.monitor.joinable()) schedule.monitor.join();
+
+    std::vector<std::string> directories = SplitRecordDirectories(pParam->recordFilePath);
+    if (directories.size() > kMaxRecordStripes) return SC_INVALID_PARAM;
+
+    int ret;
+    if (pParam->recordFormat == RecordFormat_BigTIFF)
+    {
+        // BigTIFFΪļ֧
+        if (directories.size() > 1) return SC_NOT_SUPPORT;
+        ret = ctx->tiffRecorder.Open(BuildRecordPath(directories[0], pParam, ".tif").c_str(), OnRecorderNotify, ctx);
+    }
+    else
+    {
+        std::vector<std::string> paths;
+        const char* pathPointers[kMaxRecordStripes];
+        for (size_t i = 0; i < directories.size(); i++)
+        {
+            paths.push_back(BuildRecordPath(directories[i], pParam, ".rvr"));
+        }
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            pathPointers[i] = paths[i].c_str();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(ctx->recordSpillLock);
+            ctx->recorder.SetSpillPolicy(ctx->recordSpill);
+        }
+        ctx->recorder.SetCheckpoint(ctx->recordCheckpointFrames.load(), ctx->recordCheckpointMilliseconds.load());
+
+        int codec = pParam->recordFormat == RecordFormat_RawLZ4 ? RawCodec_Lz4 : RawCodec_None;
+        ret = ctx->recorder.Open(pathPointers, static_cast<unsigned int>(paths.size()), OnRecorderNotify, ctx, codec);
+    }
+    if (ret != SC_OK) return ret;
+
+    // stateΪIdleʱɼ̲߳ȡȲֱ
+    schedule.startBlockId = pParam->startFrame;
+    schedule.startTimeStamp = pParam->startTimeStamp;
+    schedule.count = pParam->count;
+    schedule.recordedFrames = 0;
+    schedule.result.store(SC_OK);
+
+    bool immediate = pParam->startFrame == 0 && pParam->startTimeStamp == 0;
+    schedule.state.store(immediate ? RecordState_Recording : RecordState_Armed);
+    schedule.monitor = std::thread(RecordMonitorProc, ctx);
+
+    StartGrabThread(ctx);
+    return SC_OK;
+}
+
+REVEALER_API ErrorCode Camera_OpenRecord(CameraHandle handle, RecordParam* pParam)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pParam) return -1;
+
+    // ¼ƣɲɼ߳ȡ֡д̣SDKĵ
+    if (pParam->recordFormat == RecordFormat_Raw || pParam->recordFormat == RecordFormat_RawLZ4 ||
+        pParam->recordFormat == RecordFormat_BigTIFF)
+    {
+        return OpenNativeRecord(ctx, pParam);
+    }
+
+    // תΪSDK¼ṹ
+    SC_RecordParam recordParam;
+
+    // ע⣺SDKRecordParamʹrecordFilePathfileNameֱ洢·ļ
+    // ǼΪһfileNameֶΣҪ·ļ
+
+    // 򻯴fileName·
+    // õķʽǷ·ļȼ򵥴
+    strncpy_s(recordParam.fileName, sizeof(recordParam.fileName),
+        pParam->fileName, _TRUNCATE);
+
+    // Ҫ·ļ
+    // ҵһ·ָ
+    // const char* lastSlash = strrchr(pParam->fileName, '\\');
+    // if (!lastSlash) lastSlash = strrchr(pParam->fileName, '/');
+    // if (lastSlash) {
+    //     size_t pathLen = lastSlash - pParam->fileName;
+    //     strncpy_s(recordParam.recordFilePath, pathLen + 1, pParam->fileName, pathLen);
+    //     strncpy_s(recordParam.fileName, sizeof(recordParam.fileName), lastSlash + 1, _TRUNCATE);
+    // }
+
+    // SDK¼ְֻ֧֡ſʼ
+    if (pParam->startTimeStamp != 0) return SC_NOT_SUPPORT;
+
+    // 
+    recordParam.recordFormat = static_cast<SC_EVideoType>(pParam->recordFormat);
+    recordParam.quality = pParam->quality;
+    recordParam.frameRate = static_cast<float>(pParam->frameRate);
+    recordParam.startFrame = pParam->startFrame;
+    recordParam.count = pParam->count;   // 0ʾ¼
+    recordParam.saveImageType = eOriginalImage; // ¼ԭʼͼ
+
+    return SC_OpenRecord(sdkHandle, &recordParam);
+}
+
+/// <summary>
+/// ر¼
+/// </summary>
+/// <param name="handle">豸</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - ֹͣ¼񲢹رļ
+/// - ļᱻȷfinalize
+/// - ԰ȫ¼Ƶļ
+/// </remarks>
+REVEALER_API ErrorCode Camera_CloseRecord(CameraHandle handle)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
+
+    {
+        LifecycleScope lifecycle(ctx);
+        if (!lifecycle) return SC_BUSY;
+
+        if (ctx->recordSchedule.state.load() != RecordState_Idle || ctx->recordSchedule.monitor.joinable())
+        {
+            // ɼ̹߳رļ¼CloseȴеPush˳ɼֹ߳ͣ
+            // ¼Զرʱֻռ̣߳صʱرļĽ
+            int ret = FinishNativeRecord(ctx);
+            if (!IsGrabThreadNeeded(ctx)) StopGrabThread(ctx);
+            return ret;
+        }
+    }
+
+    return SC_CloseRecord(sdkHandle);
+}
+
+/// <summary>
+/// õʱʹõĻС
+/// Żͼ񵼳
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="cacheSizeInByte">Сֽڣ
+///   Ƽֵ100MB - 1GB
+///   ȡڿڴ͵ٶ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+REVEALER_API ErrorCode Camera_SetExportCacheSize(CameraHandle handle, unsigned long long cacheSizeInByte)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
+    return SC_SetExportCacheSize(sdkHandle, cacheSizeInByte);
+}
+
+/// <summary>
+/// ñԭʼ¼ƣRecordFormat_Raw/RawLZ4Ļѹ
+/// ;̸ʱڶ֮֡ǰڴաϡǰ澯
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pParam">ѹnullptrʾָĬ</param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_PARAMʾΧ</returns>
+/// <remarks>
+/// - ѹٷֱ = δдֽ / ÿ128MBд̻ + ڴ㣩¼Ϊ֮
+/// - RecordSpill_Memoryڴڴ¼ʱһԷ䣬ʧʱCamera_OpenRecordSC_NO_MEMORY
+/// - RecordSpill_DecimateѹԽֵÿdecimation֡1ֱ֡ѹ䵽ֵһ
+/// - notify0ʱԽֵ/ʱڲɼ߳еõ״̬صstatus=4/5progress=ѹٷֱȣ
+/// - ڽе¼ƲЧ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetRecordSpillPolicy(CameraHandle handle, const RecordSpillParam* pParam)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    RecordSpillParam param = pParam ? *pParam : kDefaultRecordSpill;
+    if (param.policy < RecordSpill_Drop || param.policy > RecordSpill_Decimate) return SC_INVALID_PARAM;
+    if (param.thresholdPercent < 1 || param.thresholdPercent > 100) return SC_INVALID_PARAM;
+    if (param.policy == RecordSpill_Decimate && param.decimation < 2) return SC_INVALID_PARAM;
+
+    std::lock_guard<std::mutex> lock(ctx->recordSpillLock);
+    ctx->recordSpill = param;
+    return SC_OK;
+}
+
+/// <summary>
+/// ñԭʼ¼ƣRecordFormat_Raw/RawLZ4
+/// ;̱ϵCamera_RecoverRecordingδرյ¼ָΪɶȡļ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="frameInterval">һд֡ﵽֵʱд㣬0ʾ֡</param>
+/// <param name="milliseconds">һʱﵽֵʱд㣬0ʾʱ䣻Ĭ1000</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - д¼ļԵ"ļ.idx"Уд߳ˢ¼ļ׷д֡ˢ£Ӱɼ߳
+/// - дһд̻64MBжϣʱļ֮Ҳʱжϣ
+///   鳤ʱд֡ʵͣʱд̰߳֡дļ֮дʱǣ
+///   ʱඪʧԼһʱڵ֡
+/// - ߶Ϊ0ʱд㣬ָʱͷɨ֡¼
+/// - رպɾļڽе¼ƲЧ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetRecordCheckpoint(CameraHandle handle, unsigned int frameInterval,
+    unsigned int milliseconds)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    ctx->recordCheckpointFrames.store(frameInterval);
+    ctx->recordCheckpointMilliseconds.store(milliseconds);
+    return SC_OK;
+}
+
+/// <summary>
+/// ȡԭʼ¼Ƶͳ
+/// ;ڶ֮֡ǰִƿѹд̺ʱ䳤diskBusyPercentӽ100
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pStats">¼ͳ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - ԭӲۼӣȡʱֶ֮䲻֤ͬһʱ̵Ŀ
+/// - д̺ʱٷλȡϸֱͼÿ24ͰͰϽ磬25%
+/// - ¼ƽһ¼Ƶͳƣֱһδ¼BigTIFF¼Ʋ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetRecordStats(CameraHandle handle, RecordStats* pStats)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !pStats) return -1;
+
+    ctx->recorder.GetStats(pStats);
+    return SC_OK;
+}
+
+/// <summary>
+/// ԤʷС
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="sizeInBytes">ڴԤ㣨ֽڣ0ʾرղͷڴ
+///   ɱ֡ = Ԥ / ֡С1GBԤ㡢2048x2048 Mono16Լɱ128֡
+/// </param>
+/// <returns>SC_OK(0)ʾɹSC_NO_MEMORYʾڴʧܣʷرգ</returns>
+/// <remarks>
+/// - ɱɼ̰߳ÿԭʼ֡ƽλ֮ÿֻ֡һڴ渴ƣٷڴ
+/// - ڴڱһη䣬һ֡ʱ֡С֣֡С仯޸ROIʱͬһڴ
+///   »֣֮ǰʷ
+/// - ôСеʷ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetHistoryBufferSize(CameraHandle handle, unsigned long long sizeInBytes)
+{
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
+
+    // ʧʱʷѹرգֹͬͣɼ߳
+    int ret = ctx->history.SetBudget(sizeInBytes);
+    if (ret == SC_OK && sizeInBytes > 0)
+    {
+        StartGrabThread(ctx);
+    }
+    else if (!IsGrabThreadNeeded(ctx))
+    {
+        StopGrabThread(ctx);
+    }
+    return ret;
+}
+
+/// <summary>
+/// ʷ֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="path">ļ·.rvrʽCamera_RecordingOpenȡ</param>
+/// <param name="seconds">ʱ֡ﱾʱ䣩Сڵ0ʾȫʷ</param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_RESOURCEʾδʷ</returns>
+/// <remarks>
+/// - ڵ߳ͬд̣ʱļѹرգʷϴʱʱɴ룬UI߳ʹCamera_SaveHistoryAsync
+/// - ɼжϣڼɼ̼߳δ֡ᱻǣ
+///   ʱ֡ݲʷӰصɼк¼ƣ
+/// - Camera_OpenRecord¼ͬʱ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SaveHistory(CameraHandle handle, const char* path, double seconds)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !path) return -1;
+
+    return ctx->history.Save(path, seconds, nullptr);
+}
+
+/// <summary>
+/// 첽ʷ֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="path">ļ·.rvrʽCamera_RecordingOpenȡ</param>
+/// <param name="seconds">ʱ֡ﱾʱ䣩Сڵ0ʾȫʷ</param>
+/// <returns>SC_OK(0)ʾѿʼSC_BUSYʾһ첽δSC_INVALID_RESOURCEʾδʷ</returns>
+/// <remarks>
+/// - Camera_SaveHistoryͬڱı߳д̣߳
+/// - ȺͽͨCamera_SubscribeExportNotifyעĻصϱڱִ߳У
+///   ʼ(0)д֡(1)(2)ر(3ʧʱprogressΪ-1)뱾¼ͬʱʱߵ֪ͨյ
+/// - ͬһʱֻһ첽棻Camera_DestroyHandleȴ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SaveHistoryAsync(CameraHandle handle, const char* path, double seconds)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !path) return -1;
+
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
+
+    if (ctx->historySaving.load()) return SC_BUSY;
+    if (!ctx->history.IsEnabled()) return SC_INVALID_RESOURCE;
+
+    // һѽı߳
+    if (ctx->historySaver.joinable()) ctx->historySaver.join();
+
+    CameraContext* context = ctx;
+    std::string file = path;
+    ctx->historySaving.store(true);
+    ctx->historySaver = std::thread([context, file, seconds]()
+    {
+        context->history.Save(file.c_str(), seconds, nullptr, OnRecorderNotify, context);
+        context->historySaving.store(false);
+    });
+    return SC_OK;
+}
+
+/// <summary>
+/// 첽浥֡
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="path">ļ·Զչ</param>
+/// <param name="format">ոʽSnapshotFormat</param>
+/// <param name="proc">ɻصΪnullptr</param>
+/// <param name="pUser">ûԶ</param>
+/// <returns>SC_OK(0)ʾύSC_BUSYʾеĿѴޣSC_NOT_SUPPORTʾʽ֧</returns>
+/// <remarks>
+/// - ڱ֡صеʱ浱ǰ֡ƣصغSDKɱգ
+/// - ֮󵽴һ֡ɼ߳ʱṩCamera_GetFrameȡ֡ʱȡ֡ṩ
+///   ɱ̴߳SDKȡ֡ɼ̡߳Camera_GetFrame֡
+/// - дڱ߳нУ̺߳Ͳɼ̲߳ȴ
+/// - صڱִ߳УresultΪSC_OKʾļдꣻDestroyHandleǰδɵĿҲص
+/// - ֡ɿղ۸ãȶÿοղڴ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SnapshotAsync(CameraHandle handle, const char* path, int format,
+    SnapshotCallBack proc, void* pUser)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !path) return -1;
+
+    DispatchFrame* dispatch = t_dispatchFrame;
+    if (dispatch && dispatch->ctx == ctx)
+    {
+        ImageData imageData;
+        FillImageData(*dispatch->frame, &imageData);
+        return ctx->snapshot.Submit(&imageData, false, path, format, proc, pUser);
+    }
+
+    bool waitForOffer = ctx->grabActive.load() || ctx->directGrabs.load() > 0;
+    return ctx->snapshot.Submit(nullptr, waitForOffer, path, format, proc, pUser);
+}
+
+// =================================================================
+// 5.6 Բ
+// =================================================================
+
+/// <summary>
+/// Ƿ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName">ƣ"Width""ExposureTime"</param>
+/// <returns>1=ã0=</returns>
+/// <remarks>
+/// Կȡڣ
+/// - ͺź͹̼汾
+/// - ǰ״̬Ƿڲɼ
+/// - ԵãԼ
+/// 
+/// 飺
+/// - ǰȼ
+/// - ʱҪ
+/// </remarks>
+REVEALER_API int Camera_FeatureIsAvailable(CameraHandle handle, const char* featureName)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !featureName) return 0;
+
+    return SC_FeatureIsAvailable(sdkHandle, featureName) ? 1 : 0;
+}
+
+/// <summary>
+/// Ƿɶ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName"></param>
+/// <returns>1=ɶ0=ɶ</returns>
+REVEALER_API int Camera_FeatureIsReadable(CameraHandle handle, const char* featureName)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !featureName) return 0;
+
+    return SC_FeatureIsReadable(sdkHandle, featureName) ? 1 : 0;
+}
+
+/// <summary>
+/// Ƿд
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName"></param>
+/// <returns>1=д0=д</returns>
+/// <remarks>
+/// ĳЩֻ磺
+/// - SensorWidth, SensorHeightߴ磩
+/// - DeviceTemperatureǰ¶ȣ
+/// 
+/// ĳЩڲɼʱд磺
+/// - Width, Height, PixelFormatҪֹͣɼ
+/// </remarks>
+REVEALER_API int Camera_FeatureIsWriteable(CameraHandle handle, const char* featureName)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !featureName) return 0;
+
+    return SC_FeatureIsWriteable(sdkHandle, featureName) ? 1 : 0;
+}
+
+/// <summary>
+/// ȡ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName"></param>
+/// <param name="pType">
+///   0 = Integer   (Width)
+///   1 = Float     (ExposureTime)
+///   2 = Enum      (ö٣PixelFormat)
+///   3 = Bool      (FanSwitch)
+///   4 = String    (ַк)
+///   5 = Command   (TriggerSoftware)
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ;
+/// - ̬Է
+/// - ͨԱ༭
+/// - ԶUI
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetFeatureType(CameraHandle handle, const char* featureName, int* pType)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !featureName || !pType) return -1;
+
+    SC_EFeatureType type;
+    int ret = SC_GetFeatureType(sdkHandle, featureName, &type);
+    if (ret == SC_OK)
+    {
+        *pType = static_cast<int>(type);
+    }
+    return ret;
+}
+
+// -----------------------------------------------------------------
+// ԶдԻ棬ơƺдã
+// ȡлʱֱӷأδʱSDKȡд뻺
+// ãɹԺзΧĻ棻Enum/Bool/StringֵЧֱֵд뻺棬
+//       Integer/FloatֵܱSDK벽´ζȡʱض
+// -----------------------------------------------------------------
+
+static int ReadIntFeature(CameraContext* ctx, const char* name, int field, long long* pValue)
+{
+    if (ctx->featureCache.GetInt(name, FeatureType_Integer, field, pValue)) return SC_OK;
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    int64_t value = 0;
+    int ret;
+    switch (field)
+    {
+    case FeatureCacheField_Min: ret = SC_GetIntFeatureMin(ctx->sdkHandle, name, &value); break;
+    case FeatureCacheField_Max: ret = SC_GetIntFeatureMax(ctx->sdkHandle, name, &value); break;
+    case FeatureCacheField_Inc: ret = SC_GetIntFeatureInc(ctx->sdkHandle, name, &value); break;
+    default: ret = SC_GetIntFeatureValue(ctx->sdkHandle, name, &value); break;
+    }
+    if (ret != SC_OK) return ret;
+
+    *pValue = value;
+    ctx->featureCache.PutInt(name, FeatureType_Integer, field, value, stamp);
+    return SC_OK;
+}
+
+static int ReadFloatFeature(CameraContext* ctx, const char* name, int field, double* pValue)
+{
+    if (ctx->featureCache.GetFloat(name, field, pValue)) return SC_OK;
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    double value = 0;
+    int ret;
+    switch (field)
+    {
+    case FeatureCacheField_Min: ret = SC_GetFloatFeatureMin(ctx->sdkHandle, name, &value); break;
+    case FeatureCacheField_Max: ret = SC_GetFloatFeatureMax(ctx->sdkHandle, name, &value); break;
+    case FeatureCacheField_Inc: ret = SC_GetFloatFeatureInc(ctx->sdkHandle, name, &value); break;
+    default: ret = SC_GetFloatFeatureValue(ctx->sdkHandle, name, &value); break;
+    }
+    if (ret != SC_OK) return ret;
+
+    *pValue = value;
+    ctx->featureCache.PutFloat(name, field, value, stamp);
+    return SC_OK;
+}
+
+static int ReadEnumFeature(CameraContext* ctx, const char* name, unsigned long long* pValue)
+{
+    long long cached = 0;
+    if (ctx->featureCache.GetInt(name, FeatureType_Enum, FeatureCacheField_Value, &cached))
+    {
+        *pValue = static_cast<unsigned long long>(cached);
+        return SC_OK;
+    }
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    uint64_t value = 0;
+    int ret = SC_GetEnumFeatureValue(ctx->sdkHandle, name, &value);
+    if (ret != SC_OK) return ret;
+
+    *pValue = value;
+    ctx->featureCache.PutInt(name, FeatureType_Enum, FeatureCacheField_Value, static_cast<long long>(value), stamp);
+    return SC_OK;
+}
+
+static int ReadEnumSymbol(CameraContext* ctx, const char* name, char* symbol, int symbolSize)
+{
+    if (ctx->featureCache.GetText(name, FeatureType_Enum, FeatureCacheField_Symbol, symbol, symbolSize)) return SC_OK;
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    SC_String str;
+    int ret = SC_GetEnumFeatureSymbol(ctx->sdkHandle, name, &str);
+    if (ret != SC_OK) return ret;
+
+    strncpy_s(symbol, symbolSize, str.str, _TRUNCATE);
+    ctx->featureCache.PutText(name, FeatureType_Enum, FeatureCacheField_Symbol, str.str, stamp);
+    return SC_OK;
+}
+
+static int ReadBoolFeature(CameraContext* ctx, const char* name, int* pValue)
+{
+    long long cached = 0;
+    if (ctx->featureCache.GetInt(name, FeatureType_Bool, FeatureCacheField_Value, &cached))
+    {
+        *pValue = static_cast<int>(cached);
+        return SC_OK;
+    }
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    bool value = false;
+    int ret = SC_GetBoolFeatureValue(ctx->sdkHandle, name, &value);
+    if (ret != SC_OK) return ret;
+
+    *pValue = value ? 1 : 0;
+    ctx->featureCache.PutInt(name, FeatureType_Bool, FeatureCacheField_Value, *pValue, stamp);
+    return SC_OK;
+}
+
+static int ReadStringFeature(CameraContext* ctx, const char* name, char* pValue, int valueSize)
+{
+    if (ctx->featureCache.GetText(name, FeatureType_String, FeatureCacheField_Value, pValue, valueSize)) return SC_OK;
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    SC_String str;
+    int ret = SC_GetStringFeatureValue(ctx->sdkHandle, name, &str);
+    if (ret != SC_OK) return ret;
+
+    strncpy_s(pValue, valueSize, str.str, _TRUNCATE);
+    ctx->featureCache.PutText(name, FeatureType_String, FeatureCacheField_Value, str.str, stamp);
+    return SC_OK;
+}
+
+static int WriteIntFeature(CameraContext* ctx, const char* name, long long value)
+{
+    int ret = SC_SetIntFeatureValue(ctx->sdkHandle, name, value);
+    if (ret == SC_OK) ctx->featureCache.Invalidate(name);
+    return ret;
+}
+
+static int WriteFloatFeature(CameraContext* ctx, const char* name, double value)
+{
+    int ret = SC_SetFloatFeatureValue(ctx->sdkHandle, name, value);
+    if (ret == SC_OK) ctx->featureCache.Invalidate(name);
+    return ret;
+}
+
+static int WriteEnumFeature(CameraContext* ctx, const char* name, unsigned long long value)
+{
+    int ret = SC_SetEnumFeatureValue(ctx->sdkHandle, name, value);
+    if (ret == SC_OK) ctx->featureCache.WriteInt(name, FeatureType_Enum, static_cast<long long>(value));
+    return ret;
+}
+
+static int WriteEnumSymbol(CameraContext* ctx, const char* name, const char* symbol)
+{
+    int ret = SC_SetEnumFeatureSymbol(ctx->sdkHandle, name, symbol);
+    if (ret == SC_OK) ctx->featureCache.WriteText(name, FeatureType_Enum, FeatureCacheField_Symbol, symbol);
+    return ret;
+}
+
+static int WriteBoolFeature(CameraContext* ctx, const char* name, int value)
+{
+    int ret = SC_SetBoolFeatureValue(ctx->sdkHandle, name, value != 0);
+    if (ret == SC_OK) ctx->featureCache.WriteInt(name, FeatureType_Bool, value != 0 ? 1 : 0);
+    return ret;
+}
+
+static int WriteStringFeature(CameraContext* ctx, const char* name, const char* value)
+{
+    int ret = SC_SetStringFeatureValue(ctx->sdkHandle, name, value);
+    if (ret == SC_OK) ctx->featureCache.WriteText(name, FeatureType_String, FeatureCacheField_Value, value);
+    return ret;
+}
+
+/// <summary>
+/// ȡöԵĿֵԻʱδʧЧıֱӷأ
+/// </summary>
+static int LoadEnumTable(CameraContext* ctx, const char* name, const EnumEntry** ppEntries, unsigned int* pCount)
+{
+    if (ctx->featureCache.GetEnumTable(name, ppEntries, pCount)) return SC_OK;
+
+    unsigned long long stamp = ctx->featureCache.Stamp();
+    unsigned int count = 0;
+    int ret = SC_GetEnumFeatureEntryNum(ctx->sdkHandle, name, &count);
+    if (ret != SC_OK) return ret;
+
+    std::vector<SC_EnumEntryInfo> infos(count);
+    std::vector<EnumEntry> entries(count);
+    if (count > 0)
+    {
+        SC_EnumEntryList entryList;
+        entryList.enumEntryBufferSize = count;
+        entryList.pEnumEntryInfo = infos.data();
+        ret = SC_GetEnumFeatureEntrys(ctx->sdkHandle, name, &entryList);
+        if (ret != SC_OK) return ret;
+
+        count = entryList.enumEntryBufferSize < count ? entryList.enumEntryBufferSize : count;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            infos[i].name[sizeof(infos[i].name) - 1] = '\0';
+            entries[i].value = infos[i].value;
+            entries[i].symbol = infos[i].name;
+        }
+    }
+
+    *ppEntries = ctx->featureCache.PutEnumTable(name, entries.data(), count, stamp);
+    *pCount = count;
+    return SC_OK;
+}
+
+/// <summary>
+/// ִԣӰ첻֪ûãִкԻ棨⣩
+/// </summary>
+static int ExecuteCommand(CameraContext* ctx, const char* name)
+{
+    int ret = SC_ExecuteCommandFeature(ctx->sdkHandle, name);
+    if (ret == SC_OK && strcmp(name, "TriggerSoftware") != 0) ctx->featureCache.Clear();
+    return ret;
+}
+
+// =================================================================
+// IntegerԲ
+// =================================================================
+
+/// <summary>
+/// ȡֵ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName"></param>
+/// <param name="pValue">ֵ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ԣ
+/// - Width, Height: ͼߴ
+/// - OffsetX, OffsetY: ͼƫ
+/// - SensorWidth, SensorHeight: ߴ磨ֻ
+/// - DeviceTemperatureTarget: Ŀ¶
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetIntFeatureValue(CameraHandle handle, const char* featureName, long long* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadIntFeature(ctx, featureName, FeatureCacheField_Value, pValue);
+}
+
+/// <summary>
+/// ȡСֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetIntFeatureMin(CameraHandle handle, const char* featureName, long long* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadIntFeature(ctx, featureName, FeatureCacheField_Min, pValue);
+}
+
+/// <summary>
+/// ȡֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetIntFeatureMax(CameraHandle handle, const char* featureName, long long* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadIntFeature(ctx, featureName, FeatureCacheField_Max, pValue);
+}
+
+/// <summary>
+/// ȡԲֵ
+/// </summary>
+/// <remarks>
+/// ֵ˵
+/// - ЧֵǣMin + N * IncNΪ
+/// - 磺Min=0, Max=1000, Inc=4
+///   Чֵ0, 4, 8, 12, ..., 1000
+/// 
+/// ʱSDKԶЧֵ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetIntFeatureInc(CameraHandle handle, const char* featureName, long long* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadIntFeature(ctx, featureName, FeatureCacheField_Inc, pValue);
+}
+
+/// <summary>
+/// ֵ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName"></param>
+/// <param name="value">Ҫõֵ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ҪʾμSDKĵ3.3ڣ
+/// 
+/// 1. ĳԿӰ
+///    磺WidthӰAcquisitionFrameRate
+/// 
+/// 2. ֵԶֵᱻϷΧ
+///    - 뵽ֵInc
+///    - Min-MaxΧ
+/// 
+/// 3. ضȷϣú¶ȡʵЧֵ
+///    ȷ
+///    Camera_SetIntFeatureValue(handle, "Width", 1000);
+///    Camera_GetIntFeatureValue(handle, "Width", &actualWidth);
+///    // actualWidthܲ10001004Inc
+/// 
+/// 4. ӰԣοSDKĵ3.3.1
+///    ʹSC_SubscribeParamUpdateArgصȡ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetIntFeatureValue(CameraHandle handle, const char* featureName, long long value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName) return -1;
+
+    return WriteIntFeature(ctx, featureName, value);
+}
+
+// =================================================================
+// FloatԲ
+// =================================================================
+
+/// <summary>
+/// ȡֵ
+/// </summary>
+/// <remarks>
+/// ԣ
+/// - ExposureTime: عʱ䣨΢룩
+/// - AcquisitionFrameRate: ɼ֡ʣfps
+/// - TriggerDelay: ӳ٣΢룩
+/// - DeviceTemperature: ǰ¶ȣ棬ֻ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetFloatFeatureValue(CameraHandle handle, const char* featureName, double* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadFloatFeature(ctx, featureName, FeatureCacheField_Value, pValue);
+}
+
+/// <summary>
+/// ȡСֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetFloatFeatureMin(CameraHandle handle, const char* featureName, double* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadFloatFeature(ctx, featureName, FeatureCacheField_Min, pValue);
+}
+
+/// <summary>
+/// ȡֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetFloatFeatureMax(CameraHandle handle, const char* featureName, double* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadFloatFeature(ctx, featureName, FeatureCacheField_Max, pValue);
+}
+
+/// <summary>
+/// ȡԲֵУ
+/// </summary>
+/// <remarks>
+/// ע⣺иԶвֵ
+/// 0ܱʾ޲
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetFloatFeatureInc(CameraHandle handle, const char* featureName, double* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadFloatFeature(ctx, featureName, FeatureCacheField_Inc, pValue);
+}
+
+/// <summary>
+/// øֵ
+/// </summary>
+/// <remarks>
+/// ע⣺ͬѭ򣨼SetIntFeatureValueעͣ
+/// 
+/// ˵
+/// - ExposureTimeAcquisitionFrameRateӰ
+/// - úضȷʵֵ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetFloatFeatureValue(CameraHandle handle, const char* featureName, double value)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_SetBufferCount(sdkHandle, bufferCount);
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName) return -1;
+
+    return WriteFloatFeature(ctx, featureName, value);
 }
 
+// =================================================================
+// EnumöԲ
+// =================================================================
+
 /// <summary>
-/// ȡһ֡ͼͬʽ
+/// ȡöֵ
+/// </summary>
+/// <param name="pValue">öֵ</param>
+/// <remarks>
+/// öԣμGloria 4.2Ա
+/// 
+/// BinningModeϲģʽ
+///   0 = OneByOne (1x1)
+///   1 = TwoByTwo (2x2)
+///   2 = FourByFour (4x4)
+/// 
+/// PixelFormatظʽ
+///   17825797 = Mono12
+///   17563719 = Mono12p
+///   17825799 = Mono16
+/// 
+/// ReadoutModeģʽ
+///   0 = bit11_HS_Low (11λٵ)
+///   1 = bit11_HS_High (11λٸ)
+///   6 = bit12_CMS (12λ)
+///   7 = bit16_From11 (16λ߶̬)
+/// 
+/// FrameRateEnable֡ʹܣ
+///   0 = FALSE
+///   1 = TRUE
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetEnumFeatureValue(CameraHandle handle, const char* featureName, unsigned long long* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadEnumFeature(ctx, featureName, pValue);
+}
+
+/// <summary>
+/// öֵ
+/// </summary>
+/// <param name="value">öֵ</param>
+/// <remarks>
+/// ʹʾ
+/// // ظʽΪMono16
+/// Camera_SetEnumFeatureValue(handle, "PixelFormat", 17825799);
+/// 
+/// // öģʽΪģʽ
+/// Camera_SetEnumFeatureValue(handle, "ReadoutMode", 6);
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetEnumFeatureValue(CameraHandle handle, const char* featureName, unsigned long long value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName) return -1;
+
+    return WriteEnumFeature(ctx, featureName, value);
+}
+
+/// <summary>
+/// ȡöԵĿѡֵ
+/// </summary>
+/// <param name="pNum">ѡֵ</param>
+/// <remarks>
+/// ;
+/// - ̬UIб
+/// - пѡֵ
+/// 
+/// ԻʱȡͬʱȡűCamera_GetEnumFeatureEntrysٷ豸
+/// δʱֻȡ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetEnumFeatureEntryNum(CameraHandle handle, const char* featureName, unsigned int* pNum)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pNum) return -1;
+
+    // ᱻʱΪȡűֻһ豸
+    if (!ctx->featureCache.IsEnabled()) return SC_GetEnumFeatureEntryNum(ctx->sdkHandle, featureName, pNum);
+
+    const EnumEntry* entries = nullptr;
+    return LoadEnumTable(ctx, featureName, &entries, pNum);
+}
+
+/// <summary>
+/// ȡöԵĿöֵб
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="pImage">ͼݽṹ</param>
-/// <param name="timeout">ʱʱ䣨룩
-///   0xFFFFFFFF = ޵ȴ
-///   0 = 
-///   ֵ = ȴָ
-/// </param>
+/// <param name="featureName"></param>
+/// <param name="pEntryNum">ʱΪСʱΪʵʻȡ</param>
+/// <param name="pEnumValues">öֵ飬Ϊnullptrѯ</param>
+/// <param name="pSymbols">飬Ϊnullptr</param>
+/// <param name="symbolSize">ÿƵĻС</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// Ҫ
-/// 1. pImage->pDataָSDKڲڴ
-/// 2. C#˱
-/// 3. Camera_ReleaseFrameͷ
-/// 4. ͷŻᵼڴй©ͻľ
+/// ÷ã
 /// 
-/// ͼݽṹ
-/// - width, height: ͼߴ
-/// - stride: ÿֽ!=width*pixelSize
-/// - pixelFormat: ظʽöٶ壩
-/// - pData: ͼָ
-/// - dataSize: ܴС
-/// - blockId: ֡ţ0ʼ
-/// - timeStamp: ʱڲʱӣ
+/// // һȡ
+/// unsigned int count = 0;
+/// Camera_GetEnumFeatureEntryNum(handle, "PixelFormat", &count);
+/// 
+/// // ڶȡб
+/// uint64_t* values = new uint64_t[count];
+/// char** symbols = new char*[count];
+/// for(int i=0; i<count; i++) symbols[i] = new char[256];
+/// unsigned int actualCount = count;
+/// Camera_GetEnumFeatureEntrys(handle, "PixelFormat", &actualCount, values, symbols, 256);
+/// 
+/// ע⣺
+/// - ȵCamera_GetEnumFeatureEntryNumȡȷ
+/// - pEntryNumΪʱʾСΪʾʵ
+/// - ҪʱCamera_GetEnumFeatureTableֱȡеı
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetEnumFeatureEntrys(CameraHandle handle, const char* featureName,
+    unsigned int* pEntryNum, unsigned long long* pEnumValues, char** pSymbols, int symbolSize)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pEntryNum) return -1;
+
+    const EnumEntry* entries = nullptr;
+    unsigned int count = 0;
+    int ret = LoadEnumTable(ctx, featureName, &entries, &count);
+    if (ret != SC_OK) return ret;
+
+    // ѯֱӷر
+    if (pEnumValues == nullptr)
+    {
+        *pEntryNum = count;
+        return SC_OK;
+    }
+
+    // ݣิƻС
+    if (count > *pEntryNum) count = *pEntryNum;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        pEnumValues[i] = entries[i].value;
+
+        // Ҫṩ˻
+        if (pSymbols != nullptr && pSymbols[i] != nullptr && symbolSize > 0)
+        {
+            strncpy_s(pSymbols[i], symbolSize, entries[i].symbol, _TRUNCATE);
+        }
+    }
+
+    // ʵ
+    *pEntryNum = count;
+    return SC_OK;
+}
+
+/// <summary>
+/// ȡöԵĿֵƣ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName"></param>
+/// <param name="ppEntries">ֵͷţֻ</param>
+/// <param name="pCount"></param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ;UIˢбReadoutModePixelFormatȣʱٷ仺
+/// 
+/// - ͷַɱУ٣Camera_DestroyHandleǰһֱЧݲ䣻
+///   ֵ仯󷵻±ָȻЧ
+/// - ͬıͬһָ룬ָȽжбǷҪؽ
+/// - Ի棨Camera_SetFeatureCacheEnabledʱڴһζȡ
+///   »صԺ¶ȡδʱÿεö豸ȡ
+/// 
+/// ʹʾ
+/// const EnumEntry* entries; unsigned int count;
+/// Camera_GetEnumFeatureTable(handle, "PixelFormat", &entries, &count);
+/// for (unsigned int i = 0; i < count; i++) printf("%s\n", entries[i].symbol);
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetEnumFeatureTable(CameraHandle handle, const char* featureName,
+    const EnumEntry** ppEntries, unsigned int* pCount)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !ppEntries || !pCount) return -1;
+
+    return LoadEnumTable(ctx, featureName, ppEntries, pCount);
+}
+
+/// <summary>
+/// ȡöԵķƣַʽ
+/// </summary>
+/// <param name="symbol">ƻ</param>
+/// <param name="symbolSize">С</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// صǰֵķƣ磺
+/// - BinningMode: "TwoByTwo"
+/// - PixelFormat: "Mono16"
+/// - ReadoutMode: "bit12_CMS"
+/// 
+/// Ʊָ׶ʺ־UIʾ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetEnumFeatureSymbol(CameraHandle handle, const char* featureName, char* symbol, int symbolSize)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !symbol) return -1;
+
+    return ReadEnumSymbol(ctx, featureName, symbol, symbolSize);
+}
+
+/// <summary>
+/// ͨö
+/// </summary>
+/// <param name="symbol">ƣ"Mono16"</param>
+/// <remarks>
+/// ʹʾ
+/// Camera_SetEnumFeatureSymbol(handle, "PixelFormat", "Mono16");
+/// Camera_SetEnumFeatureSymbol(handle, "BinningMode", "TwoByTwo");
+/// 
+/// ʹָҪ֪ȷķ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetEnumFeatureSymbol(CameraHandle handle, const char* featureName, const char* symbol)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !symbol) return -1;
+
+    return WriteEnumSymbol(ctx, featureName, symbol);
+}
+
+// =================================================================
+// BoolԲ
+// =================================================================
+
+/// <summary>
+/// ȡֵ
+/// </summary>
+/// <param name="pValue">1=true, 0=false</param>
+/// <remarks>
+/// ԣ
+/// - FanSwitch: ȿ
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetBoolFeatureValue(CameraHandle handle, const char* featureName, int* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadBoolFeature(ctx, featureName, pValue);
+}
+
+/// <summary>
+/// òֵ
+/// </summary>
+/// <param name="value">1=true, 0=false</param>
+REVEALER_API ErrorCode Camera_SetBoolFeatureValue(CameraHandle handle, const char* featureName, int value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName) return -1;
+
+    return WriteBoolFeature(ctx, featureName, value);
+}
+
+// =================================================================
+// StringַԲ
+// =================================================================
+
+/// <summary>
+/// ȡֵַ
+/// </summary>
+/// <param name="pValue">ַ</param>
+/// <param name="valueSize">С</param>
+/// <remarks>
+/// ַͨ豸Ϣ磺
+/// - DeviceSerialNumber: к
+/// - DeviceModelName: ͺ
+/// - DeviceVersion: ̼汾
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetStringFeatureValue(CameraHandle handle, const char* featureName, char* pValue, int valueSize)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return ReadStringFeature(ctx, featureName, pValue, valueSize);
+}
+
+/// <summary>
+/// ֵַ
+/// </summary>
+/// <remarks>
+/// 󲿷ַֻ
+/// дַԽ٣ͨ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetStringFeatureValue(CameraHandle handle, const char* featureName, const char* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pValue) return -1;
+
+    return WriteStringFeature(ctx, featureName, pValue);
+}
+
+// =================================================================
+// CommandԲ
+// =================================================================
+
+/// <summary>
+/// ִ
+/// </summary>
+/// <param name="featureName"></param>
+/// <remarks>
+/// Commandǿִе޲޷ֵ
 /// 
-/// ʱ
-/// - ʱش
-/// - ͨԭδ̫֡͡Ӳ
+/// 
+/// - TriggerSoftware: 
+/// 
+/// ʹʾ
+/// Camera_ExecuteCommandFeature(handle, "TriggerSoftware");
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout)
+REVEALER_API ErrorCode Camera_ExecuteCommandFeature(CameraHandle handle, const char* featureName)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pImage) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName) return -1;
 
-    SC_Frame frame;
-    frame.pData = nullptr;
+    return ExecuteCommand(ctx, featureName);
+}
 
-    // ȡһ֡ͼ
-    int ret = SC_GetFrame(sdkHandle, &frame, timeout);
-    if (ret != SC_OK) return ret;
+// =================================================================
+// 
+// =================================================================
 
-    // ֤ͼЧ
-    if (frame.frameInfo.width == 0 || frame.frameInfo.height == 0 ||
-        frame.frameInfo.size == 0 || !frame.pData)
+/// <summary>
+/// ȡѽԣ
+/// </summary>
+/// <returns>ЧͲʱnullptr</returns>
+static const FeatureEntry* GetFeature(CameraContext* ctx, FeatureToken token, int type)
+{
+    const FeatureEntry* feature = ctx->features.Find(token);
+    return (feature && feature->type.load() == type) ? feature : nullptr;
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="featureName">ƣ"ExposureTime"</param>
+/// <param name="pToken"></param>
+/// <returns>SC_OK(0)ʾɹԲʱSDKĴ룻SC_NO_MEMORYʾѽﵽ</returns>
+/// <remarks>
+/// ;ѭÿζдԣExposureTimeAcquisitionFrameRateDeviceTemperatureȣ
+/// 
+/// - ʱѯһͺͷģʽ棬֮ƶдٵCamera_GetFeatureType/Camera_FeatureIsReadable
+///   Ѽֵ䣨Camera_SetNodeMapCacheDirectoryʱȡֵ䣬
+///   ҲУʹƣSDKƷʽڵ㣬SDKڲ
+/// - ģʽɼ״̬仯ɼWidthдֵοдԷֵΪ׼
+///   Ҫ״̬ʱ½ͬԣͬһƣ
+/// - ھǰһֱЧÿ256
+/// </remarks>
+REVEALER_API ErrorCode Camera_ResolveFeature(CameraHandle handle, const char* featureName, FeatureToken* pToken)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !featureName || !pToken) return -1;
+    if (strlen(featureName) >= kMaxFeatureNameLength) return SC_INVALID_PARAM;
+
+    // ֵеԲ豸ѯ
+    const FeatureInfo* known = ctx->nodeMapReady.load() ? ctx->nodeMap.Find(featureName) : nullptr;
+    int type = known ? known->type : 0;
+    if (!known)
     {
-        // ЧͷŲش
-        SC_ReleaseFrame(sdkHandle, &frame);
-        return -1;
+        SC_EFeatureType sdkType;
+        int ret = SC_GetFeatureType(ctx->sdkHandle, featureName, &sdkType);
+        if (ret != SC_OK) return ret;
+        type = static_cast<int>(sdkType);
     }
 
-    // ImageDataṹ
-    pImage->width = frame.frameInfo.width;
-    pImage->height = frame.frameInfo.height;
-    pImage->pixelFormat = frame.frameInfo.pixelFormat;
-    pImage->dataSize = frame.frameInfo.size;
-    pImage->stride = frame.frameInfo.size / frame.frameInfo.height;
-    pImage->blockId = frame.frameInfo.frameId;      // ֡
-    pImage->timeStamp = frame.frameInfo.timeStamp;  // ʱ
-    pImage->pData = (unsigned char*)frame.pData;    // ע⣺ָSDKڴ
+    int access = 0;
+    if (SC_FeatureIsReadable(ctx->sdkHandle, featureName)) access |= FeatureAccess_Read;
+    if (SC_FeatureIsWriteable(ctx->sdkHandle, featureName)) access |= FeatureAccess_Write;
+
+    FeatureToken token = ctx->features.Insert(featureName, type, access);
+    if (token == 0) return SC_NO_MEMORY;
 
+    *pToken = token;
     return SC_OK;
 }
 
 /// <summary>
-/// ͷ֡Դ
-/// Camera_GetFrameԵ
+/// ȡƻͺͷģʽ
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="pImage">Ҫͷŵͼ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ͷŻƣ
-/// - 黹SDK
-/// - Ա
-/// - δͷŻᵼ»ľ
-/// 
-/// ע⣺
-/// - ͷźpDataָʧЧ
-/// - Ҫظͷͬһ֡
-/// </remarks>
-REVEALER_API ErrorCode Camera_ReleaseFrame(CameraHandle handle, ImageData* pImage)
+/// <param name="token"></param>
+/// <param name="pType">ͣFeatureTypeΪnullptr</param>
+/// <param name="pAccess">ģʽFeatureAccessλΪnullptr</param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_PARAMʾЧ</returns>
+REVEALER_API ErrorCode Camera_GetFeatureTokenInfo(CameraHandle handle, FeatureToken token, int* pType, int* pAccess)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pImage) return -1;
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    // SC_Frameͷ
-    SC_Frame frame;
-    frame.pData = pImage->pData;
-    frame.frameInfo.width = pImage->width;
-    frame.frameInfo.height = pImage->height;
-    frame.frameInfo.pixelFormat = (SC_EPixelType)pImage->pixelFormat;
-    frame.frameInfo.size = pImage->dataSize;
+    const FeatureEntry* feature = ctx->features.Find(token);
+    if (!feature) return SC_INVALID_PARAM;
 
-    return SC_ReleaseFrame(sdkHandle, &frame);
+    if (pType) *pType = feature->type.load();
+    if (pAccess) *pAccess = feature->access.load();
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡͼͬʽ
-/// ;ȡSDKͼͼ
+/// ƻȡֵ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="pImage">ͼ</param>
-/// <param name="timeout">ʱʱ䣨룩</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ͼ
-/// - /Աȶ/Gamma
-/// - αӳ
-/// - ת/ת
-/// - ɫ׵
-/// 
-/// ʹ̣
-/// 1. Camera_SetImageProcessingEnabledô
-/// 2. Camera_SetImageProcessingValueò
-/// 3. ñȡͼ
-/// 
-/// ע⣺
-/// - ҪCPUʱ
-/// - ͬҪReleaseFrameͷ
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetProcessedFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout)
+REVEALER_API ErrorCode Camera_GetIntFeatureByToken(CameraHandle handle, FeatureToken token, long long* pValue)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pImage) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !pValue) return -1;
 
-    SC_Frame frame;
-    frame.pData = nullptr;
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Integer);
+    if (!feature) return SC_INVALID_PARAM;
 
-    // ȡͼ
-    int ret = SC_GetProcessedFrame(sdkHandle, &frame, timeout);
-    if (ret != SC_OK) return ret;
+    return ReadIntFeature(ctx, feature->name, FeatureCacheField_Value, pValue);
+}
 
-    // ֤Ч
-    if (frame.frameInfo.width == 0 || frame.frameInfo.height == 0 ||
-        frame.frameInfo.size == 0 || !frame.pData)
+/// <summary>
+/// ֵúӦضʵЧֵμCamera_SetIntFeatureValue
+/// </summary>
+REVEALER_API ErrorCode Camera_SetIntFeatureByToken(CameraHandle handle, FeatureToken token, long long value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Integer);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return WriteIntFeature(ctx, feature->name, value);
+}
+
+/// <summary>
+/// ƻȡֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetFloatFeatureByToken(CameraHandle handle, FeatureToken token, double* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !pValue) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Float);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return ReadFloatFeature(ctx, feature->name, FeatureCacheField_Value, pValue);
+}
+
+/// <summary>
+/// øֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_SetFloatFeatureByToken(CameraHandle handle, FeatureToken token, double value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Float);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return WriteFloatFeature(ctx, feature->name, value);
+}
+
+/// <summary>
+/// ƻȡöֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetEnumFeatureByToken(CameraHandle handle, FeatureToken token, unsigned long long* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !pValue) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Enum);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return ReadEnumFeature(ctx, feature->name, pValue);
+}
+
+/// <summary>
+/// öֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_SetEnumFeatureByToken(CameraHandle handle, FeatureToken token, unsigned long long value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Enum);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return WriteEnumFeature(ctx, feature->name, value);
+}
+
+/// <summary>
+/// ƻȡöԵĵǰ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetEnumSymbolByToken(CameraHandle handle, FeatureToken token, char* symbol, int symbolSize)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !symbol) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Enum);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return ReadEnumSymbol(ctx, feature->name, symbol, symbolSize);
+}
+
+/// <summary>
+/// Էö
+/// </summary>
+REVEALER_API ErrorCode Camera_SetEnumSymbolByToken(CameraHandle handle, FeatureToken token, const char* symbol)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !symbol) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Enum);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return WriteEnumSymbol(ctx, feature->name, symbol);
+}
+
+/// <summary>
+/// ƻȡֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetBoolFeatureByToken(CameraHandle handle, FeatureToken token, int* pValue)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !pValue) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Bool);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return ReadBoolFeature(ctx, feature->name, pValue);
+}
+
+/// <summary>
+/// òֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_SetBoolFeatureByToken(CameraHandle handle, FeatureToken token, int value)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Bool);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return WriteBoolFeature(ctx, feature->name, value);
+}
+
+/// <summary>
+/// ִ
+/// </summary>
+REVEALER_API ErrorCode Camera_ExecuteCommandByToken(CameraHandle handle, FeatureToken token)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    const FeatureEntry* feature = GetFeature(ctx, token, FeatureType_Command);
+    if (!feature) return SC_INVALID_PARAM;
+
+    return ExecuteCommand(ctx, feature->name);
+}
+
+// =================================================================
+// д
+// =================================================================
+
+/// <summary>
+/// ʱԵӦ˳Сãͬһ˳
+/// </summary>
+enum FeatureSetStage
+{
+    FeatureSetStage_Format = 0,     // ģʽ/Binning/ظʽߴROIΧ
+    FeatureSetStage_Size,           // Width/Height
+    FeatureSetStage_Offset,         // OffsetX/OffsetYΧȡڿ
+    FeatureSetStage_General,        // ԣع⡢ȣ
+    FeatureSetStage_FrameRate,      // ֡ʣȡROIع
+    FeatureSetStage_Command,        // ִ
+};
+
+static int GetFeatureSetStage(const char* name, int type)
+{
+    if (type == FeatureType_Command) return FeatureSetStage_Command;
+    if (strcmp(name, "ReadoutMode") == 0 || strcmp(name, "BinningMode") == 0 || strcmp(name, "PixelFormat") == 0)
+        return FeatureSetStage_Format;
+    if (strcmp(name, "Width") == 0 || strcmp(name, "Height") == 0) return FeatureSetStage_Size;
+    if (strcmp(name, "OffsetX") == 0 || strcmp(name, "OffsetY") == 0) return FeatureSetStage_Offset;
+    if (strcmp(name, "FrameRateEnable") == 0 || strcmp(name, "AcquisitionFrameRate") == 0)
+        return FeatureSetStage_FrameRate;
+    return FeatureSetStage_General;
+}
+
+/// <summary>
+/// ȡȣ
+/// </summary>
+static int ResolveBatchItem(CameraContext* ctx, const FeatureValue& item, const char** pName)
+{
+    if (item.token != 0)
     {
-        SC_ReleaseFrame(sdkHandle, &frame);
-        return -1;
+        const FeatureEntry* feature = GetFeature(ctx, item.token, item.type);
+        if (!feature) return SC_INVALID_PARAM;
+        *pName = feature->name;
+        return SC_OK;
     }
 
-    // 
-    pImage->width = frame.frameInfo.width;
-    pImage->height = frame.frameInfo.height;
-    pImage->pixelFormat = frame.frameInfo.pixelFormat;
-    pImage->dataSize = frame.frameInfo.size;
-    pImage->stride = frame.frameInfo.size / frame.frameInfo.height;
-    pImage->blockId = frame.frameInfo.frameId;
-    pImage->timeStamp = frame.frameInfo.timeStamp;
-    pImage->pData = (unsigned char*)frame.pData;
-
+    if (!item.featureName) return SC_INVALID_PARAM;
+    *pName = item.featureName;
     return SC_OK;
 }
 
-REVEALER_API ErrorCode Camera_OpenRecord(CameraHandle handle, RecordParam* pParam)
+static int ApplyFeatureValue(CameraContext* ctx, const char* name, const FeatureValue& item)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pParam) return -1;
+    bool hasSymbol = memchr(item.symbol, '\0', sizeof(item.symbol)) != nullptr;
 
-    // תΪSDK¼ṹ
-    SC_RecordParam recordParam;
+    switch (item.type)
+    {
+    case FeatureType_Integer:
+        return WriteIntFeature(ctx, name, item.intValue);
+    case FeatureType_Float:
+        return WriteFloatFeature(ctx, name, item.floatValue);
+    case FeatureType_Enum:
+        if (!hasSymbol) return SC_INVALID_PARAM;
+        if (item.symbol[0]) return WriteEnumSymbol(ctx, name, item.symbol);
+        return WriteEnumFeature(ctx, name, static_cast<unsigned long long>(item.intValue));
+    case FeatureType_Bool:
+        return WriteBoolFeature(ctx, name, item.intValue != 0);
+    case FeatureType_String:
+        if (!hasSymbol) return SC_INVALID_PARAM;
+        return WriteStringFeature(ctx, name, item.symbol);
+    case FeatureType_Command:
+        return ExecuteCommand(ctx, name);
+    default:
+        return SC_INVALID_PARAM;
+    }
+}
 
-    // ע⣺SDKRecordParamʹrecordFilePathfileNameֱ洢·ļ
-    // ǼΪһfileNameֶΣҪ·ļ
+static int ReadFeatureValue(CameraContext* ctx, const char* name, FeatureValue& item)
+{
+    int ret = SC_INVALID_PARAM;
+    switch (item.type)
+    {
+    case FeatureType_Integer:
+        ret = ReadIntFeature(ctx, name, FeatureCacheField_Value, &item.intValue);
+        break;
+    case FeatureType_Float:
+        ret = ReadFloatFeature(ctx, name, FeatureCacheField_Value, &item.floatValue);
+        break;
+    case FeatureType_Enum:
+    {
+        unsigned long long value = 0;
+        ret = ReadEnumFeature(ctx, name, &value);
+        if (ret == SC_OK) ret = ReadEnumSymbol(ctx, name, item.symbol, sizeof(item.symbol));
+        if (ret == SC_OK) item.intValue = static_cast<long long>(value);
+        break;
+    }
+    case FeatureType_Bool:
+    {
+        int value = 0;
+        ret = ReadBoolFeature(ctx, name, &value);
+        if (ret == SC_OK) item.intValue = value;
+        break;
+    }
+    case FeatureType_String:
+        ret = ReadStringFeature(ctx, name, item.symbol, sizeof(item.symbol));
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
 
-    // 򻯴fileName·
-    // õķʽǷ·ļȼ򵥴
-    strncpy_s(recordParam.fileName, sizeof(recordParam.fileName),
-        pParam->fileName, _TRUNCATE);
+/// <summary>
+/// 
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pItems">飺ƻơֵ͡resultÿĴ</param>
+/// <param name="count"></param>
+/// <returns>ȫɹSC_OK򷵻еһʧĴ</returns>
+/// <remarks>
+/// ;ʱһӦüʮãֻһй/л
+/// 
+/// Ӧ˳ͬһ˳򣩣
+/// 1. ReadoutModeBinningModePixelFormatı䴫ߴROIΧ
+/// 2. WidthHeight
+/// 3. OffsetXOffsetYͬʱÿߺƫʱȰЩƫ㣬ʱƫԽ磩
+/// 4. 
+/// 5. FrameRateEnableAcquisitionFrameRate֡ȡROIع⣩
+/// 6. 
+/// 
+/// - ĳʧܲӰúSDKֵܵ벽ҪʵֵʱCamera_GetFeaturesBatchض
+/// - EnumsymbolǿʱãintValue
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetFeaturesBatch(CameraHandle handle, FeatureValue* pItems, unsigned int count)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || (!pItems && count > 0)) return -1;
 
-    // Ҫ·ļ
-    // ҵһ·ָ
-    // const char* lastSlash = strrchr(pParam->fileName, '\\');
-    // if (!lastSlash) lastSlash = strrchr(pParam->fileName, '/');
-    // if (lastSlash) {
-    //     size_t pathLen = lastSlash - pParam->fileName;
-    //     strncpy_s(recordParam.recordFilePath, pathLen + 1, pParam->fileName, pathLen);
-    //     strncpy_s(recordParam.fileName, sizeof(recordParam.fileName), lastSlash + 1, _TRUNCATE);
-    // }
+    std::vector<const char*> names(count, nullptr);
+    std::vector<int> stages(count, 0);
+    std::vector<unsigned int> order;
+    order.reserve(count);
 
-    // 
-    recordParam.recordFormat = static_cast<SC_EVideoType>(pParam->recordFormat);
-    recordParam.quality = pParam->quality;
-    recordParam.frameRate = static_cast<float>(pParam->frameRate);
-    recordParam.startFrame = 0;  // ʹĬֵ
-    recordParam.count = 0;       // 0ʾ¼
-    recordParam.saveImageType = eOriginalImage; // ¼ԭʼͼ
+    bool setsWidth = false, setsHeight = false, setsOffsetX = false, setsOffsetY = false;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        pItems[i].result = ResolveBatchItem(ctx, pItems[i], &names[i]);
+        if (pItems[i].result != SC_OK) continue;
 
-    return SC_OpenRecord(sdkHandle, &recordParam);
+        stages[i] = GetFeatureSetStage(names[i], pItems[i].type);
+        order.push_back(i);
+
+        if (strcmp(names[i], "Width") == 0) setsWidth = true;
+        else if (strcmp(names[i], "Height") == 0) setsHeight = true;
+        else if (strcmp(names[i], "OffsetX") == 0) setsOffsetX = true;
+        else if (strcmp(names[i], "OffsetY") == 0) setsOffsetY = true;
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [&](unsigned int a, unsigned int b) { return stages[a] < stages[b]; });
+
+    // ƫᰴֵãʧܲӰ
+    if (setsWidth && setsOffsetX) WriteIntFeature(ctx, "OffsetX", 0);
+    if (setsHeight && setsOffsetY) WriteIntFeature(ctx, "OffsetY", 0);
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        FeatureValue& item = pItems[order[i]];
+        item.result = ApplyFeatureValue(ctx, names[order[i]], item);
+    }
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (pItems[i].result != SC_OK) return pItems[i].result;
+    }
+    return SC_OK;
+}
+
+/// <summary>
+/// ȡ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pItems">飺ƻơͣȡֵдӦֶΣresultÿĴ</param>
+/// <param name="count"></param>
+/// <returns>ȫɹSC_OK򷵻еһʧĴ</returns>
+/// <remarks>
+/// - ˳ȡĳʧܲӰ
+/// - EnumͬʱֵintValueͷţsymbolStringֵ63ֽʱضϣCommandSC_INVALID_PARAM
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetFeaturesBatch(CameraHandle handle, FeatureValue* pItems, unsigned int count)
+{
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || (!pItems && count > 0)) return -1;
+
+    int first = SC_OK;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const char* name = nullptr;
+        pItems[i].result = ResolveBatchItem(ctx, pItems[i], &name);
+        if (pItems[i].result == SC_OK) pItems[i].result = ReadFeatureValue(ctx, name, pItems[i]);
+        if (first == SC_OK) first = pItems[i].result;
+    }
+    return first;
 }
 
+// =================================================================
+// Ի
+// =================================================================
+
 /// <summary>
-/// ر¼
+/// /رֵ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
+/// <param name="handle">豸Ѵ򿪣</param>
+/// <param name="enable">1=ã0=رգĬϹرգ</param>
+/// <returns>SC_OK(0)ʾɹʱע»صĽʧʱ汣ֹر</returns>
 /// <remarks>
-/// - ֹͣ¼񲢹رļ
-/// - ļᱻȷfinalize
-/// - ԰ȫ¼Ƶļ
+/// ;UIԽϸƵѯ״̬ʱδ仯ֱӴڴ淵أÿη豸
+/// 
+/// - ơƺȡGetֵšMin/Max/Inc
+/// - öٿֵCamera_GetEnumFeatureEntryNum/Entrys/Tableͬ棬»صԺ¶ȡ
+/// - ʧЧ»صԣڲעᣬCamera_SubscribeParamUpdateArgûص棩
+///   óɹԣMin/Max/IncһԱ仯ȫʧЧ
+/// - Enum/Bool/StringɹֱдֵInteger/FloatܱSDK´ζȡʱض
+/// - 棺ExposureTimeAcquisitionFrameRateSDK֪ͨ仯DeviceTemperatureʵʱֵ
+/// - /رCamera_SetROIִTriggerSoftware⣩գرպ´ʱԶעص
+/// - ƹ޸ControlȨ޷ʣʱ治ʧЧʱӦCamera_InvalidateFeatureCacheرջ
 /// </remarks>
-REVEALER_API ErrorCode Camera_CloseRecord(CameraHandle handle)
+REVEALER_API ErrorCode Camera_SetFeatureCacheEnabled(CameraHandle handle, int enable)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_CloseRecord(sdkHandle);
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
+
+    if (!enable)
+    {
+        ctx->featureCache.SetEnabled(false);
+        return SC_OK;
+    }
+
+    // ע᣺ע֪ͨ©
+    ctx->featureCache.SetEnabled(true);
+    int ret = SC_SubscribeParamUpdateArg(ctx->sdkHandle, OnParamUpdateCallback, ctx);
+    if (ret != SC_OK) ctx->featureCache.SetEnabled(false);
+    return ret;
 }
 
 /// <summary>
-/// õʱʹõĻС
-/// Żͼ񵼳
+/// Ի
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="cacheSizeInByte">Сֽڣ
-///   Ƽֵ100MB - 1GB
-///   ȡڿڴ͵ٶ
-/// </param>
+/// <param name="featureName">ƣnullptrʾȫ</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
-REVEALER_API ErrorCode Camera_SetExportCacheSize(CameraHandle handle, unsigned long long cacheSizeInByte)
+REVEALER_API ErrorCode Camera_InvalidateFeatureCache(CameraHandle handle, const char* featureName)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-    return SC_SetExportCacheSize(sdkHandle, cacheSizeInByte);
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
+
+    if (featureName) ctx->featureCache.Invalidate(featureName);
+    else ctx->featureCache.Clear();
+    return SC_OK;
 }
 
 // =================================================================
-// 5.6 Բ
+// ֵ
 // =================================================================
 
 /// <summary>
-/// Ƿ
+/// ֵ豸ѯһ£
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="featureName">ƣ"Width""ExposureTime"</param>
-/// <returns>1=ã0=</returns>
-/// <remarks>
-/// Կȡڣ
-/// - ͺź͹̼汾
-/// - ǰ״̬Ƿڲɼ
-/// - ԵãԼ
-/// 
-/// 飺
-/// - ǰȼ
-/// - ʱҪ
-/// </remarks>
-REVEALER_API int Camera_FeatureIsAvailable(CameraHandle handle, const char* featureName)
+static const unsigned int kNodeMapSpotChecks = 4;
+
+/// <summary>
+/// ƴֵļ·directory\ͺ_̼汾 + suffixļвʹõַ'_'
+/// </summary>
+static std::string BuildNodeMapPath(const std::string& directory, const SC_DeviceInfo& info, const char* suffix)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return 0;
+    std::string path = directory;
+    char last = path[path.size() - 1];
+    if (last != '\\' && last != '/') path += '\\';
 
-    return SC_FeatureIsAvailable(sdkHandle, featureName) ? 1 : 0;
+    std::string name = std::string(info.modelName) + "_" + info.deviceVersion;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        if (static_cast<unsigned char>(name[i]) < 32 || strchr("\\/:*?\"<>| ", name[i])) name[i] = '_';
+    }
+    return path + name + suffix;
 }
 
 /// <summary>
-/// Ƿɶ
+/// ֵоȷֲļԣ豸һʱΪֵڸ豸
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="featureName"></param>
-/// <returns>1=ɶ0=ɶ</returns>
-REVEALER_API int Camera_FeatureIsReadable(CameraHandle handle, const char* featureName)
+static bool CheckNodeMap(CameraContext* ctx)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return 0;
-
-    return SC_FeatureIsReadable(sdkHandle, featureName) ? 1 : 0;
+    unsigned int count = ctx->nodeMap.Count();
+    for (unsigned int i = 0; i < kNodeMapSpotChecks; i++)
+    {
+        const FeatureInfo& feature = ctx->nodeMap.Features()[i * (count - 1) / (kNodeMapSpotChecks - 1)];
+        SC_EFeatureType type;
+        if (SC_GetFeatureType(ctx->sdkHandle, feature.name, &type) != SC_OK || static_cast<int>(type) != feature.type)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 /// <summary>
-/// Ƿд
+/// 豸ֵ䣺GenICam XMLȡԽڵ㣬ѯͺö浽Ŀ¼
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="featureName"></param>
-/// <returns>1=д0=д</returns>
-/// <remarks>
-/// ĳЩֻ磺
-/// - SensorWidth, SensorHeightߴ磩
-/// - DeviceTemperatureǰ¶ȣ
-/// 
-/// ĳЩڲɼʱд磺
-/// - Width, Height, PixelFormatҪֹͣɼ
-/// </remarks>
-REVEALER_API int Camera_FeatureIsWriteable(CameraHandle handle, const char* featureName)
+static ErrorCode BuildNodeMap(CameraContext* ctx, const SC_DeviceInfo& info)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return 0;
+    std::string xmlPath = BuildNodeMapPath(ctx->nodeMapDirectory, info, kNodeMapXmlSuffix);
+    int ret = SC_DownLoadGenICamXML(ctx->sdkHandle, xmlPath.c_str());
+    if (ret != SC_OK) return ret;
 
-    return SC_FeatureIsWriteable(sdkHandle, featureName) ? 1 : 0;
+    std::vector<std::string> names;
+    unsigned long long xmlBytes = 0;
+    ret = ScanGenICamXml(xmlPath.c_str(), &names, &xmlBytes);
+    if (ret != SC_OK) return ret;
+
+    std::vector<NodeMapFeature> features;
+    std::vector<SC_EnumEntryInfo> infos;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        // XML豸ɷʵĽڵ
+        const char* name = names[i].c_str();
+        SC_EFeatureType type;
+        if (SC_GetFeatureType(ctx->sdkHandle, name, &type) != SC_OK) continue;
+
+        NodeMapFeature feature;
+        feature.name = names[i];
+        feature.type = static_cast<int>(type);
+
+        unsigned int count = 0;
+        if (feature.type == FeatureType_Enum && SC_GetEnumFeatureEntryNum(ctx->sdkHandle, name, &count) == SC_OK && count > 0)
+        {
+            infos.assign(count, SC_EnumEntryInfo());
+            SC_EnumEntryList entryList;
+            entryList.enumEntryBufferSize = count;
+            entryList.pEnumEntryInfo = infos.data();
+            if (SC_GetEnumFeatureEntrys(ctx->sdkHandle, name, &entryList) == SC_OK)
+            {
+                if (entryList.enumEntryBufferSize < count) count = entryList.enumEntryBufferSize;
+                for (unsigned int j = 0; j < count; j++)
+                {
+                    infos[j].name[sizeof(infos[j].name) - 1] = '\0';
+                    feature.entries.push_back(std::make_pair(static_cast<unsigned long long>(infos[j].value),
+                        std::string(infos[j].name)));
+                }
+            }
+        }
+        features.push_back(std::move(feature));
+    }
+    if (features.empty()) return SC_NOT_SUPPORT;
+
+    std::string path = BuildNodeMapPath(ctx->nodeMapDirectory, info, kNodeMapFileSuffix);
+    return ctx->nodeMap.Create(path.c_str(), info.modelName, info.deviceVersion, xmlBytes, features);
 }
 
 /// <summary>
-/// ȡ
+/// ֵ䣨÷nodeMapLock
+/// 豸ǰͺź͹̼汾ӳ仺Ŀ¼еֵ䲢飻buildΪtrueʱ豸
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="featureName"></param>
-/// <param name="pType">
-///   0 = Integer   (Width)
-///   1 = Float     (ExposureTime)
-///   2 = Enum      (ö٣PixelFormat)
-///   3 = Bool      (FanSwitch)
-///   4 = String    (ַк)
-///   5 = Command   (TriggerSoftware)
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ;
-/// - ̬Է
-/// - ͨԱ༭
-/// - ԶUI
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetFeatureType(CameraHandle handle, const char* featureName, int* pType)
+static ErrorCode LoadNodeMap(CameraContext* ctx, bool build)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pType) return -1;
+    if (ctx->nodeMapReady.load()) return SC_OK;
+    if (ctx->nodeMapDirectory.empty()) return SC_INVALID_PARAM;
 
-    SC_EFeatureType type;
-    int ret = SC_GetFeatureType(sdkHandle, featureName, &type);
-    if (ret == SC_OK)
+    SC_DeviceInfo info;
+    int ret = SC_GetDeviceInfo(ctx->sdkHandle, &info);
+    if (ret != SC_OK) return ret;
+
+    std::string path = BuildNodeMapPath(ctx->nodeMapDirectory, info, kNodeMapFileSuffix);
+    ret = ctx->nodeMap.Load(path.c_str(), info.modelName, info.deviceVersion);
+    if (ret == SC_OK && !CheckNodeMap(ctx))
     {
-        *pType = static_cast<int>(type);
+        ctx->nodeMap.Close();
+        ret = SC_INVALID_RESOURCE;
     }
+    if (ret != SC_OK && build) ret = BuildNodeMap(ctx, info);
+
+    if (ret == SC_OK) ctx->nodeMapReady.store(true);
     return ret;
 }
 
-// =================================================================
-// IntegerԲ
-// =================================================================
-
 /// <summary>
-/// ȡֵ
+/// ֵĻĿ¼
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="featureName"></param>
-/// <param name="pValue">ֵ</param>
+/// <param name="directory">Ŀ¼Ѵڣnullptrմʾʹ</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ԣ
-/// - Width, Height: ͼߴ
-/// - OffsetX, OffsetY: ͼƫ
-/// - SensorWidth, SensorHeight: ߴ磨ֻ
-/// - DeviceTemperatureTarget: Ŀ¶
+/// ;ͬͺŵĶ̨ͬһ̼ʱһֵ䣬UIʱ豸ѯ
+/// 
+/// - Camera_Open֮ǰãʱ豸ͺź͹̼汾DeviceInfo.modelName/deviceVersion
+///   ӳdirectory\ͺ_汾.rvn鼸Եͣ豸ʱʹ
+/// - ʱֵ䣻һεCamera_GetFeatureDictionaryʱ棬صXMLΪͬ.xml
+/// - ֵغھǰٱ仯֮޸Ŀ¼ӰѼصֵ
+/// - ̼汾ű仯ԶʹµļҪǿؽʱɾӦ.rvnļ
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetIntFeatureValue(CameraHandle handle, const char* featureName, long long* pValue)
+REVEALER_API ErrorCode Camera_SetNodeMapCacheDirectory(CameraHandle handle, const char* directory)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    int64_t value = 0;
-    int ret = SC_GetIntFeatureValue(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    std::lock_guard<std::mutex> lock(ctx->nodeMapLock);
+    ctx->nodeMapDirectory = directory ? directory : "";
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡСֵ
+/// ȡֵ
 /// </summary>
-REVEALER_API ErrorCode Camera_GetIntFeatureMin(CameraHandle handle, const char* featureName, long long* pValue)
+/// <param name="handle">豸Ѵ򿪣</param>
+/// <param name="ppFeatures">򣩣ֻ</param>
+/// <param name="pCount"></param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_PARAMʾδûĿ¼SC_NOT_SUPPORTʾXMLûпʶԽڵ</returns>
+/// <remarks>
+/// - Ŀ¼пõֵʱֱӷأʱӳ䣩GenICam XMLѯԵͺö
+///   浽Ŀ¼ʧʱԷرνֵ䣩
+/// - ơźɱУֱָͨӳļǰЧ
+/// - öΪֵʱ豸ṩĿֵֵԱ仯ʱCamera_GetEnumFeatureTableΪ׼
+/// </remarks>
+REVEALER_API ErrorCode Camera_GetFeatureDictionary(CameraHandle handle, const FeatureInfo** ppFeatures, unsigned int* pCount)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle || !ppFeatures || !pCount) return -1;
 
-    int64_t value = 0;
-    int ret = SC_GetIntFeatureMin(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    std::lock_guard<std::mutex> lock(ctx->nodeMapLock);
+    int ret = LoadNodeMap(ctx, true);
+    if (ret != SC_OK) return ret;
+
+    *ppFeatures = ctx->nodeMap.Features();
+    *pCount = ctx->nodeMap.Count();
+    return SC_OK;
 }
 
+// =================================================================
+// 5.7 ¼ص
+// =================================================================
+
 /// <summary>
-/// ȡֵ
+/// 豸״̬¼صע
 /// </summary>
-REVEALER_API ErrorCode Camera_GetIntFeatureMax(CameraHandle handle, const char* featureName, long long* pValue)
+/// <param name="handle">豸</param>
+/// <param name="proc">豸״̬¼ص
+///   ص˵
+///   - isConnected: 1=豸ӣ0=豸ѶϿ
+///   - cameraKey: 豸кţΨһʶ
+///   - pUser: ûԶ
+/// </param>
+/// <param name="pUser">ûԶݣΪNULL</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// Ҫ˵
+/// - ֻעһΣUSB豸ȲЧ
+/// - صڶִ߳Уע̰߳ȫ
+/// - ó豸ȲΣԶ
+/// 
+/// ʹʾ
+/// void onConnect(int isConnected, const char* cameraKey, void* pUser) {
+///     if (isConnected) {
+///         printf("Device connected: %s\n", cameraKey);
+///     } else {
+///         printf("Device disconnected: %s\n", cameraKey);
+///     }
+/// }
+/// Camera_SubscribeConnectArg(handle, onConnect, nullptr);
+/// </remarks>
+REVEALER_API ErrorCode Camera_SubscribeConnectArg(CameraHandle handle, ConnectCallBack proc, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    if (!proc) return -1;
 
-    int64_t value = 0;
-    int ret = SC_GetIntFeatureMax(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    // ? ״̬صȫֵģҪ豸
+    // ? ֱӴ nullptr  SDK
+
+    // ûصϢȫֻصۣκξ
+    int ret = SetCallback(g_connectCallbackSlot, reinterpret_cast<void*>(proc), pUser);
+    if (ret != SC_OK) return ret;
+
+    // ? עSDKصһ nullptr
+    return SC_SubscribeConnectArg(nullptr, OnConnectCallback, nullptr);
 }
 
 /// <summary>
-/// ȡԲֵ
+/// ¼صע
 /// </summary>
+/// <param name="handle">豸</param>
+/// <param name="proc">ע¼ص
+///   ص˵
+///   - featureName: Ӱ
+///   - pUser: ûԶ
+/// </param>
+/// <param name="pUser">ûԶݣΪNULL</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ֵ˵
-/// - ЧֵǣMin + N * IncNΪ
-/// - 磺Min=0, Max=1000, Inc=4
-///   Чֵ0, 4, 8, 12, ..., 1000
+/// Ҫ˵
+/// - ֻעһΣرҪע
+/// - ĳԵ仯ʱ
+/// - οĵ3.3ڵ
 /// 
-/// ʱSDKԶЧֵ
+/// ⴦ԣ
+/// - ExposureTimeعʱ䣩ͨ˻ص֪ͨ
+/// - AcquisitionFrameRateɼ֡ʣͨ˻ص֪ͨ
+/// - Աضȷʵֵ
+/// 
+/// ʹó
+/// - ̬UIʾ
+/// - ͬ״̬
+/// - ¼Ա仯־
+/// 
+/// ʹʾ
+/// void onParamUpdate(const char* featureName, void* pUser) {
+///     printf("Parameter updated: %s\n", featureName);
+///     // ¶ȡԵֵԸUI
+/// }
+/// Camera_SubscribeParamUpdateArg(handle, onParamUpdate, nullptr);
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetIntFeatureInc(CameraHandle handle, const char* featureName, long long* pValue)
+REVEALER_API ErrorCode Camera_SubscribeParamUpdateArg(CameraHandle handle, ParamUpdateCallBack proc, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !proc) return -1;
 
-    int64_t value = 0;
-    int ret = SC_GetIntFeatureInc(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    // ûصϢ
+    int ret = SetCallback(ctx->paramUpdateSlot, reinterpret_cast<void*>(proc), pUser);
+    if (ret != SC_OK) return ret;
+
+    // עSDKصΪû
+    return SC_SubscribeParamUpdateArg(ctx->sdkHandle, OnParamUpdateCallback, ctx);
 }
 
 /// <summary>
-/// ֵ
+/// ĵ״̬֪ͨص
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="featureName"></param>
-/// <param name="value">Ҫõֵ</param>
+/// <param name="proc">״̬ص
+///   ص˵
+///   - status: ״̬
+///     0 = eExportStart      - ʼ
+///     1 = eExportProcessing - 
+///     2 = eExportFinish     - 
+///     3 = eExportClose      - ر
+///     4 = ѹֵ¼ƣCamera_SetRecordSpillPolicy
+///     5 = ѹѻ䣨¼ƣ
+///   - progress: 
+///     SDK¼ƣȣ0-100
+///     ¼ƣstatusΪ1/2/3ʱΪд֡дʧʱstatus=3progress=-1statusΪ4/5ʱΪѹٷֱ
+///   - pUser: ûԶ
+/// </param>
+/// <param name="pUser">ûԶݣΪNULL</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ҪʾμSDKĵ3.3ڣ
-/// 
-/// 1. ĳԿӰ
-///    磺WidthӰAcquisitionFrameRate
-/// 
-/// 2. ֵԶֵᱻϷΧ
-///    - 뵽ֵInc
-///    - Min-MaxΧ
+/// Ҫ˵
+/// - ֻעһ
+/// - ڼشͼ񵼳Ľ
+/// - صڶִ߳
 /// 
-/// 3. ضȷϣú¶ȡʵЧֵ
-///    ȷ
-///    Camera_SetIntFeatureValue(handle, "Width", 1000);
-///    Camera_GetIntFeatureValue(handle, "Width", &actualWidth);
-///    // actualWidthܲ10001004Inc
+/// ó
+/// - ͼʱʾ
+/// - ɺ֪ͨ
+/// - ʧܵĴ
 /// 
-/// 4. ӰԣοSDKĵ3.3.1
-///    ʹSC_SubscribeParamUpdateArgصȡ
+/// ʹʾ
+/// void onExport(int status, int progress, void* pUser) {
+///     switch(status) {
+///         case 0: printf("Export started\n"); break;
+///         case 1: printf("Exporting... %d frames written\n", progress); break;
+///         case 2: printf("Export completed, %d frames\n", progress); break;
+///         case 3: printf(progress < 0 ? "Export failed\n" : "Export closed\n"); break;
+///         case 4: printf("Write backlog %d%%\n", progress); break;
+///         case 5: printf("Write backlog back to %d%%\n", progress); break;
+///     }
+/// }
+/// Camera_SubscribeExportNotify(handle, onExport, nullptr);
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetIntFeatureValue(CameraHandle handle, const char* featureName, long long value)
+REVEALER_API ErrorCode Camera_SubscribeExportNotify(CameraHandle handle, ExportEventCallBack proc, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !proc) return -1;
+
+    // ûصϢ
+    int ret = SetCallback(ctx->exportSlot, reinterpret_cast<void*>(proc), pUser);
+    if (ret != SC_OK) return ret;
 
-    return SC_SetIntFeatureValue(sdkHandle, featureName, value);
+    // עSDKصΪû
+    // ע⣺ExportEventCBǩصͬ
+    return SC_SubscribeExportNotify(ctx->sdkHandle, OnExportCallback, ctx);
 }
 
 // =================================================================
-// FloatԲ
+// 5.8 ܣ߼ͼ
 // =================================================================
 
 /// <summary>
-/// ȡֵ
+/// Զع
 /// </summary>
+/// <param name="mode">Զعģʽ
+///   0 = ģʽeAutoExpCenter- ͼ
+///   1 = ҲģʽeAutoExpRight- ͼҲ
+///   2 = رգeAutoExpInvalid
+/// </param>
+/// <param name="targetGray">ĿҶֵ
+///   Χͨ0-255
+///   -1 = ʹĬֵ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ԣ
-/// - ExposureTime: عʱ䣨΢룩
-/// - AcquisitionFrameRate: ɼ֡ʣfps
-/// - TriggerDelay: ӳ٣΢룩
-/// - DeviceTemperature: ǰ¶ȣ棬ֻ
+/// Զع⹤ԭ
+/// 1. ɼһ֡ͼ
+/// 2. ָƽҶ
+/// 3. ĿҶȱȽ
+/// 4. عʱʹҶȽӽĿֵ
+/// 
+/// ģʽѡ
+/// - Center: ʺΪҪע
+/// - Right: ʺҲҪݵĳ
+/// - Invalid: رԶع
+/// 
+/// ʹ̣
+/// 1. SetAutoExposureParamò
+/// 2. AutoExposureִԶع
+/// 3. SDKԶExposureTime
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetFloatFeatureValue(CameraHandle handle, const char* featureName, double* pValue)
-{
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
-
-    double value = 0;
-    int ret = SC_GetFloatFeatureValue(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
-}
-
-/// <summary>
-/// ȡСֵ
-/// </summary>
-REVEALER_API ErrorCode Camera_GetFloatFeatureMin(CameraHandle handle, const char* featureName, double* pValue)
+REVEALER_API ErrorCode Camera_SetAutoExposureParam(CameraHandle handle, int mode, int targetGray)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    double value = 0;
-    int ret = SC_GetFloatFeatureMin(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
-}
+    SC_AutoExpParam param;
+    param.origTargetGray = targetGray;
 
-/// <summary>
-/// ȡֵ
-/// </summary>
-REVEALER_API ErrorCode Camera_GetFloatFeatureMax(CameraHandle handle, const char* featureName, double* pValue)
-{
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+	// תģʽö
+	switch (mode)
+	{
+	case 0: param.mode = eAutoExpCenter; break;
+	case 1: param.mode = eAutoExpRight; break;
+	case 2: param.mode = eAutoExpInvalid; break;
+	default: param.mode = eAutoExpInvalid; break;
+	}
 
-    double value = 0;
-    int ret = SC_GetFloatFeatureMax(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    return SC_SetAutoExposureParam(sdkHandle, &param);
 }
 
 /// <summary>
-/// ȡԲֵУ
+/// ִԶع
 /// </summary>
+/// <param name="pActualGray">ʵʴﵽĿҶ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ע⣺иԶвֵ
-/// 0ܱʾ޲
+/// ע⣺
+/// - ڲɼ״̬µ
+/// - ԶExposureTime
+/// - ҪGetExposureTimeȡʵֵ
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetFloatFeatureInc(CameraHandle handle, const char* featureName, double* pValue)
+REVEALER_API ErrorCode Camera_AutoExposure(CameraHandle handle, int* pActualGray)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    double value = 0;
-    int ret = SC_GetFloatFeatureInc(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
-}
+    SC_AutoExpParam param;
+    int ret = SC_AutoExposure(sdkHandle, &param);
 
-/// <summary>
-/// øֵ
-/// </summary>
-/// <remarks>
-/// ע⣺ͬѭ򣨼SetIntFeatureValueעͣ
-/// 
-/// ˵
-/// - ExposureTimeAcquisitionFrameRateӰ
-/// - úضȷʵֵ
-/// </remarks>
-REVEALER_API ErrorCode Camera_SetFloatFeatureValue(CameraHandle handle, const char* featureName, double value)
-{
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return -1;
+    if (ret == SC_OK && pActualGray)
+    {
+        *pActualGray = param.origTargetGray;
+    }
 
-    return SC_SetFloatFeatureValue(sdkHandle, featureName, value);
+    return ret;
 }
 
-// =================================================================
-// EnumöԲ
-// =================================================================
-
 /// <summary>
-/// ȡöֵ
+/// Զɫģʽ
 /// </summary>
-/// <param name="pValue">öֵ</param>
+/// <param name="mode">ɫģʽ
+///   0 = رգeAutoLevelOff
+///   1 = ɫףeAutoLevelR- Զ
+///   2 = ɫףeAutoLevelL- Զ
+///   3 = ɫףeAutoLevelRL- ͬʱ͸
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// öԣμGloria 4.2Ա
-/// 
-/// BinningModeϲģʽ
-///   0 = OneByOne (1x1)
-///   1 = TwoByTwo (2x2)
-///   2 = FourByFour (4x4)
-/// 
-/// PixelFormatظʽ
-///   17825797 = Mono12
-///   17563719 = Mono12p
-///   17825799 = Mono16
+/// ɫ׵ԭ
+/// - ɫףͼֵӳ
+/// - ɫףͼֵӳ
+/// - ĿģʾΧǿԱȶ
 /// 
-/// ReadoutModeģʽ
-///   0 = bit11_HS_Low (11λٵ)
-///   1 = bit11_HS_High (11λٸ)
-///   6 = bit12_CMS (12λ)
-///   7 = bit16_From11 (16λ߶̬)
+/// Ӧã
+/// - ͼʹɫ
+/// - ͼʹɫѹ߹
+/// - ͶԱȶȣʹɫͬʱ
 /// 
-/// FrameRateEnable֡ʹܣ
-///   0 = FALSE
-///   1 = TRUE
+/// ע⣺
+/// - ɫͼ
+/// - ıɼ
+/// - ӰͼʾЧ
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetEnumFeatureValue(CameraHandle handle, const char* featureName, unsigned long long* pValue)
+REVEALER_API ErrorCode Camera_SetAutoLevels(CameraHandle handle, int mode)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    uint64_t value = 0;
-    int ret = SC_GetEnumFeatureValue(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    SC_AutoLevelMode levelMode;
+    switch (mode)
+    {
+    case 0: levelMode = eAutoLevelOff; break;
+    case 1: levelMode = eAutoLevelR; break;
+    case 2: levelMode = eAutoLevelL; break;
+    case 3: levelMode = eAutoLevelRL; break;
+    default: levelMode = eAutoLevelOff; break;
+    }
+
+    return SC_SetAutoLevels(sdkHandle, levelMode);
 }
 
 /// <summary>
-/// öֵ
+/// ȡԶɫģʽ
 /// </summary>
-/// <param name="value">öֵ</param>
-/// <remarks>
-/// ʹʾ
-/// // ظʽΪMono16
-/// Camera_SetEnumFeatureValue(handle, "PixelFormat", 17825799);
-/// 
-/// // öģʽΪģʽ
-/// Camera_SetEnumFeatureValue(handle, "ReadoutMode", 6);
-/// </remarks>
-REVEALER_API ErrorCode Camera_SetEnumFeatureValue(CameraHandle handle, const char* featureName, unsigned long long value)
+REVEALER_API ErrorCode Camera_GetAutoLevels(CameraHandle handle, int* pMode)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pMode) return -1;
 
-    return SC_SetEnumFeatureValue(sdkHandle, featureName, value);
-}
+    SC_AutoLevelMode mode = eAutoLevelOff;
+    int ret = SC_GetAutoLevels(sdkHandle, mode);
 
-/// <summary>
-/// ȡöԵĿѡֵ
-/// </summary>
-/// <param name="pNum">ѡֵ</param>
-/// <remarks>
-/// ;
-/// - ̬UIб
-/// - пѡֵ
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetEnumFeatureEntryNum(CameraHandle handle, const char* featureName, unsigned int* pNum)
-{
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pNum) return -1;
+    if (ret == SC_OK)
+    {
+        switch (mode)
+        {
+        case eAutoLevelOff: *pMode = 0; break;
+        case eAutoLevelR: *pMode = 1; break;
+        case eAutoLevelL: *pMode = 2; break;
+        case eAutoLevelRL: *pMode = 3; break;
+        default: *pMode = 0; break;
+        }
+    }
 
-    return SC_GetEnumFeatureEntryNum(sdkHandle, featureName, pNum);
+    return ret;
 }
 
 /// <summary>
-/// ȡöԵĿöֵб
+/// ɫֵ
 /// </summary>
-/// <param name="handle">豸</param>
-/// <param name="featureName"></param>
-/// <param name="pEntryNum">ʱΪСʱΪʵʻȡ</param>
-/// <param name="pEnumValues">öֵ飬Ϊnullptrѯ</param>
-/// <param name="pSymbols">飬Ϊnullptr</param>
-/// <param name="symbolSize">ÿƵĻС</param>
+/// <param name="mode">1=ɫ, 2=ɫ</param>
+/// <param name="value">ֵ
+///   Χ0-65535
+///   ɫףСڴֵӳΪ0
+///   ɫףڴֵӳΪֵ
+/// </param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ÷ã
-/// 
-/// // һȡ
-/// unsigned int count = 0;
-/// Camera_GetEnumFeatureEntryNum(handle, "PixelFormat", &count);
+/// ʹʾ
+/// // ɫֵΪ100ü
+/// Camera_SetAutoLevelValue(handle, 2, 100);
 /// 
-/// // ڶȡб
-/// uint64_t* values = new uint64_t[count];
-/// char** symbols = new char*[count];
-/// for(int i=0; i<count; i++) symbols[i] = new char[256];
-/// unsigned int actualCount = count;
-/// Camera_GetEnumFeatureEntrys(handle, "PixelFormat", &actualCount, values, symbols, 256);
+/// // ɫֵΪ60000߹ü
+/// Camera_SetAutoLevelValue(handle, 1, 60000);
 /// 
-/// ע⣺
-/// - ȵCamera_GetEnumFeatureEntryNumȡȷ
-/// - pEntryNumΪʱʾСΪʾʵ
+/// Զ
+/// - ֶãExecuteAutoLevelԶʵֵ
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetEnumFeatureEntrys(CameraHandle handle, const char* featureName,
-    unsigned int* pEntryNum, unsigned long long* pEnumValues, char** pSymbols, int symbolSize)
+REVEALER_API ErrorCode Camera_SetAutoLevelValue(CameraHandle handle, int mode, int value)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pEntryNum) return -1;
-
-    // ѯֱӵGetEnumFeatureEntryNum
-    if (pEnumValues == nullptr)
-    {
-        return SC_GetEnumFeatureEntryNum(sdkHandle, featureName, pEntryNum);
-    }
-
-    // ׼SDKöбṹ
-    SC_EnumEntryList entryList;
-    entryList.enumEntryBufferSize = *pEntryNum;
-
-    // ʱ
-    entryList.pEnumEntryInfo = new SC_EnumEntryInfo[*pEntryNum];
-    memset(entryList.pEnumEntryInfo, 0, sizeof(SC_EnumEntryInfo) * (*pEntryNum));
-
-    // SDKӿ
-    int ret = SC_GetEnumFeatureEntrys(sdkHandle, featureName, &entryList);
-
-    if (ret == SC_OK)
-    {
-        // ݣิƻС
-        for (unsigned int i = 0; i < entryList.enumEntryBufferSize; i++)
-        {
-            // öֵ
-            pEnumValues[i] = entryList.pEnumEntryInfo[i].value;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-            // Ҫṩ˻
-            if (pSymbols != nullptr && pSymbols[i] != nullptr && symbolSize > 0)
-            {
-                strncpy_s(pSymbols[i], symbolSize,
-                    entryList.pEnumEntryInfo[i].name, _TRUNCATE);
-            }
-        }
+    // ƷΧ
+    if (value < 0) value = 0;
+    if (value > 65535) value = 65535;
 
-        // ʵڻС
-        *pEntryNum = entryList.enumEntryBufferSize;
-    }
+    SC_AutoLevelMode levelMode = (mode == 1) ? eAutoLevelR : eAutoLevelL;
+    return SC_SetAutoLevelValue(sdkHandle, levelMode, value);
+}
 
-    // ͷʱ
-    delete[] entryList.pEnumEntryInfo;
+/// <summary>
+/// ȡɫֵ
+/// </summary>
+REVEALER_API ErrorCode Camera_GetAutoLevelValue(CameraHandle handle, int mode, int* pValue)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pValue) return -1;
 
+    SC_AutoLevelMode levelMode = (mode == 1) ? eAutoLevelR : eAutoLevelL;
+    int value = 0;
+    int ret = SC_GetAutoLevelValue(sdkHandle, levelMode, value);
+    if (ret == SC_OK) *pValue = value;
     return ret;
 }
 
 /// <summary>
-/// ȡöԵķƣַʽ
+/// ִһԶɫ
 /// </summary>
-/// <param name="symbol">ƻ</param>
-/// <param name="symbolSize">С</param>
+/// <param name="mode">
+///   1 = ɫ
+///   2 = ɫ
+///   3 = ɫףƼ
+/// </param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// صǰֵķƣ磺
-/// - BinningMode: "TwoByTwo"
-/// - PixelFormat: "Mono16"
-/// - ReadoutMode: "bit12_CMS"
+/// ִк
+/// - SDKԶǰͼ
+/// - ɫֵ
+/// - ɫײ
+/// - ͼӦµɫӳ
 /// 
-/// Ʊָ׶ʺ־UIʾ
+/// ʹʱ
+/// - ı
+/// - л
+/// - ԱȶȲʱ
 /// </remarks>
-REVEALER_API ErrorCode Camera_GetEnumFeatureSymbol(CameraHandle handle, const char* featureName, char* symbol, int symbolSize)
+REVEALER_API ErrorCode Camera_ExecuteAutoLevel(CameraHandle handle, int mode)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !symbol) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    SC_String str;
-    int ret = SC_GetEnumFeatureSymbol(sdkHandle, featureName, &str);
-    if (ret == SC_OK)
+    SC_AutoLevelMode levelMode;
+    switch (mode)
     {
-        strncpy_s(symbol, symbolSize, str.str, _TRUNCATE);
+    case 1: levelMode = eAutoLevelR; break;
+    case 2: levelMode = eAutoLevelL; break;
+    case 3: levelMode = eAutoLevelRL; break;
+    default: levelMode = eAutoLevelRL; break;
     }
-    return ret;
+
+    return SC_ExecuteAutoLevel(sdkHandle, levelMode);
 }
 
 /// <summary>
-/// ͨö
+/// ͼʹ
 /// </summary>
-/// <param name="symbol">ƣ"Mono16"</param>
+/// <param name="feature">ͣμSDKĵ6.1
+///   0 = eBrightness  - ȵ [-100, 100], Ĭ50
+///   1 = eContrast    - Աȶ [0, 100], Ĭ50
+///   2 = eGamma       - GammaУ [0, 100], Ĭ56
+///   3 = ePseudoColor - αӳ䣨öٶ壩
+///   4 = eRotation    - תöٶ壩
+///   5 = eFlip        - תöٶ壩
+/// </param>
+/// <param name="enable">1=, 0=</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ʹʾ
-/// Camera_SetEnumFeatureSymbol(handle, "PixelFormat", "Mono16");
-/// Camera_SetEnumFeatureSymbol(handle, "BinningMode", "TwoByTwo");
+/// ͼ̣
+/// 1. Ĵ
+/// 2. ô
+/// 3. GetProcessedFrameȡͼ
 /// 
-/// ʹָҪ֪ȷķ
+/// ܿǣ
+/// - ÿõĹܶӴʱ
+/// - ֻñĹ
+/// - Զ̬
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetEnumFeatureSymbol(CameraHandle handle, const char* featureName, const char* symbol)
+REVEALER_API ErrorCode Camera_SetImageProcessingEnabled(CameraHandle handle, int feature, int enable)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !symbol) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    return SC_SetEnumFeatureSymbol(sdkHandle, featureName, symbol);
+    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
+    return SC_SetImageProcessingFeatureEnabled(sdkHandle, feat, enable != 0);
 }
 
-// =================================================================
-// BoolԲ
-// =================================================================
-
 /// <summary>
-/// ȡֵ
+/// ȡͼʹ״̬
 /// </summary>
-/// <param name="pValue">1=true, 0=false</param>
-/// <remarks>
-/// ԣ
-/// - FanSwitch: ȿ
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetBoolFeatureValue(CameraHandle handle, const char* featureName, int* pValue)
+REVEALER_API ErrorCode Camera_GetImageProcessingEnabled(CameraHandle handle, int feature, int* pEnable)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pEnable) return -1;
 
-    bool value = false;
-    int ret = SC_GetBoolFeatureValue(sdkHandle, featureName, &value);
-    if (ret == SC_OK) *pValue = value ? 1 : 0;
+    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
+    bool enable = false;
+    int ret = SC_GetImageProcessingFeatureEnabled(sdkHandle, feat, enable);
+    if (ret == SC_OK) *pEnable = enable ? 1 : 0;
     return ret;
 }
 
 /// <summary>
-/// òֵ
+/// ͼֵ
 /// </summary>
-/// <param name="value">1=true, 0=false</param>
-REVEALER_API ErrorCode Camera_SetBoolFeatureValue(CameraHandle handle, const char* featureName, int value)
+/// <param name="feature">ͣ0-5</param>
+/// <param name="value">ֵ
+///   ȣ[-100, 100]
+///   Աȶȣ[0, 100]
+///   Gamma[0, 100]
+///   αʣSC_PseudoColorMapö٣6.2ڣ
+///   תתģʽö٣6.5ڣ
+///   תתģʽö٣6.6ڣ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// ˵
+/// 
+/// ȣBrightness
+/// - ֵ䰵
+/// - 0
+/// - ֵ
+/// 
+/// ԱȶȣContrast
+/// - С50ͶԱȶ
+/// - 50
+/// - 50ǿԱȶ
+/// 
+/// Gamma
+/// - С56ǿϸ
+/// - 56ԣĬϣ
+/// - 56ǿϸ
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetImageProcessingValue(CameraHandle handle, int feature, int value)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    return SC_SetBoolFeatureValue(sdkHandle, featureName, value != 0);
+    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
+    return SC_SetImageProcessingFeatureValue(sdkHandle, feat, value);
 }
 
-// =================================================================
-// StringַԲ
-// =================================================================
-
 /// <summary>
-/// ȡֵַ
+/// ȡͼֵ
 /// </summary>
-/// <param name="pValue">ַ</param>
-/// <param name="valueSize">С</param>
-/// <remarks>
-/// ַͨ豸Ϣ磺
-/// - DeviceSerialNumber: к
-/// - DeviceModelName: ͺ
-/// - DeviceVersion: ̼汾
-/// </remarks>
-REVEALER_API ErrorCode Camera_GetStringFeatureValue(CameraHandle handle, const char* featureName, char* pValue, int valueSize)
+REVEALER_API ErrorCode Camera_GetImageProcessingValue(CameraHandle handle, int feature, int* pValue)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pValue) return -1;
 
-    SC_String str;
-    int ret = SC_GetStringFeatureValue(sdkHandle, featureName, &str);
-    if (ret == SC_OK)
-    {
-        strncpy_s(pValue, valueSize, str.str, _TRUNCATE);
-    }
+    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
+    int value = 0;
+    int ret = SC_GetImageProcessingFeatureValue(sdkHandle, feat, value);
+    if (ret == SC_OK) *pValue = value;
     return ret;
 }
 
 /// <summary>
-/// ֵַ
+/// αӳģʽ
 /// </summary>
+/// <param name="mapMode">αģʽμSDKĵ6.2
+///   0 = eHsv    - HSVɫӳ
+///   1 = eJet    - Jetɫӳ䣨Matlab
+///   2 = eRed    - ɫ
+///   3 = eGreen  - ɫ
+///   4 = eBlue   - ɫ
+/// </param>
+/// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// 󲿷ַֻ
-/// дַԽ٣ͨ
+/// α;
+/// - ҶͼתΪɫͼ
+/// - ǿӾԱȶ
+/// - ʶ¶ȷֲǿȲ
+/// 
+/// ģʽѡ
+/// - Jetѧӻɫ
+/// - HSVɫ仯ƽ
+/// - Red/Green/Blueɫ䣬ʺضӦ
+/// 
+/// ʹ̣
+/// 1. αʹܣSetImageProcessingEnabled(3, 1)
+/// 2. ӳģʽSetPseudoColorMap(1) // Jet
+/// 3. ȡͼGetProcessedFrame
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetStringFeatureValue(CameraHandle handle, const char* featureName, const char* pValue)
+REVEALER_API ErrorCode Camera_SetPseudoColorMap(CameraHandle handle, int mapMode)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName || !pValue) return -1;
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle) return -1;
 
-    return SC_SetStringFeatureValue(sdkHandle, featureName, pValue);
+    SC_PseudoColorMap mode = static_cast<SC_PseudoColorMap>(mapMode);
+    return SC_SetPseudoColorMap(sdkHandle, mode);
 }
 
-// =================================================================
-// CommandԲ
-// =================================================================
-
 /// <summary>
-/// ִ
+/// ȡαӳģʽ
 /// </summary>
-/// <param name="featureName"></param>
-/// <remarks>
-/// Commandǿִе޲޷ֵ
-/// 
-/// 
-/// - TriggerSoftware: 
-/// 
-/// ʹʾ
-/// Camera_ExecuteCommandFeature(handle, "TriggerSoftware");
-/// </remarks>
-REVEALER_API ErrorCode Camera_ExecuteCommandFeature(CameraHandle handle, const char* featureName)
+REVEALER_API ErrorCode Camera_GetPseudoColorMap(CameraHandle handle, int* pMapMode)
+{
+    ContextScope ctx(handle);
+    SC_DEV_HANDLE sdkHandle = ctx.SdkHandle();
+    if (!sdkHandle || !pMapMode) return -1;
+
+    SC_PseudoColorMap mode;
+    int ret = SC_GetPseudoColorMap(sdkHandle, mode);
+    if (ret == SC_OK)
+    {
+        *pMapMode = static_cast<int>(mode);
+    }
+    return ret;
+}
+
+REVEALER_API ErrorCode Camera_AttachProcessedGrabbing(CameraHandle handle, FrameCallBack proc, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !featureName) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !proc) return -1;
 
-    return SC_ExecuteCommandFeature(sdkHandle, featureName);
-}
+    // ûصϢԭ滻֡ص߳
+    int ret = SetCallback(ctx->processedFrameSlot, reinterpret_cast<void*>(proc), pUser);
+    if (ret != SC_OK) return ret;
 
-// =================================================================
-// 5.7 ¼ص
-// =================================================================
+    // עSDKصΪû
+    return SC_AttachProImgGrabbing(ctx->sdkHandle, OnProcessedFrameCallback, ctx);
+}
 
 /// <summary>
-/// 豸״̬¼صע
+/// ȡͼĻصע
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="proc">豸״̬¼ص
-///   ص˵
-///   - isConnected: 1=豸ӣ0=豸ѶϿ
-///   - cameraKey: 豸кţΨһʶ
-///   - pUser: ûԶ
-/// </param>
-/// <param name="pUser">ûԶݣΪNULL</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// Ҫ˵
-/// - ֻעһΣUSB豸ȲЧ
-/// - صڶִ߳Уע̰߳ȫ
-/// - ó豸ȲΣԶ
+/// ҪSDKҪͬɼGetProcessedFrame첽ɼصͬʱ
+/// ʹͬʽǰȡ첽ص
 /// 
-/// ʹʾ
-/// void onConnect(int isConnected, const char* cameraKey, void* pUser) {
-///     if (isConnected) {
-///         printf("Device connected: %s\n", cameraKey);
-///     } else {
-///         printf("Device disconnected: %s\n", cameraKey);
-///     }
-/// }
-/// Camera_SubscribeConnectArg(handle, onConnect, nullptr);
+/// غ֤ûصٱãҲִеĻص
+/// ڻصڲñʱ⣩
 /// </remarks>
-REVEALER_API ErrorCode Camera_SubscribeConnectArg(CameraHandle handle, ConnectCallBack proc, void* pUser)
+REVEALER_API ErrorCode Camera_DetachGrabbing(CameraHandle handle)
 {
-    if (!proc) return -1;
-
-    // ? ״̬صȫֵģҪ豸
-    // ? ֱӴ nullptr  SDK
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    // ûصϢʹhandleʶnullptr(CameraHandle)-1
-    CameraHandle globalHandle = (CameraHandle)(intptr_t)-1; // ʹֵʾȫֻص
-    CallbackInfo info;
-    info.userCallback = reinterpret_cast<void*>(proc);
-    info.userData = pUser;
-    g_connectCallbackMap[globalHandle] = info;
+    // ջصۣȴִе֡ص˳
+    SetCallback(ctx->processedFrameSlot, nullptr, nullptr);
 
-    // ? עSDKصһ nullptr
-    return SC_SubscribeConnectArg(nullptr, OnConnectCallback, (void*)globalHandle);
+    // SDKӿȡصnullptrȡעᣩ
+    return SC_AttachProImgGrabbing(ctx->sdkHandle, nullptr, nullptr);
 }
 
 /// <summary>
-/// ¼صע
+/// עԭʼͼݻص첽㿽
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="proc">ע¼ص
-///   ص˵
-///   - featureName: Ӱ
-///   - pUser: ûԶ
-/// </param>
-/// <param name="pUser">ûԶݣΪNULL</param>
+/// <param name="proc">ص</param>
+/// <param name="pUser">ûԶ</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// Ҫ˵
-/// - ֻעһΣرҪע
-/// - ĳԵ仯ʱ
-/// - οĵ3.3ڵ
-/// 
-/// ⴦ԣ
-/// - ExposureTimeعʱ䣩ͨ˻ص֪ͨ
-/// - AcquisitionFrameRateɼ֡ʣͨ˻ص֪ͨ
-/// - Աضȷʵֵ
+/// Camera_AttachProcessedGrabbing
+/// - SDK/Աȶ/Gamma/α/ת
+/// - pDataֱָSDKκθ
+/// - ʺԭʼMono16ݵĴ浵ͷ
 /// 
-/// ʹó
-/// - ̬UIʾ
-/// - ͬ״̬
-/// - ¼Ա仯־
-/// 
-/// ʹʾ
-/// void onParamUpdate(const char* featureName, void* pUser) {
-///     printf("Parameter updated: %s\n", featureName);
-///     // ¶ȡԵֵԸUI
-/// }
-/// Camera_SubscribeParamUpdateArg(handle, onParamUpdate, nullptr);
+/// ע⣺
+/// - Camera_AttachProcessedGrabbingͬʱʹ
+///   磺ͼʾԭʼͼڲɼ浵
+/// - pDataڻصڼЧҪʱCamera_LeaseFrame
+/// - صڱĲɼִ߳УͨSC_GetFrameȡɼйø߳
+/// - Camera_GetFrame⣬ֻѡһ
+/// - ڻصвҪִкʱ
 /// </remarks>
-REVEALER_API ErrorCode Camera_SubscribeParamUpdateArg(CameraHandle handle, ParamUpdateCallBack proc, void* pUser)
+REVEALER_API ErrorCode Camera_AttachRawGrabbing(CameraHandle handle, FrameCallBack proc, void* pUser)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !proc) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !proc) return -1;
 
-    // ûصϢ
-    CallbackInfo info;
-    info.userCallback = reinterpret_cast<void*>(proc);
-    info.userData = pUser;
-    g_paramUpdateCallbackMap[handle] = info;
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
+
+    // ûصϢ봦ͼصʹòͬĻصۣ
+    int ret = SetCallback(ctx->rawFrameSlot, reinterpret_cast<void*>(proc), pUser);
+    if (ret != SC_OK) return ret;
 
-    // עSDKصhandleΪû
-    return SC_SubscribeParamUpdateArg(sdkHandle, OnParamUpdateCallback, handle);
+    // ɼ̣߳ʱֻ滻ص
+    // ɱȡ黹ԭʼ֡صпͨCamera_LeaseFrame㿽ͼ
+    StartGrabThread(ctx);
+    return SC_OK;
 }
 
 /// <summary>
-/// ĵ״̬֪ͨص
+/// ȡԭʼͼĻصע
 /// </summary>
 /// <param name="handle">豸</param>
-/// <param name="proc">״̬ص
-///   ص˵
-///   - status: ״̬
-///     0 = eExportStart      - ʼ
-///     1 = eExportProcessing - 
-///     2 = eExportFinish     - 
-///     3 = eExportClose      - ر
-///   - progress: ȣ0-100
-///   - pUser: ûԶ
-/// </param>
-/// <param name="pUser">ûԶݣΪNULL</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// Ҫ˵
-/// - ֻעһ
-/// - ڼشͼ񵼳Ľ
-/// - صڶִ߳
-/// 
-/// ó
-/// - ͼʱʾ
-/// - ɺ֪ͨ
-/// - ʧܵĴ
-/// 
-/// ʹʾ
-/// void onExport(int status, int progress, void* pUser) {
-///     switch(status) {
-///         case 0: printf("Export started\n"); break;
-///         case 1: printf("Exporting... %d%%\n", progress); break;
-///         case 2: printf("Export completed!\n"); break;
-///         case 3: printf("Export closed\n"); break;
-///     }
-/// }
-/// Camera_SubscribeExportNotify(handle, onExport, nullptr);
+/// - Ӱ촦ͼص
+/// - غ֤ûصٱ
+/// - ֡Ӱ죬Camera_ReturnFrame黹
 /// </remarks>
-REVEALER_API ErrorCode Camera_SubscribeExportNotify(CameraHandle handle, ExportEventCallBack proc, void* pUser)
+REVEALER_API ErrorCode Camera_DetachRawGrabbing(CameraHandle handle)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !proc) return -1;
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    // ûصϢ
-    CallbackInfo info;
-    info.userCallback = reinterpret_cast<void*>(proc);
-    info.userData = pUser;
-    g_exportCallbackMap[handle] = info;
+    LifecycleScope lifecycle(ctx);
+    if (!lifecycle) return SC_BUSY;
 
-    // עSDKصhandleΪû
-    // ע⣺ExportEventCBǩصͬ
-    return SC_SubscribeExportNotify(sdkHandle, OnExportCallback, handle);
-}
+    // ֹͣɼ̣߳ջص
+    StopGrabThread(ctx);
+    int ret = SetCallback(ctx->rawFrameSlot, nullptr, nullptr);
 
-// =================================================================
-// 5.8 ܣ߼ͼ
-// =================================================================
+    // ɼл򱾿¼ʹʱɼ߳
+    if (IsGrabThreadNeeded(ctx)) StartGrabThread(ctx);
+    return ret;
+}
 
 /// <summary>
-/// Զع
+/// ROIȤ
 /// </summary>
-/// <param name="mode">Զعģʽ
-///   0 = ģʽeAutoExpCenter- ͼ
-///   1 = ҲģʽeAutoExpRight- ͼҲ
-///   2 = رգeAutoExpInvalid
-/// </param>
-/// <param name="targetGray">ĿҶֵ
-///   Χͨ0-255
-///   -1 = ʹĬֵ
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// Զع⹤ԭ
-/// 1. ɼһ֡ͼ
-/// 2. ָƽҶ
-/// 3. ĿҶȱȽ
-/// 4. عʱʹҶȽӽĿֵ
-/// 
-/// ģʽѡ
-/// - Center: ʺΪҪע
-/// - Right: ʺҲҪݵĳ
-/// - Invalid: رԶع
-/// 
-/// ʹ̣
-/// 1. SetAutoExposureParamò
-/// 2. AutoExposureִԶع
-/// 3. SDKԶExposureTime
-/// </remarks>
-REVEALER_API ErrorCode Camera_SetAutoExposureParam(CameraHandle handle, int mode, int targetGray)
+REVEALER_API ErrorCode Camera_SetROI(CameraHandle handle, long long width, long long height,
+    long long offsetX, long long offsetY)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-
-    SC_AutoExpParam param;
-    param.origTargetGray = targetGray;
-
-	// תģʽö
-	switch (mode)
-	{
-	case 0: param.mode = eAutoExpCenter; break;
-	case 1: param.mode = eAutoExpRight; break;
-	case 2: param.mode = eAutoExpInvalid; break;
-	default: param.mode = eAutoExpInvalid; break;
-	}
+    ContextScope ctx(handle);
+    if (!ctx || !ctx->sdkHandle) return -1;
 
-    return SC_SetAutoExposureParam(sdkHandle, &param);
+    int ret = SC_SetROI(ctx->sdkHandle, width, height, offsetX, offsetY);
+    if (ret == SC_OK) ctx->featureCache.Clear();
+    return ret;
 }
 
+// =================================================================
+// 5.9 ͼSDK
+// =================================================================
+
 /// <summary>
-/// ִԶع
+/// ɫģʽʾ
+/// δõһȡλȫΧ
 /// </summary>
-/// <param name="pActualGray">ʵʴﵽĿҶ</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// ע⣺
-/// - ڲɼ״̬µ
-/// - ԶExposureTime
-/// - ҪGetExposureTimeȡʵֵ
-/// </remarks>
-REVEALER_API ErrorCode Camera_AutoExposure(CameraHandle handle, int* pActualGray)
+static void ResolveDisplayWindow(const DisplayParam* pParam, int bitDepth, unsigned int* pLeft, unsigned int* pRight)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
-
-    SC_AutoExpParam param;
-    int ret = SC_AutoExposure(sdkHandle, &param);
+    unsigned int maxValue = (1u << bitDepth) - 1;
+    unsigned int left = 0;
+    unsigned int right = maxValue;
 
-    if (ret == SC_OK && pActualGray)
+    if ((pParam->levelMode == AutoLevel_L || pParam->levelMode == AutoLevel_RL) && pParam->leftLevel > 0)
     {
-        *pActualGray = param.origTargetGray;
+        left = static_cast<unsigned int>(pParam->leftLevel);
+    }
+    if ((pParam->levelMode == AutoLevel_R || pParam->levelMode == AutoLevel_RL) && pParam->rightLevel > 0)
+    {
+        right = static_cast<unsigned int>(pParam->rightLevel);
     }
 
-    return ret;
+    *pLeft = left > maxValue ? maxValue : left;
+    *pRight = right > maxValue ? maxValue : right;
 }
 
 /// <summary>
-/// Զɫģʽ
+/// ĵת/תñ任ͼ
+/// δʱֱӷԴͼ񣻷任̸߳õʱ
 /// </summary>
-/// <param name="mode">ɫģʽ
-///   0 = رգeAutoLevelOff
-///   1 = ɫףeAutoLevelR- Զ
-///   2 = ɫףeAutoLevelL- Զ
-///   3 = ɫףeAutoLevelRL- ͬʱ͸
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
+/// <returns>任ͼԴͼpTemp</returns>
+static const ImageData* ApplyDisplayOrientation(CameraContext* ctx, const ImageData* pSrc, int pixelBytes,
+    ImageData* pTemp)
+{
+    int rotation = ctx->displayRotation.load();
+    int flip = ctx->displayFlip.load();
+    if (rotation == Rotate_0 && flip < 0) return pSrc;
+
+    int width = 0;
+    int height = 0;
+    GetTransformedSize(pSrc->width, pSrc->height, rotation, &width, &height);
+
+    static thread_local std::vector<uint8_t> t_orientBuffer;
+    size_t stride = static_cast<size_t>(width) * pixelBytes;
+    if (t_orientBuffer.size() < stride * height) t_orientBuffer.resize(stride * height);
+
+    TransformImage(pSrc->pData, pSrc->stride, pSrc->width, pSrc->height, pixelBytes, rotation, flip,
+        t_orientBuffer.data(), stride);
+
+    *pTemp = *pSrc;
+    pTemp->width = width;
+    pTemp->height = height;
+    pTemp->stride = static_cast<int>(stride);
+    pTemp->dataSize = static_cast<int>(stride * height);
+    pTemp->pData = t_orientBuffer.data();
+    return pTemp;
+}
+
+/// <summary>
+/// תΪ8λʾͼ
+/// ;ڱɫ׺gammaӳ䣬ԤҪSDKĴͼ
+/// </summary>
+/// <param name="handle">豸</param>
+/// <param name="pSrc">ԴͼCamera_GetFrameCamera_PopFrameصеͼ</param>
+/// <param name="pParam">ɫ/gamma</param>
+/// <param name="pDst">dstStride*heightֽ</param>
+/// <param name="dstStride">пȣֽڣСwidth</param>
+/// <returns>SC_OK(0)ʾɹSC_NOT_SUPPORTʾظʽ֧</returns>
 /// <remarks>
-/// ɫ׵ԭ
-/// - ɫףͼֵӳ
-/// - ɫףͼֵӳ
-/// - ĿģʾΧǿԱȶ
+/// ӳ
+/// - [ɫ, ɫ]ӳ䵽[0, 255]gammaУ = ^gamma
+/// - ɫCamera_SetAutoLevelValueһ£
+///   ɫӳΪ0ɫӳΪ255
+/// - levelModeδõһֵࣨΪ0ȡλȫΧMono12Ϊ[0, 4095]
 /// 
-/// Ӧã
-/// - ͼʹɫ
-/// - ͼʹɫѹ߹
-/// - ͶԱȶȣʹɫͬʱ
+/// ܣ
+/// - CPUԶѡAVX2/SSE4.1/ʵ
+/// - gammaΪ1.0ʱΪSIMD㣻gamma4096ұڲʱ
 /// 
 /// ע⣺
-/// - ɫͼ
-/// - ıɼ
-/// - ӰͼʾЧ
+/// - ֧Mono8/Mono10/Mono12/Mono14/Mono16ִ֧ʽMono12p
+/// - ̵߳ã߳̿ͬʱת
+/// - ͨCamera_SetDisplayOrientationת/תʱΪ任ͼ
+///   ת90/270ʱ߻dstStride任Ŀȼ㣩
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetAutoLevels(CameraHandle handle, int mode)
+REVEALER_API ErrorCode Camera_ConvertToDisplay8(CameraHandle handle, const ImageData* pSrc,
+    const DisplayParam* pParam, unsigned char* pDst, int dstStride)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !pSrc || !pParam || !pDst || !pSrc->pData) return -1;
 
-    SC_AutoLevelMode levelMode;
-    switch (mode)
+    if (pSrc->width <= 0 || pSrc->height <= 0) return SC_INVALID_PARAM;
+
+    int bitDepth = GetPixelBitDepth(pSrc->pixelFormat);
+    int pixelBytes = GetPixelBytes(pSrc->pixelFormat);
+    if (bitDepth == 0) return SC_NOT_SUPPORT;
+    if (pSrc->stride < pSrc->width * pixelBytes) return SC_INVALID_PARAM;
+
+    ImageData oriented;
+    pSrc = ApplyDisplayOrientation(ctx, pSrc, pixelBytes, &oriented);
+    if (dstStride < pSrc->width) return SC_INVALID_PARAM;
+
+    double gamma = pParam->gamma > 0.0 ? pParam->gamma : 1.0;
+
+    unsigned int left = 0;
+    unsigned int right = 0;
+    ResolveDisplayWindow(pParam, bitDepth, &left, &right);
+
+    if (pixelBytes == 2)
     {
-    case 0: levelMode = eAutoLevelOff; break;
-    case 1: levelMode = eAutoLevelR; break;
-    case 2: levelMode = eAutoLevelL; break;
-    case 3: levelMode = eAutoLevelRL; break;
-    default: levelMode = eAutoLevelOff; break;
+        ConvertMono16ToDisplay8(reinterpret_cast<const uint16_t*>(pSrc->pData), pSrc->stride,
+            pSrc->width, pSrc->height, left, right, gamma, pDst, dstStride);
     }
-
-    return SC_SetAutoLevels(sdkHandle, levelMode);
+    else
+    {
+        ConvertMono8ToDisplay8(pSrc->pData, pSrc->stride,
+            pSrc->width, pSrc->height, left, right, gamma, pDst, dstStride);
+    }
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡԶɫģʽ
+/// ñʾתת/ת
+/// ;лʱҪֹͣ/¿ʼɼһ֡Ч
 /// </summary>
-REVEALER_API ErrorCode Camera_GetAutoLevels(CameraHandle handle, int* pMode)
+/// <param name="handle">豸</param>
+/// <param name="rotation">ת˳ʱ룩0 = 0, 1 = 90, 2 = 180, 3 = 270</param>
+/// <param name="flip">ת-1 = ת, 0 = ֱ, 1 = ˮƽ, 2 = ֱ+ˮƽ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - תٶתͼת
+/// - Camera_ConvertToDisplay8Camera_ColorizeToBgra32
+/// - SDKת/תCamera_SetImageProcessingValue໥
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetDisplayOrientation(CameraHandle handle, int rotation, int flip)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pMode) return -1;
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    SC_AutoLevelMode mode = eAutoLevelOff;
-    int ret = SC_GetAutoLevels(sdkHandle, mode);
-
-    if (ret == SC_OK)
-    {
-        switch (mode)
-        {
-        case eAutoLevelOff: *pMode = 0; break;
-        case eAutoLevelR: *pMode = 1; break;
-        case eAutoLevelL: *pMode = 2; break;
-        case eAutoLevelRL: *pMode = 3; break;
-        default: *pMode = 0; break;
-        }
-    }
+    if (rotation < Rotate_0 || rotation > Rotate_270) return SC_INVALID_PARAM;
+    if (flip < -1 || flip > Flip_XY) return SC_INVALID_PARAM;
 
-    return ret;
+    ctx->displayRotation.store(rotation);
+    ctx->displayFlip.store(flip);
+    return SC_OK;
 }
 
 /// <summary>
-/// ɫֵ
+/// ת/תһ֡ͼ
 /// </summary>
-/// <param name="mode">1=ɫ, 2=ɫ</param>
-/// <param name="value">ֵ
-///   Χ0-65535
-///   ɫףСڴֵӳΪ0
-///   ɫףڴֵӳΪֵ
-/// </param>
+/// <param name="handle">豸</param>
+/// <param name="pSrc">ԴͼMono8/Mono10/Mono12/Mono14/Mono16</param>
+/// <param name="rotation">ת˳ʱ룩0 = 0, 1 = 90, 2 = 180, 3 = 270</param>
+/// <param name="flip">ת-1 = ת, 0 = ֱ, 1 = ˮƽ, 2 = ֱ+ˮƽ</param>
+/// <param name="pDst">УԴͼص</param>
+/// <param name="dstSize">СֽڣСԴͼwidth*height*ÿֽ</param>
+/// <param name="pResult">任ͼpDataָpDst</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ʹʾ
-/// // ɫֵΪ100ü
-/// Camera_SetAutoLevelValue(handle, 2, 100);
-/// 
-/// // ɫֵΪ60000߹ü
-/// Camera_SetAutoLevelValue(handle, 1, 60000);
-/// 
-/// Զ
-/// - ֶãExecuteAutoLevelԶʵֵ
+/// - ɵ÷ãÿʾһ飩ÿ֡
+/// - 90/270ʹ÷ֿתã2048x2048 Mono16ڶԼΪ1
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetAutoLevelValue(CameraHandle handle, int mode, int value)
+REVEALER_API ErrorCode Camera_TransformFrame(CameraHandle handle, const ImageData* pSrc, int rotation, int flip,
+    unsigned char* pDst, int dstSize, ImageData* pResult)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !pSrc || !pDst || !pResult || !pSrc->pData) return -1;
 
-    // ƷΧ
-    if (value < 0) value = 0;
-    if (value > 65535) value = 65535;
+    if (rotation < Rotate_0 || rotation > Rotate_270) return SC_INVALID_PARAM;
+    if (flip < -1 || flip > Flip_XY) return SC_INVALID_PARAM;
+    if (pSrc->width <= 0 || pSrc->height <= 0) return SC_INVALID_PARAM;
 
-    SC_AutoLevelMode levelMode = (mode == 1) ? eAutoLevelR : eAutoLevelL;
-    return SC_SetAutoLevelValue(sdkHandle, levelMode, value);
+    int pixelBytes = GetPixelBytes(pSrc->pixelFormat);
+    if (pixelBytes == 0) return SC_NOT_SUPPORT;
+    if (pSrc->stride < pSrc->width * pixelBytes) return SC_INVALID_PARAM;
+
+    int width = 0;
+    int height = 0;
+    GetTransformedSize(pSrc->width, pSrc->height, rotation, &width, &height);
+
+    long long required = static_cast<long long>(width) * height * pixelBytes;
+    if (dstSize < required) return SC_INVALID_PARAM;
+
+    TransformImage(pSrc->pData, pSrc->stride, pSrc->width, pSrc->height, pixelBytes, rotation, flip,
+        pDst, static_cast<size_t>(width) * pixelBytes);
+
+    *pResult = *pSrc;
+    pResult->width = width;
+    pResult->height = height;
+    pResult->stride = width * pixelBytes;
+    pResult->dataSize = static_cast<int>(required);
+    pResult->pData = pDst;
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡɫֵ
+/// ûαʱ
 /// </summary>
-REVEALER_API ErrorCode Camera_GetAutoLevelValue(CameraHandle handle, int mode, int* pValue)
+/// <param name="handle">豸</param>
+/// <param name="pLut">αʱÿΪBGRA0xAARRGGBBnullptrʾ</param>
+/// <param name="entryCount">2564096</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - е0ӦɫףһӦɫ
+/// - úͨCamera_ColorizeToBgra32(colorMap = PseudoColor_Custom)ʹ
+/// - ݱƣ÷غͷpLut
+/// </remarks>
+REVEALER_API ErrorCode Camera_SetPseudoColorLut(CameraHandle handle, const unsigned int* pLut, unsigned int entryCount)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pValue) return -1;
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    SC_AutoLevelMode levelMode = (mode == 1) ? eAutoLevelR : eAutoLevelL;
-    int value = 0;
-    int ret = SC_GetAutoLevelValue(sdkHandle, levelMode, value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    std::lock_guard<std::mutex> lock(ctx->colorLutLock);
+    if (!pLut)
+    {
+        ctx->userColorLut.clear();
+        return SC_OK;
+    }
+
+    if (entryCount != 256 && entryCount != kColorTableSize) return SC_INVALID_PARAM;
+
+    ctx->userColorLut.assign(pLut, pLut + entryCount);
+    return SC_OK;
 }
 
 /// <summary>
-/// ִһԶɫ
+/// ɫΪBGRA32
+/// ;ڱαӳ䣬ʾαʲҪSDKĴͼ
 /// </summary>
-/// <param name="mode">
-///   1 = ɫ
-///   2 = ɫ
-///   3 = ɫףƼ
+/// <param name="handle">豸</param>
+/// <param name="pSrc">ԴͼMono8/Mono10/Mono12/Mono14/Mono16</param>
+/// <param name="pParam">ɫ/gammaCamera_ConvertToDisplay8ͬ</param>
+/// <param name="colorMap">αģʽ
+///   0 = HSV, 1 = Jet, 2 = , 3 = , 4 = 
+///   100 = ûαʱCamera_SetPseudoColorLut
 /// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
+/// <param name="pDst">dstStride*heightֽ</param>
+/// <param name="dstStride">пȣֽڣСwidth*4</param>
+/// <returns>SC_OK(0)ʾɹSC_NOT_SUPPORTʾظʽ֧֣SC_INVALID_PARAMʾαģʽЧδûαʱ</returns>
 /// <remarks>
-/// ִк
-/// - SDKԶǰͼ
-/// - ɫֵ
-/// - ɫײ
-/// - ͼӦµɫӳ
+/// ʵ֣
+/// - αʱgammaȺϳΪ4096ɫ16λͼSIMDӳ䵽12λ
+/// - ΪBGRAAlpha=255WPFPixelFormats.Bgra32һ
 /// 
-/// ʹʱ
-/// - ı
-/// - л
-/// - ԱȶȲʱ
+/// ע⣺
+/// - αʵɫSDKαʲ֤ȫһ
+/// - ̵߳
+/// - ת/תͬЧCamera_ConvertToDisplay8
 /// </remarks>
-REVEALER_API ErrorCode Camera_ExecuteAutoLevel(CameraHandle handle, int mode)
+REVEALER_API ErrorCode Camera_ColorizeToBgra32(CameraHandle handle, const ImageData* pSrc,
+    const DisplayParam* pParam, int colorMap, unsigned char* pDst, int dstStride)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !pSrc || !pParam || !pDst || !pSrc->pData) return -1;
 
-    SC_AutoLevelMode levelMode;
-    switch (mode)
+    if (pSrc->width <= 0 || pSrc->height <= 0) return SC_INVALID_PARAM;
+
+    int bitDepth = GetPixelBitDepth(pSrc->pixelFormat);
+    int pixelBytes = GetPixelBytes(pSrc->pixelFormat);
+    if (bitDepth == 0) return SC_NOT_SUPPORT;
+    if (pSrc->stride < pSrc->width * pixelBytes) return SC_INVALID_PARAM;
+    if (colorMap != PseudoColor_Custom && !GetBuiltinColorMap(colorMap)) return SC_INVALID_PARAM;
+
+    ImageData oriented;
+    pSrc = ApplyDisplayOrientation(ctx, pSrc, pixelBytes, &oriented);
+    if (dstStride < pSrc->width * 4) return SC_INVALID_PARAM;
+
+    double gamma = pParam->gamma > 0.0 ? pParam->gamma : 1.0;
+
+    // ϳɫûڸƺϳɣɫ̲
+    static thread_local uint32_t t_colorTable[kColorTableSize];
+    if (colorMap == PseudoColor_Custom)
     {
-    case 1: levelMode = eAutoLevelR; break;
-    case 2: levelMode = eAutoLevelL; break;
-    case 3: levelMode = eAutoLevelRL; break;
-    default: levelMode = eAutoLevelRL; break;
+        std::lock_guard<std::mutex> lock(ctx->colorLutLock);
+        if (ctx->userColorLut.empty()) return SC_INVALID_PARAM;
+
+        BuildColorTable(ctx->userColorLut.data(), static_cast<unsigned int>(ctx->userColorLut.size()),
+            gamma, t_colorTable);
     }
+    else
+    {
+        const uint32_t* lut = GetBuiltinColorMap(colorMap);
+        if (!lut) return SC_INVALID_PARAM;
 
-    return SC_ExecuteAutoLevel(sdkHandle, levelMode);
+        BuildColorTable(lut, kColorTableSize, gamma, t_colorTable);
+    }
+
+    unsigned int left = 0;
+    unsigned int right = 0;
+    ResolveDisplayWindow(pParam, bitDepth, &left, &right);
+
+    ColorizeToBgra32(pSrc->pData, pSrc->stride, pSrc->width, pSrc->height, pixelBytes,
+        left, right, t_colorTable, pDst, dstStride);
+    return SC_OK;
 }
 
 /// <summary>
-/// ͼʹ
+/// ֱͼ
 /// </summary>
-/// <param name="feature">ͣμSDKĵ6.1
-///   0 = eBrightness  - ȵ [-100, 100], Ĭ50
-///   1 = eContrast    - Աȶ [0, 100], Ĭ50
-///   2 = eGamma       - GammaУ [0, 100], Ĭ56
-///   3 = ePseudoColor - αӳ䣨öٶ壩
-///   4 = eRotation    - תöٶ壩
-///   5 = eFlip        - תöٶ壩
-/// </param>
-/// <param name="enable">1=, 0=</param>
-/// <returns>SC_OK(0)ʾɹ</returns>
+/// <param name="handle">豸</param>
+/// <param name="pSrc">Դͼ</param>
+/// <param name="pHistogram">binCount</param>
+/// <param name="binCount">Ͱ2ݣΧ[16, 65536]</param>
+/// <returns>SC_OK(0)ʾɹSC_NOT_SUPPORTʾظʽ֧</returns>
 /// <remarks>
-/// ͼ̣
-/// 1. Ĵ
-/// 2. ô
-/// 3. GetProcessedFrameȡͼ
+/// ͰĻ֣
+/// - λȷ֣Mono12binCount=256ʱÿͰ16ֵ
+/// - binCount2^λʱλͰΪ0
 /// 
-/// ܿǣ
-/// - ÿõĹܶӴʱ
-/// - ֻñĹ
-/// - Զ̬
+/// ܣ
+/// - ̼߳㣬2048x2048 Mono16ԼΪ뼶
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetImageProcessingEnabled(CameraHandle handle, int feature, int enable)
+REVEALER_API ErrorCode Camera_ComputeHistogram(CameraHandle handle, const ImageData* pSrc,
+    unsigned int* pHistogram, unsigned int binCount)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !pSrc || !pHistogram || !pSrc->pData) return -1;
 
-    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
-    return SC_SetImageProcessingFeatureEnabled(sdkHandle, feat, enable != 0);
+    if (binCount < 16 || binCount > 65536 || (binCount & (binCount - 1)) != 0) return SC_INVALID_PARAM;
+
+    int bitDepth = GetPixelBitDepth(pSrc->pixelFormat);
+    int pixelBytes = GetPixelBytes(pSrc->pixelFormat);
+    if (bitDepth == 0) return SC_NOT_SUPPORT;
+    if (pSrc->width <= 0 || pSrc->height <= 0 || pSrc->stride < pSrc->width * pixelBytes)
+        return SC_INVALID_PARAM;
+
+    int binBits = 0;
+    while ((1u << binBits) < binCount) binBits++;
+    unsigned int shift = bitDepth > binBits ? static_cast<unsigned int>(bitDepth - binBits) : 0;
+
+    ComputeHistogram(pSrc->pData, pSrc->stride, pSrc->width, pSrc->height, pixelBytes, shift,
+        reinterpret_cast<uint32_t*>(pHistogram), binCount);
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡͼʹ״̬
+/// ֡ͳ
+/// ;Ӧжɫ/ع⣬SDKԶɫ/Զعȴ
 /// </summary>
-REVEALER_API ErrorCode Camera_GetImageProcessingEnabled(CameraHandle handle, int feature, int* pEnable)
+/// <param name="handle">豸</param>
+/// <param name="pSrc">Դͼ</param>
+/// <param name="lowPercentile">ͰٷλΧ[0, 100]0.1</param>
+/// <param name="highPercentile">߰ٷλΧ[0, 100]99.9</param>
+/// <param name="pStats">֡ͳ</param>
+/// <returns>SC_OK(0)ʾɹSC_NOT_SUPPORTʾظʽ֧</returns>
+/// <remarks>
+/// - lowClip/highClipֱΪCamera_ConvertToDisplay8/ɫ
+/// - saturatedPixelsͳƴﵽλֵMono124095أжϹ
+/// </remarks>
+REVEALER_API ErrorCode Camera_ComputeFrameStats(CameraHandle handle, const ImageData* pSrc,
+    double lowPercentile, double highPercentile, FrameStats* pStats)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pEnable) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !pSrc || !pStats || !pSrc->pData) return -1;
 
-    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
-    bool enable = false;
-    int ret = SC_GetImageProcessingFeatureEnabled(sdkHandle, feat, enable);
-    if (ret == SC_OK) *pEnable = enable ? 1 : 0;
-    return ret;
+    if (lowPercentile < 0.0 || highPercentile > 100.0 || lowPercentile > highPercentile) return SC_INVALID_PARAM;
+
+    return ComputeImageStats(*pSrc, lowPercentile, highPercentile, pStats);
 }
 
 /// <summary>
-/// ͼֵ
+/// òɼ߳Զ֡ͳƵļ
 /// </summary>
-/// <param name="feature">ͣ0-5</param>
-/// <param name="value">ֵ
-///   ȣ[-100, 100]
-///   Աȶȣ[0, 100]
-///   Gamma[0, 100]
-///   αʣSC_PseudoColorMapö٣6.2ڣ
-///   תתģʽö٣6.5ڣ
-///   תתģʽö٣6.6ڣ
-/// </param>
+/// <param name="handle">豸</param>
+/// <param name="interval">֡0ʾرգ1ʾÿ֡</param>
+/// <param name="lowPercentile">ͰٷλΧ[0, 100]</param>
+/// <param name="highPercentile">߰ٷλΧ[0, 100]</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
 /// <remarks>
-/// ˵
-/// 
-/// ȣBrightness
-/// - ֵ䰵
-/// - 0
-/// - ֵ
-/// 
-/// ԱȶȣContrast
-/// - С50ͶԱȶ
-/// - 50
-/// - 50ǿԱȶ
-/// 
-/// Gamma
-/// - С56ǿϸ
-/// - 56ԣĬϣ
-/// - 56ǿϸ
+/// - ڱɼ߳ʱЧCamera_AttachRawGrabbingCamera_StartAcquisition
+/// - ͳ֡Ӻͻص֮ǰ㣬Ӳɼ߳ÿ֡Ĵʱ䣬֡ʱ1
+/// - ͨCamera_GetLatestFrameStatsȡ
 /// </remarks>
-REVEALER_API ErrorCode Camera_SetImageProcessingValue(CameraHandle handle, int feature, int value)
+REVEALER_API ErrorCode Camera_SetFrameStatsInterval(CameraHandle handle, unsigned int interval,
+    double lowPercentile, double highPercentile)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    ContextScope ctx(handle);
+    if (!ctx) return -1;
 
-    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
-    return SC_SetImageProcessingFeatureValue(sdkHandle, feat, value);
+    if (lowPercentile < 0.0 || highPercentile > 100.0 || lowPercentile > highPercentile) return SC_INVALID_PARAM;
+
+    {
+        std::lock_guard<std::mutex> lock(ctx->frameStatsLock);
+        ctx->frameStatsLow = lowPercentile;
+        ctx->frameStatsHigh = highPercentile;
+        if (interval == 0) memset(&ctx->latestFrameStats, 0, sizeof(FrameStats));
+    }
+    ctx->frameStatsInterval.store(interval);
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡͼֵ
+/// ȡɼ߳һμ֡ͳ
 /// </summary>
-REVEALER_API ErrorCode Camera_GetImageProcessingValue(CameraHandle handle, int feature, int* pValue)
+/// <param name="handle">豸</param>
+/// <param name="pStats">֡ͳƣpixelCountΪ0ʾͳ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+REVEALER_API ErrorCode Camera_GetLatestFrameStats(CameraHandle handle, FrameStats* pStats)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pValue) return -1;
+    ContextScope ctx(handle);
+    if (!ctx || !pStats) return -1;
 
-    SC_ImageProcessingFeature feat = static_cast<SC_ImageProcessingFeature>(feature);
-    int value = 0;
-    int ret = SC_GetImageProcessingFeatureValue(sdkHandle, feat, value);
-    if (ret == SC_OK) *pValue = value;
-    return ret;
+    std::lock_guard<std::mutex> lock(ctx->frameStatsLock);
+    *pStats = ctx->latestFrameStats;
+    return SC_OK;
 }
 
+// =================================================================
+// 5.10 ¼ļȡ
+// =================================================================
+
 /// <summary>
-/// αӳģʽ
+/// Ѵ򿪵¼ļȡ2
+/// رʱȹرվȴеĶȡͷţ֮ԸþõĽӿڷ-1
 /// </summary>
-/// <param name="mapMode">αģʽμSDKĵ6.2
-///   0 = eHsv    - HSVɫӳ
-///   1 = eJet    - Jetɫӳ䣨Matlab
-///   2 = eRed    - ɫ
-///   3 = eGreen  - ɫ
-///   4 = eBlue   - ɫ
-/// </param>
-/// <returns>SC_OK(0)ʾɹ</returns>
-/// <remarks>
-/// α;
-/// - ҶͼתΪɫͼ
-/// - ǿӾԱȶ
-/// - ʶ¶ȷֲǿȲ
-/// 
-/// ģʽѡ
-/// - Jetѧӻɫ
-/// - HSVɫ仯ƽ
-/// - Red/Green/Blueɫ䣬ʺضӦ
-/// 
-/// ʹ̣
-/// 1. αʹܣSetImageProcessingEnabled(3, 1)
-/// 2. ӳģʽSetPseudoColorMap(1) // Jet
-/// 3. ȡͼGetProcessedFrame
-/// </remarks>
-REVEALER_API ErrorCode Camera_SetPseudoColorMap(CameraHandle handle, int mapMode)
+static HandleTable g_recordingTable(2);
+
+/// <summary>
+/// ȡ
+/// ;RecordingHandleȡöȡ÷ContextScopeͬ
+/// - ʱھЧѹرյľõnullptr
+/// - ʱCamera_RecordingCloseȴͷŶȡ
+/// </summary>
+struct RecordingScope
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    RecordingHandle handle;
+    RecordingReader* reader;
 
-    SC_PseudoColorMap mode = static_cast<SC_PseudoColorMap>(mapMode);
-    return SC_SetPseudoColorMap(sdkHandle, mode);
-}
+    explicit RecordingScope(RecordingHandle h) : handle(h), reader(static_cast<RecordingReader*>(g_recordingTable.Pin(h))) {}
+
+    ~RecordingScope()
+    {
+        if (reader) g_recordingTable.Unpin(handle);
+    }
+
+    RecordingScope(const RecordingScope&) = delete;
+    RecordingScope& operator=(const RecordingScope&) = delete;
+
+    operator RecordingReader*() const { return reader; }
+    RecordingReader* operator->() const { return reader; }
+};
 
 /// <summary>
-/// ȡαӳģʽ
+/// 򿪱¼Ƶԭʼļ.rvr
 /// </summary>
-REVEALER_API ErrorCode Camera_GetPseudoColorMap(CameraHandle handle, int* pMapMode)
+/// <param name="path">ļ·¼ʱΪ'|'ָȫļ·</param>
+/// <param name="pRecording">¼ļ</param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_RESOURCEʾļʽЧ¼δͬһ飻
+/// SC_NO_MEMORYʾͬʱ򿪵¼ļ</returns>
+/// <remarks>
+/// - ļӳ䵽ڴ棬֡ݰϵͳ
+/// - ļblockIdϲΪһ֡
+/// - Camera_Initialize֮ǰ
+/// - ߳̿ͬʱȡͬһ
+/// </remarks>
+REVEALER_API ErrorCode Camera_RecordingOpen(const char* path, RecordingHandle* pRecording)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !pMapMode) return -1;
+    if (!path || !pRecording) return -1;
+    *pRecording = nullptr;
 
-    SC_PseudoColorMap mode;
-    int ret = SC_GetPseudoColorMap(sdkHandle, mode);
-    if (ret == SC_OK)
+    RecordingReader* reader = new (std::nothrow) RecordingReader();
+    if (!reader) return SC_NO_MEMORY;
+
+    int ret = reader->Open(path);
+    if (ret != SC_OK)
     {
-        *pMapMode = static_cast<int>(mode);
+        delete reader;
+        return ret;
     }
-    return ret;
+
+    RecordingHandle recording = g_recordingTable.Add(reader);
+    if (!recording)
+    {
+        delete reader;
+        return SC_NO_MEMORY;
+    }
+
+    *pRecording = recording;
+    return SC_OK;
 }
 
-REVEALER_API ErrorCode Camera_AttachProcessedGrabbing(CameraHandle handle, FrameCallBack proc, void* pUser)
+/// <summary>
+/// ر¼ļ
+/// </summary>
+/// <param name="recording">¼ļ</param>
+/// <returns>SC_OK(0)ʾɹ</returns>
+/// <remarks>
+/// - ֮ǰͨCamera_RecordingReadFrameȡõpDataȫʧЧ
+/// - ߳̽еĶȡͷţ֮ԸþõĽӿڷ-1
+/// </remarks>
+REVEALER_API ErrorCode Camera_RecordingClose(RecordingHandle recording)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle || !proc) return -1;
+    RecordingScope reader(recording);
+    if (!reader) return -1;
 
-    // ûصϢ
-    CallbackInfo info;
-    info.userCallback = reinterpret_cast<void*>(proc);
-    info.userData = pUser;
-    g_processedFrameCallbackMap[handle] = info;
+    // ȹرվ֮ԸþõĽӿڷ-1ͬʱֻһر
+    if (!g_recordingTable.Close(recording)) return -1;
 
-    // עSDKص
-    return SC_AttachProImgGrabbing(sdkHandle, OnProcessedFrameCallback, handle);
+    // ȴеĶȡͷŶȡĲ۲Ż
+    g_recordingTable.WaitUnpinned(recording, 1);
+    delete reader.reader;
+    g_recordingTable.Remove(recording);
+    return SC_OK;
 }
 
 /// <summary>
-/// ȡͼĻصע
+/// ȡ¼Ϣ
 /// </summary>
-/// <param name="handle">豸</param>
+/// <param name="recording">¼ļ</param>
+/// <param name="pInfo">ߴ硢ظʽ֡ĩ֡IDʱ</param>
 /// <returns>SC_OK(0)ʾɹ</returns>
+REVEALER_API ErrorCode Camera_RecordingGetInfo(RecordingHandle recording, RecordingInfo* pInfo)
+{
+    RecordingScope reader(recording);
+    if (!reader || !pInfo) return -1;
+
+    reader->GetInfo(pInfo);
+    return SC_OK;
+}
+
+/// <summary>
+/// ȡָ֡
+/// </summary>
+/// <param name="recording">¼ļ</param>
+/// <param name="frameIndex">֡ţΧ[0, frameCount)</param>
+/// <param name="pImage">֡ݣpDataָӳڴ</param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_PARAMʾ֡Խ</returns>
 /// <remarks>
-/// ҪSDKҪͬɼGetProcessedFrame첽ɼصͬʱ
-/// ʹͬʽǰȡ첽ص
+/// - žֱӶλҪɨļ
+/// - pDataֻCamera_RecordingClose֮ǰЧ
+/// - ѹļRecordFormat_RawLZ4֡ѹ̵߳ĻpDataڸ߳һζȡǰЧ
+/// - ״ηĳ֡ʱϵͳӴ̶
 /// </remarks>
-REVEALER_API ErrorCode Camera_DetachGrabbing(CameraHandle handle)
+REVEALER_API ErrorCode Camera_RecordingReadFrame(RecordingHandle recording, unsigned long long frameIndex,
+    ImageData* pImage)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    RecordingScope reader(recording);
+    if (!reader || !pImage) return -1;
 
-    // ӳƳ
-    g_processedFrameCallbackMap.erase(handle);
+    return reader->ReadFrame(frameIndex, pImage);
+}
 
-    // SDKӿȡصnullptrȡעᣩ
-    return SC_AttachProImgGrabbing(sdkHandle, nullptr, nullptr);
+/// <summary>
+/// ֡ID֡
+/// </summary>
+/// <param name="recording">¼ļ</param>
+/// <param name="blockId">֡ID</param>
+/// <param name="pFrameIndex">֡</param>
+/// <returns>SC_OK(0)ʾɹSC_INVALID_PARAMʾļûи֡¼ʱ</returns>
+REVEALER_API ErrorCode Camera_RecordingFindFrame(RecordingHandle recording, unsigned long long blockId,
+    unsigned long long* pFrameIndex)
+{
+    RecordingScope reader(recording);
+    if (!reader || !pFrameIndex) return -1;
+
+    return reader->FindFrame(blockId, pFrameIndex);
 }
 
 /// <summary>
-/// ROIȤ
+/// ָδرյ¼ļ̱ϵ硢дʧܣ
 /// </summary>
-REVEALER_API ErrorCode Camera_SetROI(CameraHandle handle, long long width, long long height,
-    long long offsetX, long long offsetY)
+/// <param name="path">¼ļ·¼ʱΪ'|'ָȫļ·ָ</param>
+/// <param name="pFrameCount">ָ֡¼Ϊ֮ͣΪnullptr</param>
+/// <returns>SC_OK(0)ʾɹļʱ޸ģSC_INVALID_RESOURCEʾǱ¼Ƶļ</returns>
+/// <remarks>
+/// - Ҫ¼ƽеļָܻ
+/// - ڵ֡ȷд̣֮֡У֡¼ͷ¼Ʊǡ¼С
+///   һ¼ͷҲЧʱ׷ӣ˼֮һָ֡
+/// - ʱд̻е֡޷ָϵʱ̻δ̵ֻ֡ܲмڵ֡ˢ£
+/// - ָɾļ֮Camera_RecordingOpenȡ
+/// </remarks>
+REVEALER_API ErrorCode Camera_RecoverRecording(const char* path, unsigned long long* pFrameCount)
 {
-    SC_DEV_HANDLE sdkHandle = GetSDKHandle(handle);
-    if (!sdkHandle) return -1;
+    if (!path) return -1;
 
-    return SC_SetROI(sdkHandle, width, height, offsetX, offsetY);
+    unsigned long long total = 0;
+    std::vector<std::string> paths = SplitRecordDirectories(path);
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        unsigned long long frameCount = 0;
+        ErrorCode ret = RecoverRecording(paths[i].c_str(), &frameCount);
+        if (ret != SC_OK) return ret;
+        total += frameCount;
+    }
+
+    if (pFrameCount) *pFrameCount = total;
+    return SC_OK;
 }
\ No newline at end of file
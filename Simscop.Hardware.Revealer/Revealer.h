@@ -30,7 +30,8 @@ extern "C" {
 		PseudoColor_Jet = 1,    // Jetɫӳ䣨Matlab
 		PseudoColor_Red = 2,    // ɫ
 		PseudoColor_Green = 3,  // ɫ
-		PseudoColor_Blue = 4    // ɫ
+		PseudoColor_Blue = 4,   // ɫ
+		PseudoColor_Custom = 100  // ûαʱCamera_ColorizeToBgra32
 	} PseudoColorMapMode;
 
 	// 6.3 Զعģʽö
@@ -69,20 +70,47 @@ extern "C" {
 		RecordFormat_BMP = 1,         // BMPʽݲ֧֣
 		RecordFormat_SCD = 2,         // SCDʽ
 		RecordFormat_TIFFVideo = 3,   // TIFFʽļ
+		RecordFormat_Raw = 4,         // ԭʼʽ.rvrSDK¼
+		RecordFormat_BigTIFF = 5,     // BigTIFFҳʽļ4GBƣ
+		RecordFormat_RawLZ4 = 6,      // ԭʼʽѹ + ֽڷ + LZ4
 		RecordFormat_NotSupport = 255 // ֧
 	} RecordFormat;
 
+	// ոʽö
+	typedef enum {
+		SnapshotFormat_TIFF = 0,      // ҳTIFFѹ
+		SnapshotFormat_PNG = 1,       // PNGҶͼ8/16λݲѹ
+		SnapshotFormat_Raw = 2        // ԭʼʽ֡.rvrCamera_RecordingOpenȡ
+	} SnapshotFormat;
+
+	// ԭʼ¼ƵĻѹԣ̸ʱ
+	typedef enum {
+		RecordSpill_Drop = 0,         // д̻ʱ֡Ĭϣ
+		RecordSpill_Memory = 1,       // д̻ʱдڴ㣬ڴҲʱ֡
+		RecordSpill_Decimate = 2      // ѹֵʱÿdecimation֡1֡ʱ֡
+	} RecordSpillPolicy;
+
 	// ¼ṹ
 	typedef struct {
-		char recordFilePath[512];  // ·
+		char recordFilePath[512];  // ·Raw/RawLZ4'|'ָĿ¼¼ƣ
 		char fileName[512];        // ļ
-		int recordFormat;          // 0=TIFF, 1=BMP(ݲ֧), 2=SCD, 3=TIFFVideo
+		int recordFormat;          // 0=TIFF, 1=BMP(ݲ֧), 2=SCD, 3=TIFFVideo, 4=Raw, 5=BigTIFF, 6=RawLZ4
 		int quality;               // 0-100
 		int frameRate;             // ֡
-		unsigned int startFrame;   // ʼ֡Ĭ0
-		unsigned int count;        // ɼ֡0=¼ƣ
+		unsigned int startFrame;   // ʼ֡Ĭ0¼ƸʽΪʼ֡ID0ʾʼ
+		unsigned int count;        // ɼ֡0=¼ƣ¼Ƹʽ¼Զرļ
+		unsigned long long startTimeStamp;  // ¼ƸʽʱСڸֵ֡ʼ0=ʹãstartFrame
 	} RecordParam;
 
+	// ԭʼ¼ƵĻѹ
+	typedef struct {
+		int policy;                     // RecordSpillPolicy
+		unsigned int thresholdPercent;  // ѹֵδдֽռİٷֱȣΧ[1, 100]
+		unsigned long long memoryBytes; // RecordSpill_MemoryڴԤ㣨ֽڣ64MBȡƽָ
+		unsigned int decimation;        // RecordSpill_Decimateÿ֡1֡С2
+		int notify;                     // 0ʱѹԽֵ/䵽ֵһʱͨ״̬صϱstatus=4/5
+	} RecordSpillParam;
+
 	// ö٣ӦSC_GetFeatureTypeֵ
 	typedef enum {
 		FeatureType_Integer = 0,   // 
@@ -93,12 +121,34 @@ extern "C" {
 		FeatureType_Command = 5    // 
 	} FeatureType;
 
+	// ԷģʽλϣCamera_GetFeatureTokenInfo
+	typedef enum {
+		FeatureAccess_Read = 1,     // ɶ
+		FeatureAccess_Write = 2     // д
+	} FeatureAccess;
+
+	// ɼʱĲ
+	typedef enum {
+		OverflowPolicy_DropOldest = 0,  // ɵ֡Ĭϣʼձ֡
+		OverflowPolicy_DropNewest = 1,  // µ֡
+		OverflowPolicy_Block = 2        // ɼ̣߳ȴȡ֡
+	} OverflowPolicy;
+
+	// ö
+	typedef enum {
+		StreamType_Raw = 0,         // ԭʼͼCamera_GetFrameԭʼͼصɼУ
+		StreamType_Processed = 1    // ͼCamera_GetProcessedFrameͼص
+	} StreamType;
+
 	// =================================================================
 	// Ͷ
 	// =================================================================
 
-	typedef void* CameraHandle;
+	typedef void* CameraHandle;     // еıţָ룬÷ɽã
 	typedef int ErrorCode;
+	typedef void* FrameLease;       // ֡Camera_LeaseFrameأ
+	typedef void* RecordingHandle;  // ¼ļCamera_RecordingOpenأ
+	typedef unsigned int FeatureToken;  // ƣCamera_ResolveFeatureأ0ЧֻԽľЧ
 
 	// ͼݽṹ
 	typedef struct {
@@ -112,6 +162,112 @@ extern "C" {
 		unsigned long long timeStamp;   // ʱ
 	} ImageData;
 
+	// ͳƽṹ
+	// ֱͼkͰͳ[2^k, 2^(k+1))0Ͱͬʱ0һͰиֵ
+	typedef struct {
+		unsigned long long framesDelivered;         // յ֡
+		unsigned long long framesLost;              // ֡IDۼƵĶ֡·/SDK
+		unsigned long long lastBlockId;             // һ֡֡ID
+		unsigned long long queueDroppedFrames;      // ɼж֡ߴ
+		unsigned long long intervalHistogram[24];   // ֱ֡ͼʱ̶ȣ
+		unsigned long long callbackHistogram[24];   // صʱֱͼ΢룩
+		unsigned long long callbackMaxMicroseconds; // صʱ΢룩
+		unsigned int queuedFrames;                  // ɼŶӵ֡
+		unsigned int queueCapacity;                 // ɼδʱΪ0
+		unsigned int leasedFrames;                  // е֡
+		unsigned int poolHeldFrames;                // ֡бе֡
+		unsigned int poolCapacity;                  // ֡زδʱΪ0
+		unsigned int reserved;
+	} StreamStatistics;
+
+	// ԭʼ¼ͳƽṹ¼Ϊ֮ͣ
+	// д̺ʱΪÿдһд̻64MBһܸСĺʱ
+	typedef struct {
+		unsigned long long framesReceived;          // ѽյ֡д̻ѹУ
+		unsigned long long framesWritten;           // д̵֡
+		unsigned long long framesDropped;           // ֡ϡ趪
+		unsigned long long framesDecimated;         // RecordSpill_Decimateϡ趪֡
+		unsigned long long framesSpilled;           // д̻ڴ֡
+		unsigned long long queuedFrames;            // ѽδд̵֡ѹУ
+		unsigned long long queuedBytes;             // ѽδд̵ֽ
+		unsigned long long peakQueuedBytes;         // δдֽķֵ
+		unsigned long long capacityBytes;           // д̻ + ڴ㣩
+		unsigned long long bytesReceived;           // ѽյֽļͷ֡¼ͷ
+		unsigned long long bytesWritten;            // д̵ֽ
+		unsigned long long pressureEvents;          // ѹԽֵĴ
+		double inputMBps;                           // ƽʣMB/s
+		double outputMBps;                          // ƽдʣMB/s
+		double diskMBps;                            // дʣдֽ / д̺ʱ֮ͣMB/s
+		unsigned long long writeLatencyP50;         // д̺ʱλ΢룩
+		unsigned long long writeLatencyP95;         // д̺ʱ95ٷλ΢룩
+		unsigned long long writeLatencyP99;         // д̺ʱ99ٷλ΢룩
+		unsigned long long writeLatencyMax;         // д̺ʱֵ΢룩
+		unsigned long long writeLatencyHistogram[24];   // д̺ʱֱͼ΢룬ͰĻStreamStatisticsͬ
+		unsigned int queuePercent;                  // queuedBytesռcapacityBytesİٷֱ
+		unsigned int diskBusyPercent;               // д̺ʱռ¼ʱİٷֱȣ¼ȡֵӽ100ʾ̸
+		unsigned int stripeCount;                   // 0=ûбԭʼ¼ƣ
+		int pressure;                               // 1=ѹֵδ
+	} RecordStats;
+
+	// ʾתṹɫAutoLevelModeһ£
+	typedef struct {
+		int levelMode;      // AutoLevelMode0=ر(ȫΧ), 1=ɫ, 2=ɫ, 3=ɫ
+		int leftLevel;      // ɫףСڴֵӳΪ0
+		int rightLevel;     // ɫףڴֵӳΪ255
+		double gamma;       //  = ^gamma1.0ΪԣС1
+	} DisplayParam;
+
+	// ֡ͳƽṹֵλ
+	typedef struct {
+		unsigned long long blockId;         // ͳƶӦ֡ID
+		unsigned long long pixelCount;      // 0ʾͳƣ
+		unsigned long long saturatedPixels; // ﵽλֵ
+		double mean;                        // ֵ
+		double stdDev;                      // ׼
+		int minValue;                       // Сֵ
+		int maxValue;                       // ֵ
+		int lowClip;                        // Ͱٷλ㣨ֱΪɫף
+		int highClip;                       // ߰ٷλ㣨ֱΪɫף
+	} FrameStats;
+
+	// ¼ļ.rvrϢṹ
+	typedef struct {
+		int width;                          // һ֡Ŀ
+		int height;                         // һ֡ĸ߶
+		int stride;                         // һ֡пȣֽڣ
+		int pixelFormat;                    // һ֡ظʽ
+		unsigned long long frameCount;      // ֡
+		unsigned long long firstBlockId;    // һ֡֡ID
+		unsigned long long lastBlockId;     // һ֡֡ID
+		unsigned long long firstTimeStamp;  // һ֡ʱ
+		unsigned long long lastTimeStamp;   // һ֡ʱ
+	} RecordingInfo;
+
+	// ԶдһCamera_SetFeaturesBatch/Camera_GetFeaturesBatch
+	typedef struct {
+		const char* featureName;    // ƣtokenΪ0ʱʹã
+		FeatureToken token;         // ƣ0ʱƣtypeһ£
+		int type;                   // FeatureType
+		long long intValue;         // Integer/Bool0/1ֵEnumֵsymbolΪʱֵã
+		double floatValue;          // Floatֵ
+		char symbol[64];            // Enumķţʱǿ򰴷ãStringֵ
+		int result;                 // Ĵ
+	} FeatureValue;
+
+	// öԵһCamera_GetEnumFeatureTable
+	typedef struct {
+		unsigned long long value;   // öֵ
+		const char* symbol;         // ƣУǰЧ
+	} EnumEntry;
+
+	// ֵһCamera_GetFeatureDictionary
+	typedef struct {
+		const char* name;           // 
+		int type;                   // FeatureType
+		const EnumEntry* entries;   // Enumֵʱ豸ṩöΪnullptr
+		unsigned int entryCount;    // entries
+	} FeatureInfo;
+
 	// 豸Ϣṹ
 	typedef struct {
 		char cameraName[256];
@@ -146,8 +302,8 @@ extern "C" {
 	typedef void (*ParamUpdateCallBack)(const char* featureName, void* pUser);
 
 	/// <summary>״̬ص</summary>
-	/// <param name="status">״̬0=ʼ, 1=, 2=, 3=ر</param>
-	/// <param name="progress">(0-100)</param>
+	/// <param name="status">״̬0=ʼ, 1=, 2=, 3=رգ¼4=ѹֵ, 5=ѹѻ</param>
+	/// <param name="progress">(0-100)¼Ϊд֡дʧʱstatus=3progress=-1statusΪ4/5ʱΪѹٷֱ</param>
 	/// <param name="pUser">ûԶ</param>
 	typedef void (*ExportEventCallBack)(int status, int progress, void* pUser);
 
@@ -156,6 +312,12 @@ extern "C" {
 	/// <param name="pUser">ûԶ</param>
 	typedef void (*FrameCallBack)(ImageData* pImage, void* pUser);
 
+	/// <summary>ɻص</summary>
+	/// <param name="result">SC_OK(0)ʾļд꣬Ϊ</param>
+	/// <param name="path">ļ·</param>
+	/// <param name="pUser">ûԶ</param>
+	typedef void (*SnapshotCallBack)(int result, const char* path, void* pUser);
+
 	// =================================================================
 	// 5.1 ϵͳ
 	// =================================================================
@@ -172,6 +334,7 @@ extern "C" {
 		unsigned int fileSize, unsigned int fileNum);
 
 	/// <summary>ͷSDKԴ</summary>
+	/// <remarks>ԭʼͼصCamera_AttachRawGrabbingеãʱκ</remarks>
 	REVEALER_API void Camera_Release();
 
 	/// <summary>ö豸</summary>
@@ -188,6 +351,7 @@ extern "C" {
 	REVEALER_API ErrorCode Camera_CreateHandle(CameraHandle* pHandle, int deviceIndex);
 
 	/// <summary>豸</summary>
+	/// <remarks>ڸԭʼͼصCamera_AttachRawGrabbingеãʱSC_BUSY</remarks>
 	REVEALER_API ErrorCode Camera_DestroyHandle(CameraHandle handle);
 
 	// =================================================================
@@ -235,6 +399,11 @@ extern "C" {
 	/// <summary>֡</summary>
 	REVEALER_API ErrorCode Camera_SetBufferCount(CameraHandle handle, unsigned int bufferCount);
 
+	/// <summary>֡ģʽȡ֡ʱƵ֡ز黹SDK֡</summary>
+	/// <param name="enable">1=, 0=</param>
+	/// <remarks>֡زCamera_SetBufferCountõ</remarks>
+	REVEALER_API ErrorCode Camera_SetFramePoolEnabled(CameraHandle handle, int enable);
+
 	/// <summary>ȡһ֡ͼͬ</summary>
 	/// <param name="timeout">ʱʱ(ms)0xFFFFFFFFʾ޵ȴ</param>
 	REVEALER_API ErrorCode Camera_GetFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout);
@@ -242,18 +411,93 @@ extern "C" {
 	/// <summary>ͷ֡Դ</summary>
 	REVEALER_API ErrorCode Camera_ReleaseFrame(CameraHandle handle, ImageData* pImage);
 
+	/// <summary>һ֡ͼüصغ</summary>
+	/// <param name="pImage">룺Ҫͼͼ</param>
+	/// <param name="pLease"></param>
+	/// <returns>SC_BUSYʾѴﵽ</returns>
+	REVEALER_API ErrorCode Camera_LeaseFrame(CameraHandle handle, ImageData* pImage, FrameLease* pLease);
+
+	/// <summary>黹֡üʱ黹SDK</summary>
+	REVEALER_API ErrorCode Camera_ReturnFrame(CameraHandle handle, FrameLease lease);
+
+	/// <summary>ÿͬʱ֡</summary>
+	/// <param name="maxCount">Χ[0, 64]Ĭ4</param>
+	REVEALER_API ErrorCode Camera_SetMaxLeasedFrames(CameraHandle handle, unsigned int maxCount);
+
 	/// <summary>ȡͼͬ</summary>
 	REVEALER_API ErrorCode Camera_GetProcessedFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout);
 
+	/// <summary>ɼУɼ߳ȡԭʼ֡нУ</summary>
+	/// <param name="queueCapacity">֡Χ[1, 1024]ȡΪ2</param>
+	/// <param name="overflowPolicy">ʱĲԣOverflowPolicy</param>
+	REVEALER_API ErrorCode Camera_StartAcquisition(CameraHandle handle, unsigned int queueCapacity, int overflowPolicy);
+
+	/// <summary>ֹͣɼУ֮ǰȡ֮֡ʧЧ</summary>
+	REVEALER_API ErrorCode Camera_StopAcquisition(CameraHandle handle);
+
+	/// <summary>Ӳɼȡһ֡</summary>
+	/// <param name="timeout">ʱʱ(ms)0ʾȴ0xFFFFFFFFʾ޵ȴ</param>
+	/// <remarks>ȡ֡һCamera_PopFrameǰЧͷ</remarks>
+	REVEALER_API ErrorCode Camera_PopFrame(CameraHandle handle, ImageData* pImage, unsigned int timeout);
+
+	/// <summary>ȡɼж֡͵ǰŶӵ֡</summary>
+	REVEALER_API ErrorCode Camera_GetAcquisitionStatus(CameraHandle handle, unsigned long long* pDroppedFrames,
+		unsigned int* pQueuedFrames);
+
+	/// <summary>ȡͳƣ֡֡֡/صʱֱͼռã</summary>
+	/// <param name="streamType">StreamType</param>
+	REVEALER_API ErrorCode Camera_GetStreamStatistics(CameraHandle handle, int streamType, StreamStatistics* pStatistics);
+
+	/// <summary>ͳ</summary>
+	REVEALER_API ErrorCode Camera_ResetStreamStatistics(CameraHandle handle);
+
 	/// <summary>¼</summary>
+	/// <remarks>¼ƸʽstartFrame/startTimeStampʼ¼count֡Զرļͨ״̬ص֪ͨ</remarks>
 	REVEALER_API ErrorCode Camera_OpenRecord(CameraHandle handle, RecordParam* pParam);
 
 	/// <summary>ر¼</summary>
+	/// <remarks>BigTIFFʽû¼κ֡ʱɾļSC_INVALID_RESOURCE</remarks>
 	REVEALER_API ErrorCode Camera_CloseRecord(CameraHandle handle);
 
 	/// <summary>õС</summary>
 	REVEALER_API ErrorCode Camera_SetExportCacheSize(CameraHandle handle, unsigned long long cacheSizeInByte);
 
+	/// <summary>ñԭʼ¼ƵĻѹԣһCamera_OpenRecordЧ</summary>
+	/// <param name="pParam">ѹnullptrʾָĬϣֵ֡80%ϱ</param>
+	REVEALER_API ErrorCode Camera_SetRecordSpillPolicy(CameraHandle handle, const RecordSpillParam* pParam);
+
+	/// <summary>ñԭʼ¼ƵһCamera_OpenRecordЧڱָ</summary>
+	/// <param name="frameInterval">д֡0ʾ֡</param>
+	/// <param name="milliseconds">ʱ룩0ʾʱ䣻Ĭ0֡/1000룬߶Ϊ0ʱд</param>
+	REVEALER_API ErrorCode Camera_SetRecordCheckpoint(CameraHandle handle, unsigned int frameInterval,
+		unsigned int milliseconds);
+
+	/// <summary>ȡԭʼ¼Ƶͳƣѹд̺ʱٷλʣ¼ƽһ¼Ƶͳ</summary>
+	REVEALER_API ErrorCode Camera_GetRecordStats(CameraHandle handle, RecordStats* pStats);
+
+	/// <summary>ԤʷСɼ̳߳ԭʼ֡</summary>
+	/// <param name="sizeInBytes">ڴԤ㣨ֽڣɱ֡ = Ԥ / ֡С0ʾر</param>
+	REVEALER_API ErrorCode Camera_SetHistoryBufferSize(CameraHandle handle, unsigned long long sizeInBytes);
+
+	/// <summary>ʷseconds֡Ϊ.rvrļɼжϣ</summary>
+	/// <param name="path">ļ·</param>
+	/// <param name="seconds">ʱ֡ʱ䣩Сڵ0ʾȫʷ</param>
+	/// <remarks>ڵ߳ͬд̣ʷϴʱʱɴ</remarks>
+	REVEALER_API ErrorCode Camera_SaveHistory(CameraHandle handle, const char* path, double seconds);
+
+	/// <summary>ڱı߳бʷseconds֡</summary>
+	/// <param name="path">ļ·</param>
+	/// <param name="seconds">ʱ֡ʱ䣩Сڵ0ʾȫʷ</param>
+	/// <remarks>ȺͽͨCamera_SubscribeExportNotifyĻصϱͬһʱֻһ첽</remarks>
+	REVEALER_API ErrorCode Camera_SaveHistoryAsync(CameraHandle handle, const char* path, double seconds);
+
+	/// <summary>첽浥֡գ֡صΪǰ֡Ϊһ֡߳д̺ص</summary>
+	/// <param name="path">ļ·</param>
+	/// <param name="format">ոʽSnapshotFormat</param>
+	/// <param name="proc">ɻصڱִ߳УΪnullptr</param>
+	REVEALER_API ErrorCode Camera_SnapshotAsync(CameraHandle handle, const char* path, int format,
+		SnapshotCallBack proc, void* pUser);
+
 	// =================================================================
 	// 5.6 Բ
 	// =================================================================
@@ -287,6 +531,13 @@ extern "C" {
 	REVEALER_API ErrorCode Camera_GetEnumFeatureEntryNum(CameraHandle handle, const char* featureName, unsigned int* pNum);
 	REVEALER_API ErrorCode Camera_GetEnumFeatureEntrys(CameraHandle handle, const char* featureName,
 		unsigned int* pEntryNum, unsigned long long* pEnumValues, char** pSymbols, int symbolSize);
+
+	/// <summary>ȡöԵĿֵƣرеֻǰЧ</summary>
+	/// <param name="ppEntries"></param>
+	/// <param name="pCount"></param>
+	/// <remarks>Իʱֻڲ»صԺ¶ȡͬıͬһָ</remarks>
+	REVEALER_API ErrorCode Camera_GetEnumFeatureTable(CameraHandle handle, const char* featureName,
+		const EnumEntry** ppEntries, unsigned int* pCount);
 	REVEALER_API ErrorCode Camera_GetEnumFeatureSymbol(CameraHandle handle, const char* featureName, char* symbol, int symbolSize);
 	REVEALER_API ErrorCode Camera_SetEnumFeatureSymbol(CameraHandle handle, const char* featureName, const char* symbol);
 
@@ -310,6 +561,54 @@ extern "C" {
 	/// </remarks>
 	REVEALER_API ErrorCode Camera_ExecuteCommandFeature(CameraHandle handle, const char* featureName);
 
+	// ƣѭздȽһΣ֮Ʒʣ
+	/// <summary>ػͺͷģʽƣͬԷͬһƲˢͺͷģʽ</summary>
+	/// <param name="pToken">ƣǰЧ</param>
+	REVEALER_API ErrorCode Camera_ResolveFeature(CameraHandle handle, const char* featureName, FeatureToken* pToken);
+
+	/// <summary>ȡƻͣFeatureTypeͷģʽFeatureAccessλʱ״̬</summary>
+	REVEALER_API ErrorCode Camera_GetFeatureTokenInfo(CameraHandle handle, FeatureToken token, int* pType, int* pAccess);
+
+	// ƶдͲʱSC_INVALID_PARAM
+	REVEALER_API ErrorCode Camera_GetIntFeatureByToken(CameraHandle handle, FeatureToken token, long long* pValue);
+	REVEALER_API ErrorCode Camera_SetIntFeatureByToken(CameraHandle handle, FeatureToken token, long long value);
+	REVEALER_API ErrorCode Camera_GetFloatFeatureByToken(CameraHandle handle, FeatureToken token, double* pValue);
+	REVEALER_API ErrorCode Camera_SetFloatFeatureByToken(CameraHandle handle, FeatureToken token, double value);
+	REVEALER_API ErrorCode Camera_GetEnumFeatureByToken(CameraHandle handle, FeatureToken token, unsigned long long* pValue);
+	REVEALER_API ErrorCode Camera_SetEnumFeatureByToken(CameraHandle handle, FeatureToken token, unsigned long long value);
+	REVEALER_API ErrorCode Camera_GetEnumSymbolByToken(CameraHandle handle, FeatureToken token, char* symbol, int symbolSize);
+	REVEALER_API ErrorCode Camera_SetEnumSymbolByToken(CameraHandle handle, FeatureToken token, const char* symbol);
+	REVEALER_API ErrorCode Camera_GetBoolFeatureByToken(CameraHandle handle, FeatureToken token, int* pValue);
+	REVEALER_API ErrorCode Camera_SetBoolFeatureByToken(CameraHandle handle, FeatureToken token, int value);
+	REVEALER_API ErrorCode Camera_ExecuteCommandByToken(CameraHandle handle, FeatureToken token);
+
+	/// <summary>ԣһεӦö˳򣺶ģʽ/ظʽߡƫơ֡ʡ</summary>
+	/// <param name="pItems">飬ÿresultĴ</param>
+	/// <returns>ȫɹSC_OK򷵻еһʧĴ</returns>
+	REVEALER_API ErrorCode Camera_SetFeaturesBatch(CameraHandle handle, FeatureValue* pItems, unsigned int count);
+
+	/// <summary>ȡԣ˳򣩣ÿresultĴ</summary>
+	REVEALER_API ErrorCode Camera_GetFeaturesBatch(CameraHandle handle, FeatureValue* pItems, unsigned int count);
+
+	/// <summary>/رֵ棨ĬϹرգڴã</summary>
+	/// <param name="enable">1=ã0=ر</param>
+	/// <remarks>
+	/// - ȡʱֱӴڴ淵أ»صԡõʧЧMin/Max/IncһԱ仯ʧЧ
+	/// - ExposureTimeAcquisitionFrameRateDeviceTemperature
+	/// </remarks>
+	REVEALER_API ErrorCode Camera_SetFeatureCacheEnabled(CameraHandle handle, int enable);
+
+	/// <summary>Ի棨featureNameΪnullptrʱȫ</summary>
+	REVEALER_API ErrorCode Camera_InvalidateFeatureCache(CameraHandle handle, const char* featureName);
+
+	/// <summary>ֵĻĿ¼Camera_Open֮ǰãnullptrմʾʹã</summary>
+	/// <remarks>ֵͺź͹̼汾ΪΪdirectory\ͺ_汾.rvnͬͺ̼ͬ</remarks>
+	REVEALER_API ErrorCode Camera_SetNodeMapCacheDirectory(CameraHandle handle, const char* directory);
+
+	/// <summary>ȡֵ䣨ȫԵơͺöƣǰЧ</summary>
+	/// <remarks>Ŀ¼ûпõֵʱ豸XMLѯ</remarks>
+	REVEALER_API ErrorCode Camera_GetFeatureDictionary(CameraHandle handle, const FeatureInfo** ppFeatures, unsigned int* pCount);
+
 	// =================================================================
 	// 5.7 ¼ص
 	// =================================================================
@@ -408,6 +707,19 @@ extern "C" {
 /// </summary>
 	REVEALER_API ErrorCode Camera_DetachGrabbing(CameraHandle handle);
 
+	/// <summary>עԭʼͼݻص첽㿽</summary>
+	/// <param name="proc">ص</param>
+	/// <param name="pUser">ûԶ</param>
+	/// <remarks>
+	/// - SDKͼpDataֱָSDK
+	/// - Camera_AttachProcessedGrabbingͬʱʹ
+	/// - pDataڻصڼЧ
+	/// </remarks>
+	REVEALER_API ErrorCode Camera_AttachRawGrabbing(CameraHandle handle, FrameCallBack proc, void* pUser);
+
+	/// <summary>ȡԭʼͼĻصע</summary>
+	REVEALER_API ErrorCode Camera_DetachRawGrabbing(CameraHandle handle);
+
 	/// <summary>ȡαӳģʽ</summary>
 	REVEALER_API ErrorCode Camera_GetPseudoColorMap(CameraHandle handle, int* pMapMode);
 
@@ -420,6 +732,91 @@ extern "C" {
 	REVEALER_API ErrorCode Camera_SetROI(CameraHandle handle, long long width, long long height,
 		long long offsetX, long long offsetY);
 
+	// =================================================================
+	// 5.9 ͼSDK
+	// =================================================================
+
+	/// <summary>Mono8/Mono10/Mono12/Mono14/Mono16ͼɫ״ںgammaתΪ8λʾͼ</summary>
+	/// <param name="pSrc">Դͼ񣨿ȡ֡ʽ</param>
+	/// <param name="pParam">ɫ/gamma</param>
+	/// <param name="pDst">dstStride*heightֽ</param>
+	/// <param name="dstStride">пȣֽڣСwidth</param>
+	REVEALER_API ErrorCode Camera_ConvertToDisplay8(CameraHandle handle, const ImageData* pSrc,
+		const DisplayParam* pParam, unsigned char* pDst, int dstStride);
+
+	/// <summary>ñʾתConvertToDisplay8/ColorizeToBgra32ת/תһ֡Ч</summary>
+	/// <param name="rotation">RotationMode</param>
+	/// <param name="flip">FlipMode-1ʾת</param>
+	REVEALER_API ErrorCode Camera_SetDisplayOrientation(CameraHandle handle, int rotation, int flip);
+
+	/// <summary>ת/תһ֡ͼ񵽵÷У</summary>
+	/// <param name="rotation">RotationMode</param>
+	/// <param name="flip">FlipMode-1ʾת</param>
+	/// <param name="pResult">任ͼpDataָpDst</param>
+	REVEALER_API ErrorCode Camera_TransformFrame(CameraHandle handle, const ImageData* pSrc, int rotation, int flip,
+		unsigned char* pDst, int dstSize, ImageData* pResult);
+
+	/// <summary>ûαʱBGRA0xAARRGGBB</summary>
+	/// <param name="pLut">αʱnullptrʾ</param>
+	/// <param name="entryCount">2564096</param>
+	REVEALER_API ErrorCode Camera_SetPseudoColorLut(CameraHandle handle, const unsigned int* pLut, unsigned int entryCount);
+
+	/// <summary>ɫ״ںαʱɫΪBGRA32ֱдWriteableBitmap</summary>
+	/// <param name="colorMap">PseudoColorMapModePseudoColor_Custom</param>
+	/// <param name="pDst">dstStride*heightֽ</param>
+	/// <param name="dstStride">пȣֽڣСwidth*4</param>
+	REVEALER_API ErrorCode Camera_ColorizeToBgra32(CameraHandle handle, const ImageData* pSrc,
+		const DisplayParam* pParam, int colorMap, unsigned char* pDst, int dstStride);
+
+	/// <summary>ֱͼ</summary>
+	/// <param name="pHistogram">binCount</param>
+	/// <param name="binCount">Ͱ2ݣΧ[16, 65536]2^λʱÿֵһͰ</param>
+	REVEALER_API ErrorCode Camera_ComputeHistogram(CameraHandle handle, const ImageData* pSrc,
+		unsigned int* pHistogram, unsigned int binCount);
+
+	/// <summary>֡ͳƣС//ֵ/׼/ٷλ㣩</summary>
+	/// <param name="lowPercentile">ͰٷλΧ[0, 100]0.1</param>
+	/// <param name="highPercentile">߰ٷλΧ[0, 100]99.9</param>
+	REVEALER_API ErrorCode Camera_ComputeFrameStats(CameraHandle handle, const ImageData* pSrc,
+		double lowPercentile, double highPercentile, FrameStats* pStats);
+
+	/// <summary>òɼ߳ÿ֡Զһ֡ͳ</summary>
+	/// <param name="interval">֡0ʾر</param>
+	REVEALER_API ErrorCode Camera_SetFrameStatsInterval(CameraHandle handle, unsigned int interval,
+		double lowPercentile, double highPercentile);
+
+	/// <summary>ȡɼ߳һμ֡ͳƣpixelCountΪ0ʾͳƣ</summary>
+	REVEALER_API ErrorCode Camera_GetLatestFrameStats(CameraHandle handle, FrameStats* pStats);
+
+	// =================================================================
+	// 5.10 ¼ļȡRecordFormat_Raw¼Ƶ.rvrļ
+	// =================================================================
+
+	/// <summary>¼ļļӳ䵽ڴ棬Ҫ</summary>
+	/// <param name="path">ļ·¼ʱΪ'|'ָȫļ·</param>
+	/// <param name="pRecording">¼ļ</param>
+	REVEALER_API ErrorCode Camera_RecordingOpen(const char* path, RecordingHandle* pRecording);
+
+	/// <summary>ر¼ļ֮ǰȡ֮֡ʧЧ</summary>
+	REVEALER_API ErrorCode Camera_RecordingClose(RecordingHandle recording);
+
+	/// <summary>ȡ¼Ϣ</summary>
+	REVEALER_API ErrorCode Camera_RecordingGetInfo(RecordingHandle recording, RecordingInfo* pInfo);
+
+	/// <summary>ȡframeIndex֡㿽pDataָӳڴ棬رǰЧѹļѹ̵߳Ļ</summary>
+	/// <param name="frameIndex">֡ţΧ[0, frameCount)</param>
+	REVEALER_API ErrorCode Camera_RecordingReadFrame(RecordingHandle recording, unsigned long long frameIndex,
+		ImageData* pImage);
+
+	/// <summary>֡ID֡</summary>
+	REVEALER_API ErrorCode Camera_RecordingFindFrame(RecordingHandle recording, unsigned long long blockId,
+		unsigned long long* pFrameIndex);
+
+	/// <summary>ָδرյ¼ļ֡¼ͷؽҪ</summary>
+	/// <param name="path">ļ·¼ʱΪ'|'ָȫļ·</param>
+	/// <param name="pFrameCount">ָ֡Ϊnullptr</param>
+	REVEALER_API ErrorCode Camera_RecoverRecording(const char* path, unsigned long long* pFrameCount);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,613 @@
+#include "SnapshotEncoder.h"
+#include "FrameCodec.h"
+#include "FrameMemory.h"
+#include "ImageKernels.h"
+#include "Recorder.h"
+#include <SCDefines.h>
+#include <windows.h>
+#include <chrono>
+#include <string.h>
+
+/// <summary>
+/// ȴ֡ĳʱʱ䣨룩ʱSC_TIMEOUTص
+/// </summary>
+static const unsigned int kSnapshotFrameTimeout = 2000;
+
+/// <summary>
+/// PNGÿdeflate飨ѹֽ
+/// </summary>
+static const size_t kPngBlockBytes = 65535;
+
+/// <summary>
+/// PNG黺zlibͷ(2) + ͷ(5) +  + Adler-32(4)
+/// </summary>
+static const size_t kPngChunkCapacity = 2 + 5 + kPngBlockBytes + 4;
+
+// =================================================================
+// ļд
+// =================================================================
+
+static inline void PutLe16(unsigned char* p, uint16_t v) { memcpy(p, &v, 2); }
+static inline void PutLe32(unsigned char* p, uint32_t v) { memcpy(p, &v, 4); }
+
+static inline void PutBe32(unsigned char* p, uint32_t v)
+{
+    p[0] = static_cast<unsigned char>(v >> 24);
+    p[1] = static_cast<unsigned char>(v >> 16);
+    p[2] = static_cast<unsigned char>(v >> 8);
+    p[3] = static_cast<unsigned char>(v);
+}
+
+/// <summary>
+/// ˳д루WriteFile1GB
+/// </summary>
+static bool WriteAll(HANDLE file, const void* p, size_t size)
+{
+    const unsigned char* src = static_cast<const unsigned char*>(p);
+    while (size > 0)
+    {
+        DWORD bytes = static_cast<DWORD>(size < (1u << 30) ? size : (1u << 30));
+        DWORD written = 0;
+        if (!WriteFile(file, src, bytes, &written, nullptr) || written != bytes) return false;
+        src += bytes;
+        size -= bytes;
+    }
+    return true;
+}
+
+/// <summary>
+/// ҳTIFFСˣѹһ
+/// </summary>
+static ErrorCode WriteTiff(HANDLE file, const ImageData& image)
+{
+    static const uint16_t kShort = 3;
+    static const uint16_t kLong = 4;
+    static const unsigned int kEntryCount = 11;
+    // ļͷ(8) + IFD(2) + (12 * n) + һIFDƫ(4)֮Ϊͼ
+    static const uint32_t kDataOffset = 8 + 2 + kEntryCount * 12 + 4;
+
+    int bytesPerPixel = GetPixelBytes(image.pixelFormat);
+    size_t dataBytes = static_cast<size_t>(image.dataSize);
+    if (dataBytes > 0xFFFFFFFFu - kDataOffset) return SC_NOT_SUPPORT;
+
+    unsigned char header[kDataOffset];
+    memset(header, 0, sizeof(header));
+    header[0] = 'I';
+    header[1] = 'I';
+    PutLe16(header + 2, 42);
+    PutLe32(header + 4, 8);
+    PutLe16(header + 8, kEntryCount);
+
+    unsigned char* p = header + 10;
+    struct { uint16_t tag; uint16_t type; uint32_t value; } entries[kEntryCount] = {
+        { 256, kLong, static_cast<uint32_t>(image.width) },         // ImageWidth
+        { 257, kLong, static_cast<uint32_t>(image.height) },        // ImageLength
+        { 258, kShort, static_cast<uint32_t>(bytesPerPixel * 8) },  // BitsPerSample
+        { 259, kShort, 1 },                                         // Compression
+        { 262, kShort, 1 },                                         // PhotometricInterpretationBlackIsZero
+        { 273, kLong, kDataOffset },                                // StripOffsets
+        { 277, kShort, 1 },                                         // SamplesPerPixel
+        { 278, kLong, static_cast<uint32_t>(image.height) },        // RowsPerStrip
+        { 279, kLong, static_cast<uint32_t>(dataBytes) },           // StripByteCounts
+        { 284, kShort, 1 },                                         // PlanarConfigurationChunky
+        { 339, kShort, 1 },                                         // SampleFormat޷
+    };
+    for (unsigned int i = 0; i < kEntryCount; i++, p += 12)
+    {
+        PutLe16(p, entries[i].tag);
+        PutLe16(p + 2, entries[i].type);
+        PutLe32(p + 4, 1);
+        if (entries[i].type == kShort) PutLe16(p + 8, static_cast<uint16_t>(entries[i].value));
+        else PutLe32(p + 8, entries[i].value);
+    }
+    // һIFDƫΪ0header㣩
+
+    return WriteAll(file, header, sizeof(header)) && WriteAll(file, image.pData, dataBytes) ? SC_OK : SC_ERROR;
+}
+
+static bool WritePngChunk(HANDLE file, const char* type, const unsigned char* data, size_t size)
+{
+    unsigned char head[8];
+    PutBe32(head, static_cast<uint32_t>(size));
+    memcpy(head + 4, type, 4);
+
+    unsigned char tail[4];
+    PutBe32(tail, UpdateCrc32(UpdateCrc32(0, head + 4, 4), data, size));
+
+    return WriteAll(file, head, sizeof(head)) && (size == 0 || WriteAll(file, data, size)) &&
+        WriteAll(file, tail, sizeof(tail));
+}
+
+/// <summary>
+/// PNGҶͼ8/16λ
+/// - ͼòѹdeflateװΪzlibzlibֻиƺУ
+/// - ÿdeflate鵥ΪһIDATд뻺С̶
+/// - 16λPNGҪתΪ
+/// </summary>
+static ErrorCode WritePng(HANDLE file, const ImageData& image, unsigned char* chunk)
+{
+    static const unsigned char kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    int bytesPerPixel = GetPixelBytes(image.pixelFormat);
+    size_t rowBytes = static_cast<size_t>(image.width) * bytesPerPixel;
+
+    unsigned char ihdr[13];
+    PutBe32(ihdr, static_cast<uint32_t>(image.width));
+    PutBe32(ihdr + 4, static_cast<uint32_t>(image.height));
+    ihdr[8] = static_cast<unsigned char>(bytesPerPixel * 8);   // λ
+    ihdr[9] = 0;                                                // Ҷ
+    ihdr[10] = 0;                                               // deflate
+    ihdr[11] = 0;                                               // Ӧ˲ÿ˲0
+    ihdr[12] = 0;                                               // 
+
+    if (!WriteAll(file, kSignature, sizeof(kSignature)) || !WritePngChunk(file, "IHDR", ihdr, sizeof(ihdr)))
+        return SC_ERROR;
+
+    // δѹÿ = ˲(1) + 
+    unsigned long long streamBytes = static_cast<unsigned long long>(rowBytes + 1) * image.height;
+    unsigned long long position = 0;
+    uint32_t adlerA = 1, adlerB = 0;
+    bool first = true;
+
+    do
+    {
+        size_t blockBytes = static_cast<size_t>(streamBytes - position < kPngBlockBytes ? streamBytes - position : kPngBlockBytes);
+        bool last = position + blockBytes == streamBytes;
+
+        unsigned char* p = chunk;
+        if (first)
+        {
+            // zlibͷdeflate32KڣѹFCHECKʹͷΪ31ı
+            *p++ = 0x78;
+            *p++ = 0x01;
+            first = false;
+        }
+        *p++ = last ? 1 : 0;
+        PutLe16(p, static_cast<uint16_t>(blockBytes));
+        PutLe16(p + 2, static_cast<uint16_t>(~blockBytes));
+        p += 4;
+
+        // λøƱ
+        unsigned char* data = p;
+        size_t filled = 0;
+        while (filled < blockBytes)
+        {
+            size_t row = static_cast<size_t>(position / (rowBytes + 1));
+            size_t column = static_cast<size_t>(position % (rowBytes + 1));
+            if (column == 0)
+            {
+                data[filled++] = 0;
+                position++;
+                continue;
+            }
+
+            size_t offset = column - 1;
+            size_t bytes = rowBytes - offset;
+            if (bytes > blockBytes - filled) bytes = blockBytes - filled;
+            const unsigned char* src = image.pData + row * rowBytes;
+            if (bytesPerPixel == 2)
+            {
+                // Сתˣÿֽ
+                for (size_t i = 0; i < bytes; i++) data[filled + i] = src[(offset + i) ^ 1];
+            }
+            else
+            {
+                memcpy(data + filled, src + offset, bytes);
+            }
+            filled += bytes;
+            position += bytes;
+        }
+
+        // Adler-32ÿ5552ֽȡģһβ
+        for (size_t i = 0; i < blockBytes; )
+        {
+            size_t n = blockBytes - i < 5552 ? blockBytes - i : 5552;
+            for (size_t k = 0; k < n; k++)
+            {
+                adlerA += data[i + k];
+                adlerB += adlerA;
+            }
+            adlerA %= 65521;
+            adlerB %= 65521;
+            i += n;
+        }
+        p += blockBytes;
+
+        if (last)
+        {
+            PutBe32(p, (adlerB << 16) | adlerA);
+            p += 4;
+        }
+
+        if (!WritePngChunk(file, "IDAT", chunk, p - chunk)) return SC_ERROR;
+    } while (position < streamBytes);
+
+    return WritePngChunk(file, "IEND", nullptr, 0) ? SC_OK : SC_ERROR;
+}
+
+/// <summary>
+/// ֡.rvrRecorderķѹʽͬRecordingReaderȡ
+/// </summary>
+static ErrorCode WriteRawFrame(HANDLE file, const ImageData& image)
+{
+    static const unsigned char kPadding[kFrameMemoryAlignment] = {};
+
+    size_t dataBytes = static_cast<size_t>(image.dataSize);
+    size_t slotSize = AlignFrameSize(sizeof(RawFrameHeader) + dataBytes);
+    if (slotSize > 0xFFFFFFFFu) return SC_NOT_SUPPORT;
+
+    RawFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kRawFileMagic, sizeof(kRawFileMagic));
+    header.version = kRawFileVersion;
+    header.headerSize = sizeof(RawFileHeader);
+    header.width = image.width;
+    header.height = image.height;
+    header.stride = image.stride;
+    header.pixelFormat = image.pixelFormat;
+    header.slotSize = static_cast<uint32_t>(slotSize);
+    header.codec = RawCodec_None;
+    header.frameCount = 1;
+    header.dataBytes = slotSize;
+    header.indexOffset = sizeof(RawFileHeader) + slotSize;
+    header.indexBytes = sizeof(RawIndexEntry);
+
+    RawFrameHeader frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.magic = kRawFrameMagic;
+    frame.headerSize = sizeof(RawFrameHeader);
+    frame.blockId = image.blockId;
+    frame.timeStamp = image.timeStamp;
+    frame.dataSize = static_cast<uint32_t>(dataBytes);
+    frame.recordSize = static_cast<uint32_t>(slotSize);
+    frame.width = image.width;
+    frame.height = image.height;
+    frame.stride = image.stride;
+    frame.pixelFormat = image.pixelFormat;
+    frame.storedSize = static_cast<uint32_t>(dataBytes);
+
+    RawIndexEntry entry;
+    entry.blockId = image.blockId;
+    entry.timeStamp = image.timeStamp;
+    entry.offset = sizeof(RawFileHeader);
+
+    bool ok = WriteAll(file, &header, sizeof(header)) && WriteAll(file, &frame, sizeof(frame)) &&
+        WriteAll(file, image.pData, dataBytes) &&
+        WriteAll(file, kPadding, slotSize - sizeof(RawFrameHeader) - dataBytes) &&
+        WriteAll(file, &entry, sizeof(entry));
+    return ok ? SC_OK : SC_ERROR;
+}
+
+/// <summary>
+/// ʽдļʧʱɾļ
+/// </summary>
+static ErrorCode EncodeSnapshot(const ImageData& image, const char* path, int format, unsigned char* chunk)
+{
+    HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return SC_ERROR;
+
+    ErrorCode ret;
+    switch (format)
+    {
+    case SnapshotFormat_TIFF: ret = WriteTiff(file, image); break;
+    case SnapshotFormat_PNG: ret = WritePng(file, image, chunk); break;
+    default: ret = WriteRawFrame(file, image); break;
+    }
+
+    CloseHandle(file);
+    if (ret != SC_OK) DeleteFileA(path);
+    return ret;
+}
+
+// =================================================================
+// SnapshotEncoder
+// =================================================================
+
+SnapshotEncoder::SnapshotEncoder()
+    : m_queueHead(0), m_queueCount(0), m_stopping(false), m_waiting(0), m_lastFrameBytes(0),
+    m_source(nullptr), m_sourceUser(nullptr)
+{
+    for (unsigned int i = 0; i < kSnapshotSlots; i++)
+    {
+        Slot& slot = m_slots[i];
+        slot.state = SlotState_Free;
+        slot.waitForOffer = false;
+        slot.path[0] = 0;
+        slot.format = SnapshotFormat_TIFF;
+        slot.callback = nullptr;
+        slot.pUser = nullptr;
+        slot.buffer = nullptr;
+        slot.capacity = 0;
+        memset(&slot.image, 0, sizeof(slot.image));
+        slot.fillResult = SC_OK;
+    }
+}
+
+SnapshotEncoder::~SnapshotEncoder()
+{
+    Shutdown();
+
+    for (unsigned int i = 0; i < kSnapshotSlots; i++)
+    {
+        FreeFrameMemory(m_slots[i].buffer);
+    }
+}
+
+void SnapshotEncoder::SetFrameSource(SnapshotFrameSource source, void* pSource)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_source = source;
+    m_sourceUser = pSource;
+}
+
+ErrorCode SnapshotEncoder::Submit(const ImageData* pImage, bool waitForOffer, const char* path, int format,
+    SnapshotCallBack callback, void* pUser)
+{
+    if (!path || !path[0] || strlen(path) >= sizeof(m_slots[0].path)) return SC_INVALID_PARAM;
+    if (format != SnapshotFormat_TIFF && format != SnapshotFormat_PNG && format != SnapshotFormat_Raw)
+        return SC_NOT_SUPPORT;
+    if (pImage && GetPixelBytes(pImage->pixelFormat) == 0) return SC_NOT_SUPPORT;
+
+    // ռһвۣFillingɱ̶߳ռ
+    unsigned int index = kSnapshotSlots;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_stopping) return SC_INVALID_RESOURCE;
+
+        for (unsigned int i = 0; i < kSnapshotSlots; i++)
+        {
+            if (m_slots[i].state == SlotState_Free)
+            {
+                index = i;
+                break;
+            }
+        }
+        if (index == kSnapshotSlots) return SC_BUSY;
+
+        if (m_workers.empty())
+        {
+            for (unsigned int i = 0; i < kSnapshotWorkers; i++)
+            {
+                m_workers.push_back(std::thread(&SnapshotEncoder::WorkerProc, this));
+            }
+        }
+        m_slots[index].state = SlotState_Filling;
+    }
+
+    Slot& slot = m_slots[index];
+    strcpy_s(slot.path, sizeof(slot.path), path);
+    slot.format = format;
+    slot.callback = callback;
+    slot.pUser = pUser;
+    slot.waitForOffer = waitForOffer;
+
+    int state;
+    if (pImage)
+    {
+        slot.fillResult = CopyFrame(slot, *pImage);
+        state = SlotState_Ready;
+    }
+    else
+    {
+        // һ֡ĴСԤ䣬ɼ̸߳ʱͨҪڴ
+        size_t bytes = m_lastFrameBytes.load();
+        if (bytes > slot.capacity)
+        {
+            void* buffer = AllocateFrameMemory(AlignFrameSize(bytes), nullptr);
+            if (buffer)
+            {
+                FreeFrameMemory(slot.buffer);
+                slot.buffer = static_cast<unsigned char*>(buffer);
+                slot.capacity = AlignFrameSize(bytes);
+            }
+        }
+        state = SlotState_Waiting;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        slot.state = state;
+        if (state == SlotState_Waiting) m_waiting.fetch_add(1);
+
+        m_queue[(m_queueHead + m_queueCount) % kSnapshotSlots] = index;
+        m_queueCount++;
+    }
+    m_queueCond.notify_one();
+    return SC_OK;
+}
+
+void SnapshotEncoder::Offer(const ImageData& image)
+{
+    if (m_waiting.load() == 0) return;
+
+    // еȴ֡Ĳۣ⸴
+    unsigned int claimed[kSnapshotSlots];
+    unsigned int claimedCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (unsigned int i = 0; i < kSnapshotSlots; i++)
+        {
+            if (m_slots[i].state == SlotState_Waiting)
+            {
+                m_slots[i].state = SlotState_Filling;
+                m_waiting.fetch_sub(1);
+                claimed[claimedCount++] = i;
+            }
+        }
+    }
+    if (claimedCount == 0) return;
+
+    for (unsigned int i = 0; i < claimedCount; i++)
+    {
+        Slot& slot = m_slots[claimed[i]];
+        slot.fillResult = CopyFrame(slot, image);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (unsigned int i = 0; i < claimedCount; i++)
+        {
+            m_slots[claimed[i]].state = SlotState_Ready;
+        }
+    }
+    m_frameCond.notify_all();
+}
+
+void SnapshotEncoder::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopping = true;
+    }
+    m_queueCond.notify_all();
+    m_frameCond.notify_all();
+
+    for (size_t i = 0; i < m_workers.size(); i++)
+    {
+        m_workers[i].join();
+    }
+    m_workers.clear();
+}
+
+void SnapshotEncoder::SinkProc(const ImageData& image, void* pSink)
+{
+    SinkContext* sink = static_cast<SinkContext*>(pSink);
+    sink->slot->fillResult = sink->encoder->CopyFrame(*sink->slot, image);
+}
+
+/// <summary>
+/// ֡пƵ۵Ļʱ·䣩
+/// ÷ռòۣFilling
+/// </summary>
+ErrorCode SnapshotEncoder::CopyFrame(Slot& slot, const ImageData& image)
+{
+    int bytesPerPixel = GetPixelBytes(image.pixelFormat);
+    if (bytesPerPixel == 0) return SC_NOT_SUPPORT;
+    if (!image.pData || image.width <= 0 || image.height <= 0) return SC_INVALID_PARAM;
+
+    size_t rowBytes = static_cast<size_t>(image.width) * bytesPerPixel;
+    size_t stride = image.stride > 0 ? static_cast<size_t>(image.stride) : rowBytes;
+    size_t bytes = rowBytes * image.height;
+    if (stride < rowBytes || stride * (image.height - 1) + rowBytes > static_cast<size_t>(image.dataSize) ||
+        bytes > 0x7FFFFFFF)
+        return SC_INVALID_PARAM;
+
+    if (bytes > slot.capacity)
+    {
+        FreeFrameMemory(slot.buffer);
+        slot.capacity = AlignFrameSize(bytes);
+        slot.buffer = static_cast<unsigned char*>(AllocateFrameMemory(slot.capacity, nullptr));
+        if (!slot.buffer)
+        {
+            slot.capacity = 0;
+            return SC_NO_MEMORY;
+        }
+    }
+    m_lastFrameBytes.store(bytes);
+
+    if (stride == rowBytes)
+    {
+        memcpy(slot.buffer, image.pData, bytes);
+    }
+    else
+    {
+        for (int y = 0; y < image.height; y++)
+        {
+            memcpy(slot.buffer + y * rowBytes, image.pData + y * stride, rowBytes);
+        }
+    }
+
+    slot.image = image;
+    slot.image.stride = static_cast<int>(rowBytes);
+    slot.image.pData = slot.buffer;
+    slot.image.dataSize = static_cast<int>(bytes);
+    return SC_OK;
+}
+
+/// <summary>
+/// ȴȡ̣֡߳
+/// - ȵȴɼ̣߳waitForOfferʱͨ֡Դȡ֡ȴɼ߳ʱֱͨ֡Դȡ֡
+/// - ֡ԴSC_BUSYɼ߳ʱΪȴɼ߳
+/// </summary>
+ErrorCode SnapshotEncoder::AcquireFrame(Slot& slot)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(kSnapshotFrameTimeout);
+    bool trySource = !slot.waitForOffer;
+    bool sourceTried = false;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (slot.state != SlotState_Ready)
+    {
+        if (slot.state == SlotState_Waiting)
+        {
+            if (m_stopping || (std::chrono::steady_clock::now() >= deadline && (sourceTried || !m_source)))
+            {
+                slot.state = SlotState_Filling;
+                m_waiting.fetch_sub(1);
+                return m_stopping ? SC_INVALID_RESOURCE : SC_TIMEOUT;
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline) trySource = true;
+
+            if (trySource && m_source)
+            {
+                trySource = false;
+                sourceTried = true;
+                slot.state = SlotState_Filling;
+                m_waiting.fetch_sub(1);
+
+                SnapshotFrameSource source = m_source;
+                void* sourceUser = m_sourceUser;
+                lock.unlock();
+                SinkContext sink = { this, &slot };
+                slot.fillResult = SC_ERROR;
+                ErrorCode ret = source(sourceUser, SinkProc, &sink);
+                lock.lock();
+
+                if (ret == SC_OK) return slot.fillResult;
+                if (ret != SC_BUSY) return ret;
+
+                // ɼ߳Ϊȴṩ֡
+                slot.state = SlotState_Waiting;
+                m_waiting.fetch_add(1);
+                continue;
+            }
+        }
+
+        m_frameCond.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    return slot.fillResult;
+}
+
+void SnapshotEncoder::WorkerProc()
+{
+    // PNG뻺ÿ߳һ
+    std::vector<unsigned char> chunk(kPngChunkCapacity);
+
+    for (;;)
+    {
+        unsigned int index;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_queueCond.wait(lock, [this] { return m_queueCount > 0 || m_stopping; });
+            if (m_queueCount == 0) return;
+
+            index = m_queue[m_queueHead];
+            m_queueHead = (m_queueHead + 1) % kSnapshotSlots;
+            m_queueCount--;
+        }
+
+        Slot& slot = m_slots[index];
+        ErrorCode ret = AcquireFrame(slot);
+        if (ret == SC_OK) ret = EncodeSnapshot(slot.image, slot.path, slot.format, chunk.data());
+
+        if (slot.callback) slot.callback(ret, slot.path, slot.pUser);
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            slot.state = SlotState_Free;
+        }
+    }
+}
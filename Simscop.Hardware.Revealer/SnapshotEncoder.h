@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Revealer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =================================================================
+// 첽
+// =================================================================
+
+/// <summary>
+/// ͬʱеĿ
+/// </summary>
+static const unsigned int kSnapshotSlots = 8;
+
+/// <summary>
+/// ߳
+/// </summary>
+static const unsigned int kSnapshotWorkers = 2;
+
+/// <summary>
+/// ֡ƺ֡ƽջ֡Դڹ黹֮֡ǰã
+/// </summary>
+typedef void (*SnapshotSink)(const ImageData& image, void* pSink);
+
+/// <summary>
+/// ֡Դɼ߳δṩ֡ʱɱ̵߳ãȡһ֡󽻸sink
+/// </summary>
+/// <returns>SC_OKʾȡ֡SC_BUSYʾӦȴɼֵ̣߳ʾʧ</returns>
+typedef ErrorCode (*SnapshotFrameSource)(void* pSource, SnapshotSink sink, void* pSink);
+
+/// <summary>
+/// 첽ձ
+/// ;ѵ֡ƵԤĻɱ߳дTIFF/PNG/֡.rvrɺص
+///
+/// ƣ
+/// - kSnapshotSlotsۣÿһֻ֡ȶٷڴ棩ȫռʱSC_BUSY
+/// - ֡Դ֣÷֡صеĵǰ֡ύʱƣ
+///   ĵȴɼ̵߳һ֡Offerɼ߳δʱɱ߳ͨ֡Դȡ֡
+/// - ɼ߳ÿֻ֡һm_waitingûеȴ֡Ŀʱ
+/// - ߳ڵһύʱShutdownʱдȡ֡Ŀպ˳
+/// </summary>
+class SnapshotEncoder
+{
+public:
+    SnapshotEncoder();
+    ~SnapshotEncoder();
+
+    SnapshotEncoder(const SnapshotEncoder&) = delete;
+    SnapshotEncoder& operator=(const SnapshotEncoder&) = delete;
+
+    /// <summary>֡Դ߳ڵȴɼ̳߳ʱɼ߳δʱʹã</summary>
+    void SetFrameSource(SnapshotFrameSource source, void* pSource);
+
+    /// <summary>ύһ</summary>
+    /// <param name="pImage">Ҫ֡ƣnullptrʾʹ֮󵽴һ֡</param>
+    /// <param name="waitForOffer">pImageΪnullptrʱǷȵȴɼ߳ṩ֡</param>
+    /// <returns>SC_OKʾύSC_BUSYʾв۶ʹãSC_NOT_SUPPORTʾʽظʽ֧</returns>
+    ErrorCode Submit(const ImageData* pImage, bool waitForOffer, const char* path, int format,
+        SnapshotCallBack callback, void* pUser);
+
+    /// <summary>Ƿеȴ֡Ŀգɼ߳ÿ֡ã</summary>
+    bool IsWaiting() const { return m_waiting.load() > 0; }
+
+    /// <summary>֡еȴ֡Ŀգɼ̵߳ã</summary>
+    void Offer(const ImageData& image);
+
+    /// <summary>пղֹ̣ͣ߳δȡ֡ĿSC_INVALID_RESOURCEص</summary>
+    void Shutdown();
+
+private:
+    enum SlotState
+    {
+        SlotState_Free = 0,
+        SlotState_Waiting,      // ȴ֡
+        SlotState_Filling,      // ڸ֡۵ĻɸƷռ
+        SlotState_Ready,        // ȡ֡ȴ
+    };
+
+    struct Slot
+    {
+        int state;                          // SlotStatem_lock
+        bool waitForOffer;
+        char path[512];
+        int format;                         // SnapshotFormat
+        SnapshotCallBack callback;
+        void* pUser;
+        unsigned char* buffer;              // е
+        size_t capacity;
+        ImageData image;                    // pDataָbufferstrideΪп
+        int fillResult;
+    };
+
+    struct SinkContext
+    {
+        SnapshotEncoder* encoder;
+        Slot* slot;
+    };
+
+    static void SinkProc(const ImageData& image, void* pSink);
+    ErrorCode CopyFrame(Slot& slot, const ImageData& image);
+    void WorkerProc();
+    ErrorCode AcquireFrame(Slot& slot);
+
+    Slot m_slots[kSnapshotSlots];
+    unsigned int m_queue[kSnapshotSlots];   // ĲۣΣύ˳
+    unsigned int m_queueHead;
+    unsigned int m_queueCount;
+
+    std::mutex m_lock;
+    std::condition_variable m_queueCond;    // дĲ/ֹͣ
+    std::condition_variable m_frameCond;    // ȴ֡Ĳȡ֡
+    std::vector<std::thread> m_workers;
+    bool m_stopping;
+
+    std::atomic<unsigned int> m_waiting;    // ȴ֡Ĳ
+    std::atomic<size_t> m_lastFrameBytes;   // һ֡ĴСԤ仺
+
+    SnapshotFrameSource m_source;
+    void* m_sourceUser;
+};